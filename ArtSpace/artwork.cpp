@@ -1,7 +1,10 @@
 #include "Artwork.h"
 #include <cstdlib>
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 
+uint32_t Artwork::sceneVersion = 0;
 
 // Constructor with position and dimensions
 Artwork::Artwork(float x, float y, float z, float width, float height, ArtworkPlacement placement) {
@@ -34,10 +37,11 @@ Artwork::Artwork(float x, float y, float z, float width, float height, ArtworkPl
     this->frameG = 0.5f;
     this->frameB = 0.3f;
 
-    this->artworkImage = new Image("#ffffff");  // White fallback color
+    this->artworkImage = new Image("", "#ffffff");  // White fallback color
     this->artworkImage->setPreserveAspectRatio(true);
     
     this->frameImage = nullptr;
+    markChanged();
 }
 
 // Constructor with image path
@@ -59,6 +63,7 @@ Artwork::Artwork(const std::string& imagePath, const std::string& framePath, flo
 
 // Destructor
 Artwork::~Artwork() {
+    markChanged();
     if (artworkImage) {
         delete artworkImage;
     }
@@ -119,12 +124,14 @@ void Artwork::render() {
 
 // Transformation functions
 void Artwork::translate(float dx, float dy, float dz) {
+    markChanged();
     posX += dx;
     posY += dy;
     posZ += dz;
 }
 
 void Artwork::rotate(float angle, float x, float y, float z) {
+    markChanged();
     rotAngle = angle;
     rotX = x;
     rotY = y;
@@ -132,6 +139,7 @@ void Artwork::rotate(float angle, float x, float y, float z) {
 }
 
 void Artwork::scale(float sx, float sy, float sz) {
+    markChanged();
     scaleX = sx;
     scaleY = sy;
     scaleZ = sz;
@@ -139,6 +147,7 @@ void Artwork::scale(float sx, float sy, float sz) {
 
 // New stretching functions
 void Artwork::stretchImage(float stretchX, float stretchY) {
+    markChanged();
     // Ensure stretch values don't go below a minimum threshold
     imageStretchX = (stretchX < 0.1f) ? 0.1f : stretchX;
     imageStretchY = (stretchY < 0.1f) ? 0.1f : stretchY;
@@ -151,6 +160,7 @@ void Artwork::stretchImage(float stretchX, float stretchY) {
 }
 
 void Artwork::stretchFrame(float stretchX, float stretchY) {
+    markChanged();
     // Ensure stretch values don't go below a minimum threshold
     frameStretchX = (stretchX < 0.1f) ? 0.1f : stretchX;
     frameStretchY = (stretchY < 0.1f) ? 0.1f : stretchY;
@@ -163,6 +173,7 @@ void Artwork::stretchFrame(float stretchX, float stretchY) {
 }
 
 void Artwork::resetImageStretch() {
+    markChanged();
     imageStretchX = 1.0f;
     imageStretchY = 1.0f;
     // Optionally restore aspect ratio preservation if that was the original setting
@@ -172,6 +183,7 @@ void Artwork::resetImageStretch() {
 }
 
 void Artwork::resetFrameStretch() {
+    markChanged();
     frameStretchX = 1.0f;
     frameStretchY = 1.0f;
     // Optionally restore aspect ratio preservation if that was the original setting
@@ -182,25 +194,29 @@ void Artwork::resetFrameStretch() {
 
 // Setters
 void Artwork::setPosition(float x, float y, float z) {
+    markChanged();
     posX = x;
     posY = y;
     posZ = z;
 }
 
 void Artwork::setDimensions(float width, float height) {
+    markChanged();
     this->width = width;
     this->height = height;
 }
 
 void Artwork::setPlacement(ArtworkPlacement placement) {
+    markChanged();
     this->placement = placement;
 }
 
 void Artwork::setImage(const std::string& imagePath) {
+    markChanged();
     // If artworkImage already exists, just load the new image
     if (artworkImage) {
         if (!artworkImage->loadImage(imagePath)) {
-            Logger::getInstance().logWarning("Artwork::setImage - Failed to load image: " + imagePath);
+            LOG_WARN("Artwork::setImage - Failed to load image: {}", imagePath);
         }
     }
     else {
@@ -208,15 +224,16 @@ void Artwork::setImage(const std::string& imagePath) {
         artworkImage = new Image(imagePath);
         artworkImage->setPreserveAspectRatio(true);
         if (!artworkImage->isImageLoaded()) {
-            Logger::getInstance().logWarning("Artwork::setImage - Failed to load image for new Image object: " + imagePath);
+            LOG_WARN("Artwork::setImage - Failed to load image for new Image object: {}", imagePath);
         }
     }
 }
 
 void Artwork::setFrame(const std::string& framePath) {
+    markChanged();
     if (frameImage) {
         if (!frameImage->loadImage(framePath)) {
-            Logger::getInstance().logWarning("Artwork::setFrame - Failed to load frame image: " + framePath);
+            LOG_WARN("Artwork::setFrame - Failed to load frame image: {}", framePath);
         }
     }
     else {
@@ -224,13 +241,37 @@ void Artwork::setFrame(const std::string& framePath) {
         frameImage = new Image(framePath);
         frameImage->setPreserveAspectRatio(true);
         if (!frameImage->isImageLoaded()) {
-            Logger::getInstance().logWarning("Artwork::setFrame - Failed to load frame image for new Image object: " + framePath);
+            LOG_WARN("Artwork::setFrame - Failed to load frame image for new Image object: {}", framePath);
         }
     }
     hasFrame = true; // Ensure hasFrame is true if a frame path is provided
 }
 
+void Artwork::setImageData(const sf::Image& image) {
+    markChanged();
+    if (!artworkImage) {
+        artworkImage = new Image("", "#ffffff");
+        artworkImage->setPreserveAspectRatio(true);
+    }
+    if (!artworkImage->setImageData(image)) {
+        LOG_WARN("Artwork::setImageData - Failed to upload image");
+    }
+}
+
+void Artwork::setFrameData(const sf::Image& image) {
+    markChanged();
+    if (!frameImage) {
+        frameImage = new Image("", "#ffffff");
+        frameImage->setPreserveAspectRatio(true);
+    }
+    if (!frameImage->setImageData(image)) {
+        LOG_WARN("Artwork::setFrameData - Failed to upload frame image");
+    }
+    hasFrame = true;
+}
+
 void Artwork::setFrame(bool hasFrame, float frameWidth, float r, float g, float b) {
+    markChanged();
     this->hasFrame = hasFrame;
     this->frameWidth = frameWidth;
     this->frameR = r;
@@ -245,12 +286,14 @@ void Artwork::setFrame(bool hasFrame, float frameWidth, float r, float g, float
 }
 
 void Artwork::setTint(float r, float g, float b, float a) {
+    markChanged();
     if (artworkImage) {
         artworkImage->setTint(r, g, b, a);
     }
 }
 
 void Artwork::setPreserveAspectRatio(bool preserve) {
+    markChanged();
     if (artworkImage) {
         artworkImage->setPreserveAspectRatio(preserve);
         
@@ -287,6 +330,66 @@ float* Artwork::getDimensions() const {
     return dim;
 }
 
+void Artwork::getWorldPosition(float out[3]) const {
+    placementToWorld(placement, posX, posY, posZ, out);
+}
+
+// Yaw applyPlacement() rotates an artwork by before the translation
+static float placementAngle(ArtworkPlacement placement) {
+    switch (placement) {
+    case EAST_WALL:  return 90.0f;
+    case SOUTH_WALL: return 180.0f;
+    case WEST_WALL:  return 270.0f;
+    default:         return 0.0f;
+    }
+}
+
+void Artwork::placementToWorld(ArtworkPlacement placement, float x, float y, float z, float out[3]) {
+    float radians = placementAngle(placement) * 3.14159265f / 180.0f;
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    out[0] = x * c + z * s;
+    out[1] = y;
+    out[2] = -x * s + z * c;
+}
+
+void Artwork::placementFacing(ArtworkPlacement placement, float out[2]) {
+    // The image faces local +Z
+    float radians = placementAngle(placement) * 3.14159265f / 180.0f;
+    out[0] = std::sin(radians);
+    out[1] = std::cos(radians);
+}
+
+void Artwork::getBoundingSphere(float center[3], float& radius) const {
+    getWorldPosition(center);
+
+    // Image quad spans [-width/2, -width/2 + width * stretch * pixels] (see render())
+    auto quadRadius = [this](const Image* image, float stretchX, float stretchY, float z) {
+        const float* pixels = image->getSize();
+        float x0 = -width / 2, x1 = -width / 2 + width * stretchX * pixels[0];
+        float y0 = -height / 2, y1 = -height / 2 + height * stretchY * pixels[1];
+        float maxX = std::max(std::fabs(x0), std::fabs(x1));
+        float maxY = std::max(std::fabs(y0), std::fabs(y1));
+        return std::sqrt(maxX * maxX + maxY * maxY + z * z);
+    };
+
+    radius = artworkImage ? quadRadius(artworkImage, imageStretchX, imageStretchY, 0.0f) : 0.0f;
+    if (hasFrame) {
+        if (frameImage) {
+            radius = std::max(radius, quadRadius(frameImage, frameStretchX, frameStretchY, 0.02f));
+        }
+        else {
+            float outerW = (width / 2 + frameWidth) * frameStretchX;
+            float outerH = (height / 2 + frameWidth) * frameStretchY;
+            radius = std::max(radius, std::sqrt(outerW * outerW + outerH * outerH));
+        }
+    }
+
+    // Global scale applies on top of everything
+    float maxScale = std::max(std::fabs(scaleX), std::max(std::fabs(scaleY), std::fabs(scaleZ)));
+    radius *= maxScale;
+}
+
 ArtworkPlacement Artwork::getPlacement() const {
     return placement;
 }
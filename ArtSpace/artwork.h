@@ -4,6 +4,7 @@
 #include <GL/glut.h>
 #include <string>
 #include "utility.h" // Include your custom Image class
+#include "slot_map.h"
 
 enum ArtworkPlacement {
     NORTH_WALL,
@@ -48,6 +49,9 @@ public:
     void setPlacement(ArtworkPlacement placement);
     void setImage(const std::string& imagePath);
     void setFrame(const std::string& framePath);
+    // Use images decoded elsewhere (uploads them, so call with the GL context current)
+    void setImageData(const sf::Image& image);
+    void setFrameData(const sf::Image& image);
     void setFrame(bool hasFrame, float frameWidth = 0.1f,
         float r = 0.7f, float g = 0.5f, float b = 0.3f);
     void setTint(float r, float g, float b, float a = 1.0f);
@@ -58,6 +62,22 @@ public:
     float* getDimensions() const;
     ArtworkPlacement getPlacement() const;
     bool isImageLoaded() const;
+    float getRotationAngle() const { return rotAngle; }
+    
+    // World-space position after wall placement, and a bounding sphere around
+    // the image and frame that holds for any in-plane rotation
+    void getWorldPosition(float out[3]) const;
+    void getBoundingSphere(float center[3], float& radius) const;
+    static void placementToWorld(ArtworkPlacement placement, float x, float y, float z, float out[3]);
+    // XZ direction the front of an artwork with this placement faces
+    static void placementFacing(ArtworkPlacement placement, float out[2]);
+    
+    // Changes whenever an artwork is created, destroyed, moved or restyled (render caching)
+    static uint32_t getSceneVersion() { return sceneVersion; }
+    
+    // Handle assigned by the ArtworkManager that owns this artwork
+    SlotHandle getHandle() const { return handle; }
+    void setHandle(SlotHandle newHandle) { handle = newHandle; }
     
     // New getters for stretch values
     float getImageStretchX() const { return imageStretchX; }
@@ -83,6 +103,13 @@ private:
 
     ArtworkPlacement placement;
 
+    // Owning manager's handle (invalid until registered)
+    SlotHandle handle;
+
+    // Bumped by every change that affects how any artwork looks
+    static uint32_t sceneVersion;
+    static void markChanged() { sceneVersion++; }
+
     // Image objects
     Image* artworkImage;    // The actual artwork
     Image* frameImage;      // The frame image
@@ -24,10 +24,19 @@ ArtworkManager* ArtworkManager::getInstance() {
     return instance;
 }
 
+// Register an artwork in the slot map and store its handle on it
+ArtworkHandle ArtworkManager::addArtwork(Artwork* artwork, const ArtworkInfo& info) {
+    ArtworkHandle handle = artworks.insert(ArtworkEntry{ artwork, info });
+    artwork->setHandle(handle);
+    return handle;
+}
+
 // Create an artwork with an image
 Artwork* ArtworkManager::createArtwork(const std::string& imagePath, float x, float y, float z) {
     Artwork* newArtwork = new Artwork(imagePath, x, y, z, 0.003f, 0.003f, NORTH_WALL);
-    artworks.push_back(newArtwork);
+    ArtworkInfo info;
+    info.imagePath = imagePath;
+    addArtwork(newArtwork, info);
     return newArtwork;
 }
 
@@ -37,7 +46,10 @@ Artwork* ArtworkManager::createArtwork(const std::string& imagePath, const std::
                                       float width, float height, 
                                       ArtworkPlacement placement) {
     Artwork* newArtwork = new Artwork(imagePath, framePath, x, y, z, width, height, placement);
-    artworks.push_back(newArtwork);
+    ArtworkInfo info;
+    info.imagePath = imagePath;
+    info.framePath = framePath;
+    addArtwork(newArtwork, info);
     return newArtwork;
 }
 
@@ -50,45 +62,96 @@ Artwork* ArtworkManager::createArtworkFromConfig(const std::string& imagePath, c
                                       config.placement);
     
     // Apply additional configurations
+    applyConfig(newArtwork, config);
+    
+    ArtworkInfo info;
+    info.name = config.name;
+    info.artist = config.artist;
+    info.year = config.year;
+    info.tags = config.tags;
+    info.imagePath = imagePath;
+    info.framePath = framePath;
+    addArtwork(newArtwork, info);
+    return newArtwork;
+}
+
+// Create artwork from pre-decoded images
+ArtworkHandle ArtworkManager::createArtworkFromImages(const sf::Image* image, const sf::Image* frame,
+                                                      const ArtworkConfig& config,
+                                                      const std::string& imagePath, const std::string& framePath) {
+    Artwork* newArtwork = new Artwork(config.posX, config.posY, config.posZ,
+                                      config.width, config.height,
+                                      config.placement);
+    if (image) {
+        newArtwork->setImageData(*image);
+    }
+    if (frame) {
+        newArtwork->setFrameData(*frame);
+    }
+    applyConfig(newArtwork, config);
+    
+    ArtworkInfo info;
+    info.name = config.name;
+    info.artist = config.artist;
+    info.year = config.year;
+    info.tags = config.tags;
+    info.imagePath = imagePath;
+    info.framePath = framePath;
+    return addArtwork(newArtwork, info);
+}
+
+// Apply rotation and stretching from a config
+void ArtworkManager::applyConfig(Artwork* artwork, const ArtworkConfig& config) {
     if (config.hasRotation) {
-        newArtwork->rotate(config.rotAngle, config.rotX, config.rotY, config.rotZ);
+        artwork->rotate(config.rotAngle, config.rotX, config.rotY, config.rotZ);
     }
     
     if (config.hasImageStretch) {
-        newArtwork->stretchImage(config.imageStretchX, config.imageStretchY);
+        artwork->stretchImage(config.imageStretchX, config.imageStretchY);
     }
     
     if (config.hasFrameStretch) {
-        newArtwork->stretchFrame(config.frameStretchX, config.frameStretchY);
+        artwork->stretchFrame(config.frameStretchX, config.frameStretchY);
     }
-    
-    artworks.push_back(newArtwork);
-    return newArtwork;
 }
 
-// Remove a specific artwork
-void ArtworkManager::removeArtwork(Artwork* artwork) {
-    for (auto it = artworks.begin(); it != artworks.end(); ++it) {
-        if (*it == artwork) {
-            delete *it;
-            artworks.erase(it);
-            break;
-        }
+// Remove a specific artwork (O(1) swap-remove, other handles stay valid)
+bool ArtworkManager::removeArtwork(ArtworkHandle handle) {
+    ArtworkEntry* entry = artworks.get(handle);
+    if (!entry) {
+        return false;
+    }
+
+    delete entry->artwork;
+    artworks.remove(handle);
+    return true;
+}
+
+// Remove a specific artwork by pointer using the handle it carries
+bool ArtworkManager::removeArtwork(Artwork* artwork) {
+    if (!artwork) {
+        return false;
     }
+
+    ArtworkEntry* entry = artworks.get(artwork->getHandle());
+    if (!entry || entry->artwork != artwork) {
+        return false;
+    }
+    return removeArtwork(artwork->getHandle());
 }
 
 // Clear all artworks
 void ArtworkManager::clear() {
-    for (auto artwork : artworks) {
-        delete artwork;
+    for (auto& entry : artworks) {
+        delete entry.artwork;
     }
     artworks.clear();
 }
 
 // Render all artworks
 void ArtworkManager::renderAll() {
-    for (auto artwork : artworks) {
-        artwork->render();
+    for (auto& entry : artworks) {
+        entry.artwork->render();
     }
 }
 
@@ -102,8 +165,8 @@ Artwork* ArtworkManager::findNearestArtwork(const float* position, float maxDist
     Artwork* nearest = nullptr;
     float minDistance = maxDistance;
     
-    for (auto artwork : artworks) {
-        float* artPos = artwork->getPosition();
+    for (auto& entry : artworks) {
+        float* artPos = entry.artwork->getPosition();
         float distance = std::sqrt(
             std::pow(position[0] - artPos[0], 2) + 
             std::pow(position[1] - artPos[1], 2) + 
@@ -112,21 +175,59 @@ Artwork* ArtworkManager::findNearestArtwork(const float* position, float maxDist
         
         if (distance < minDistance) {
             minDistance = distance;
-            nearest = artwork;
+            nearest = entry.artwork;
         }
     }
     
     return nearest;
 }
 
-// Get artwork by ID
-Artwork* ArtworkManager::getArtwork(int id) {
-    if (id >= 0 && id < artworks.size()) {
-        return artworks[id];
+// Find nearest artwork and return its handle
+ArtworkHandle ArtworkManager::findNearestArtworkHandle(const float* position, float maxDistance) {
+    Artwork* nearest = findNearestArtwork(position, maxDistance);
+    return nearest ? nearest->getHandle() : ArtworkHandle();
+}
+
+// Get artwork by handle
+Artwork* ArtworkManager::getArtwork(ArtworkHandle handle) {
+    ArtworkEntry* entry = artworks.get(handle);
+    return entry ? entry->artwork : nullptr;
+}
+
+// Get artwork metadata by handle
+ArtworkInfo* ArtworkManager::getArtworkInfo(ArtworkHandle handle) {
+    ArtworkEntry* entry = artworks.get(handle);
+    return entry ? &entry->info : nullptr;
+}
+
+// Get artwork name by handle
+const std::string& ArtworkManager::getArtworkName(ArtworkHandle handle) {
+    static const std::string unknownName = "Unknown";
+    ArtworkEntry* entry = artworks.get(handle);
+    return entry ? entry->info.name : unknownName;
+}
+
+// Check whether a handle still refers to a live artwork
+bool ArtworkManager::isValid(ArtworkHandle handle) const {
+    return artworks.contains(handle);
+}
+
+// Get artwork by dense index
+Artwork* ArtworkManager::getArtwork(int index) {
+    if (index >= 0 && index < static_cast<int>(artworks.size())) {
+        return artworks.valueAt(index).artwork;
     }
     return nullptr;
 }
 
+// Get the handle of the artwork at a dense index
+ArtworkHandle ArtworkManager::getHandle(int index) const {
+    if (index >= 0 && index < static_cast<int>(artworks.size())) {
+        return artworks.handleAt(index);
+    }
+    return ArtworkHandle();
+}
+
 // Get total number of artworks
 size_t ArtworkManager::getArtworkCount() const {
     return artworks.size();
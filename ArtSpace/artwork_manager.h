@@ -2,9 +2,21 @@
 #include <vector>
 #include <string>
 #include "artwork.h"
+#include "slot_map.h"
+
+// Stable reference to an artwork owned by the ArtworkManager
+typedef SlotHandle ArtworkHandle;
 
 // Configuration structure for artwork placement and properties
 struct ArtworkConfig {
+    // Display name
+    std::string name = "Unknown";
+    
+    // Search metadata
+    std::string artist;
+    int year = 0;
+    std::vector<std::string> tags;
+    
     // Position
     float posX = 0.0f, posY = 0.0f, posZ = 0.0f;
     
@@ -28,10 +40,31 @@ struct ArtworkConfig {
     float frameStretchX = 1.0f, frameStretchY = 1.0f;
 };
 
+// Per-artwork metadata, kept alongside the artwork and keyed by its handle
+struct ArtworkInfo {
+    std::string name = "Unknown";
+    std::string artist;
+    int year = 0;
+    std::vector<std::string> tags;
+    std::string imagePath;
+    std::string framePath;
+};
+
 class ArtworkManager {
 private:
+    struct ArtworkEntry {
+        Artwork* artwork;
+        ArtworkInfo info;
+    };
+
     static ArtworkManager* instance;
-    std::vector<Artwork*> artworks;
+    SlotMap<ArtworkEntry> artworks;
+    
+    // Register a newly created artwork and give it its handle
+    ArtworkHandle addArtwork(Artwork* artwork, const ArtworkInfo& info);
+    
+    // Apply the rotation and stretch parts of a config
+    void applyConfig(Artwork* artwork, const ArtworkConfig& config);
     
     ArtworkManager();  // Private constructor for singleton
 
@@ -47,11 +80,23 @@ public:
                           ArtworkPlacement placement = NORTH_WALL);
     Artwork* createArtworkFromConfig(const std::string& imagePath, const std::string& framePath, 
                                     const ArtworkConfig& config);
-    void removeArtwork(Artwork* artwork);
+    // Create from images decoded elsewhere (frame may be null); paths are kept as metadata
+    ArtworkHandle createArtworkFromImages(const sf::Image* image, const sf::Image* frame,
+                                          const ArtworkConfig& config,
+                                          const std::string& imagePath, const std::string& framePath);
+    bool removeArtwork(ArtworkHandle handle);
+    bool removeArtwork(Artwork* artwork);
     void clear();
 
-    // Artwork access
-    Artwork* getArtwork(int id);
+    // Artwork access by handle (O(1), nullptr if the handle is stale)
+    Artwork* getArtwork(ArtworkHandle handle);
+    ArtworkInfo* getArtworkInfo(ArtworkHandle handle);
+    const std::string& getArtworkName(ArtworkHandle handle);
+    bool isValid(ArtworkHandle handle) const;
+
+    // Dense access for iteration (indices change on removal, handles don't)
+    Artwork* getArtwork(int index);
+    ArtworkHandle getHandle(int index) const;
     size_t getArtworkCount() const;
 
     // Rendering and updates
@@ -60,6 +105,7 @@ public:
 
     // Interaction
     Artwork* findNearestArtwork(const float* position, float maxDistance);
+    ArtworkHandle findNearestArtworkHandle(const float* position, float maxDistance);
     
     // TODO: Add artwork loading from configuration
     // TODO: Add artwork placement validation
@@ -0,0 +1,338 @@
+#include "artwork_search.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+// Match quality weights
+static const float EXACT_WEIGHT = 3.0f;
+static const float PREFIX_WEIGHT = 2.0f;
+static const float FUZZY_WEIGHT = 1.0f;
+
+// Minimum share of trigrams a term must have in common with a query word
+static const float FUZZY_MIN_SIMILARITY = 0.5f;
+
+// Longest query considered (in words)
+static const size_t MAX_QUERY_TOKENS = 8;
+
+// Shorter words only match exactly; as prefixes they would expand to a large
+// share of the dictionary and every posting behind it on each keystroke
+static const size_t MIN_PREFIX_LENGTH = 2;
+
+static float fieldWeight(uint8_t fields) {
+    if (fields & ArtworkSearchIndex::FIELD_TITLE) return 3.0f;
+    if (fields & ArtworkSearchIndex::FIELD_ARTIST) return 2.0f;
+    if (fields & ArtworkSearchIndex::FIELD_TAG) return 1.5f;
+    return 1.0f;
+}
+
+static uint32_t packTrigram(const char* text) {
+    return (static_cast<uint32_t>(static_cast<unsigned char>(text[0])) << 16) |
+        (static_cast<uint32_t>(static_cast<unsigned char>(text[1])) << 8) |
+        static_cast<uint32_t>(static_cast<unsigned char>(text[2]));
+}
+
+// StringPool implementation
+uint32_t StringPool::add(const std::string& value) {
+    uint32_t offset = static_cast<uint32_t>(data.size());
+    data.insert(data.end(), value.begin(), value.end());
+    data.push_back('\0');
+    return offset;
+}
+
+// ArtworkSearchIndex implementation
+ArtworkSearchIndex::ArtworkSearchIndex() : built(false) {
+}
+
+void ArtworkSearchIndex::tokenize(const std::string& text, std::vector<std::string>& tokens) {
+    tokens.clear();
+    std::string current;
+    for (char c : text) {
+        unsigned char uc = static_cast<unsigned char>(c);
+        if (std::isalnum(uc)) {
+            current.push_back(static_cast<char>(std::tolower(uc)));
+        }
+        else if (!current.empty()) {
+            tokens.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(current);
+    }
+}
+
+ArtworkSearchIndex::DocId ArtworkSearchIndex::addDocument(const Metadata& metadata, const float position[3],
+    const float facing[2], uint64_t key) {
+    DocId doc = static_cast<DocId>(documents.size());
+
+    std::string joinedTags;
+    for (size_t i = 0; i < metadata.tags.size(); i++) {
+        if (i > 0) joinedTags += ", ";
+        joinedTags += metadata.tags[i];
+    }
+
+    Document document;
+    document.titleOffset = strings.add(metadata.title);
+    document.artistOffset = strings.add(metadata.artist);
+    document.tagsOffset = strings.add(joinedTags);
+    document.year = metadata.year;
+    document.position[0] = position[0];
+    document.position[1] = position[1];
+    document.position[2] = position[2];
+    document.facing[0] = facing[0];
+    document.facing[1] = facing[1];
+    document.key = key;
+    documents.push_back(document);
+
+    addField(metadata.title, doc, FIELD_TITLE);
+    addField(metadata.artist, doc, FIELD_ARTIST);
+    for (const std::string& tag : metadata.tags) {
+        addField(tag, doc, FIELD_TAG);
+    }
+    if (metadata.year != 0) {
+        addField(std::to_string(metadata.year), doc, FIELD_YEAR);
+    }
+
+    built = false;
+    return doc;
+}
+
+void ArtworkSearchIndex::addField(const std::string& text, DocId doc, Field field) {
+    std::vector<std::string> tokens;
+    tokenize(text, tokens);
+    for (const std::string& token : tokens) {
+        auto found = pendingTermIds.find(token);
+        uint32_t term;
+        if (found == pendingTermIds.end()) {
+            term = static_cast<uint32_t>(pendingTerms.size());
+            pendingTermIds.emplace(token, term);
+            pendingTerms.push_back(token);
+        }
+        else {
+            term = found->second;
+        }
+        occurrences.push_back(Occurrence{ term, doc, static_cast<uint8_t>(field) });
+    }
+}
+
+void ArtworkSearchIndex::build() {
+    // Sort the dictionary alphabetically so prefixes form contiguous ranges
+    std::vector<uint32_t> order(pendingTerms.size());
+    for (uint32_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(),
+        [this](uint32_t a, uint32_t b) { return pendingTerms[a] < pendingTerms[b]; });
+
+    std::vector<uint32_t> remap(pendingTerms.size());
+    termStrings.clear();
+    termOffsets.clear();
+    termLengths.clear();
+    termOffsets.reserve(order.size());
+    termLengths.reserve(order.size());
+    for (uint32_t i = 0; i < order.size(); i++) {
+        remap[order[i]] = i;
+        termOffsets.push_back(termStrings.add(pendingTerms[order[i]]));
+        termLengths.push_back(static_cast<uint16_t>(std::min<size_t>(pendingTerms[order[i]].size(), 0xFFFF)));
+    }
+    termStrings.shrink();
+
+    // Postings grouped by term, one entry per (term, doc) with merged field bits
+    std::vector<Occurrence> sorted(occurrences);
+    for (Occurrence& occurrence : sorted) {
+        occurrence.term = remap[occurrence.term];
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Occurrence& a, const Occurrence& b) {
+        return a.term != b.term ? a.term < b.term : a.doc < b.doc;
+    });
+
+    postings.clear();
+    postingStart.assign(termOffsets.size() + 1, 0);
+    for (size_t i = 0; i < sorted.size(); i++) {
+        const Occurrence& occurrence = sorted[i];
+        if (i > 0 && sorted[i - 1].term == occurrence.term && sorted[i - 1].doc == occurrence.doc) {
+            postings.back().fields |= occurrence.field;
+            continue;
+        }
+        postings.push_back(Posting{ occurrence.doc, occurrence.field });
+        postingStart[occurrence.term + 1]++;
+    }
+    for (size_t t = 0; t < termOffsets.size(); t++) {
+        postingStart[t + 1] += postingStart[t];
+    }
+    postings.shrink_to_fit();
+
+    // Trigram -> term lists
+    std::vector<std::pair<uint32_t, uint32_t>> pairs;
+    for (uint32_t t = 0; t < termOffsets.size(); t++) {
+        const char* term = termAt(t);
+        for (int i = 0; i + 3 <= termLengths[t]; i++) {
+            pairs.push_back(std::make_pair(packTrigram(term + i), t));
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    trigramKeys.clear();
+    trigramStart.clear();
+    trigramTerms.clear();
+    trigramTerms.reserve(pairs.size());
+    for (size_t i = 0; i < pairs.size(); i++) {
+        if (trigramKeys.empty() || trigramKeys.back() != pairs[i].first) {
+            trigramKeys.push_back(pairs[i].first);
+            trigramStart.push_back(static_cast<uint32_t>(trigramTerms.size()));
+        }
+        trigramTerms.push_back(pairs[i].second);
+    }
+    trigramStart.push_back(static_cast<uint32_t>(trigramTerms.size()));
+
+    // Scratch space for queries
+    docTokenScore.assign(documents.size(), 0.0f);
+    docScore.assign(documents.size(), 0.0f);
+    docHits.assign(documents.size(), 0);
+    termTrigramHits.assign(termOffsets.size(), 0);
+
+    built = true;
+}
+
+void ArtworkSearchIndex::clear() {
+    strings.clear();
+    documents.clear();
+    pendingTermIds.clear();
+    pendingTerms.clear();
+    occurrences.clear();
+    termStrings.clear();
+    termOffsets.clear();
+    termLengths.clear();
+    postingStart.clear();
+    postings.clear();
+    trigramKeys.clear();
+    trigramStart.clear();
+    trigramTerms.clear();
+    built = false;
+}
+
+void ArtworkSearchIndex::scoreTerm(uint32_t term, float matchWeight) const {
+    for (uint32_t p = postingStart[term]; p < postingStart[term + 1]; p++) {
+        const Posting& posting = postings[p];
+        float score = matchWeight * fieldWeight(posting.fields);
+        float& current = docTokenScore[posting.doc];
+        if (current == 0.0f) {
+            tokenDocs.push_back(posting.doc);
+        }
+        if (score > current) {
+            current = score;
+        }
+    }
+}
+
+void ArtworkSearchIndex::search(const std::string& query, size_t maxResults, std::vector<Result>& out) const {
+    out.clear();
+    if (!built || maxResults == 0) return;
+
+    std::vector<std::string> tokens;
+    tokenize(query, tokens);
+    if (tokens.size() > MAX_QUERY_TOKENS) {
+        tokens.resize(MAX_QUERY_TOKENS);
+    }
+    if (tokens.empty()) return;
+
+    touchedDocs.clear();
+    for (size_t t = 0; t < tokens.size(); t++) {
+        const std::string& token = tokens[t];
+        tokenDocs.clear();
+
+        // Exact and prefix matches: one contiguous range of the sorted dictionary
+        uint32_t first = static_cast<uint32_t>(std::lower_bound(termOffsets.begin(), termOffsets.end(), token,
+            [this](uint32_t offset, const std::string& value) {
+                return strcmp(termStrings.get(offset), value.c_str()) < 0;
+            }) - termOffsets.begin());
+
+        uint32_t prefixTerms = 0;
+        bool expandPrefix = token.size() >= MIN_PREFIX_LENGTH;
+        for (uint32_t term = first; term < termOffsets.size(); term++) {
+            if (strncmp(termAt(term), token.c_str(), token.size()) != 0) break;
+            if (!expandPrefix && termLengths[term] != token.size()) break;
+
+            // Shorter completions rank closer to an exact match
+            float weight = termLengths[term] == token.size() ? EXACT_WEIGHT :
+                PREFIX_WEIGHT * (0.5f + 0.5f * token.size() / termLengths[term]);
+            scoreTerm(term, weight);
+            prefixTerms++;
+        }
+
+        // Nothing starts with the word: fall back to trigram similarity
+        if (prefixTerms == 0 && token.size() >= 3) {
+            std::vector<uint32_t> queryTrigrams;
+            for (size_t i = 0; i + 3 <= token.size(); i++) {
+                queryTrigrams.push_back(packTrigram(token.c_str() + i));
+            }
+            std::sort(queryTrigrams.begin(), queryTrigrams.end());
+            queryTrigrams.erase(std::unique(queryTrigrams.begin(), queryTrigrams.end()), queryTrigrams.end());
+
+            touchedTerms.clear();
+            for (uint32_t trigram : queryTrigrams) {
+                auto found = std::lower_bound(trigramKeys.begin(), trigramKeys.end(), trigram);
+                if (found == trigramKeys.end() || *found != trigram) continue;
+
+                size_t key = found - trigramKeys.begin();
+                for (uint32_t i = trigramStart[key]; i < trigramStart[key + 1]; i++) {
+                    uint32_t term = trigramTerms[i];
+                    if (termTrigramHits[term]++ == 0) {
+                        touchedTerms.push_back(term);
+                    }
+                }
+            }
+
+            for (uint32_t term : touchedTerms) {
+                float termTrigrams = static_cast<float>(std::max(1, termLengths[term] - 2));
+                float similarity = termTrigramHits[term] / std::max(termTrigrams, static_cast<float>(queryTrigrams.size()));
+                if (similarity >= FUZZY_MIN_SIMILARITY) {
+                    scoreTerm(term, FUZZY_WEIGHT * similarity);
+                }
+                termTrigramHits[term] = 0;
+            }
+        }
+
+        // Keep only documents that matched every word so far
+        for (DocId doc : tokenDocs) {
+            if (docHits[doc] == t) {
+                if (t == 0) touchedDocs.push_back(doc);
+                docScore[doc] += docTokenScore[doc];
+                docHits[doc] = static_cast<uint16_t>(t + 1);
+            }
+            docTokenScore[doc] = 0.0f;
+        }
+    }
+
+    // Collect the documents that matched all words and reset the scratch space
+    for (DocId doc : touchedDocs) {
+        if (docHits[doc] == tokens.size()) {
+            out.push_back(Result{ doc, docScore[doc] });
+        }
+        docHits[doc] = 0;
+        docScore[doc] = 0.0f;
+    }
+
+    auto better = [](const Result& a, const Result& b) {
+        return a.score != b.score ? a.score > b.score : a.doc < b.doc;
+    };
+    if (out.size() > maxResults) {
+        std::partial_sort(out.begin(), out.begin() + maxResults, out.end(), better);
+        out.resize(maxResults);
+    }
+    else {
+        std::sort(out.begin(), out.end(), better);
+    }
+}
+
+size_t ArtworkSearchIndex::memoryUsage() const {
+    return strings.memoryUsage() +
+        documents.capacity() * sizeof(Document) +
+        termStrings.memoryUsage() +
+        termOffsets.capacity() * sizeof(uint32_t) +
+        termLengths.capacity() * sizeof(uint16_t) +
+        postingStart.capacity() * sizeof(uint32_t) +
+        postings.capacity() * sizeof(Posting) +
+        trigramKeys.capacity() * sizeof(uint32_t) +
+        trigramStart.capacity() * sizeof(uint32_t) +
+        trigramTerms.capacity() * sizeof(uint32_t);
+}
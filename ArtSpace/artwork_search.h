@@ -0,0 +1,155 @@
+/**
+ * @file artwork_search.h
+ * @brief Inverted-index search over artwork metadata (title, artist, year, tags)
+ *
+ * ArtworkSearchIndex keeps every document's metadata in one compact string
+ * pool and builds an inverted index from the lower-cased words of each field:
+ * - a sorted term dictionary, so a query word matches exact terms and every
+ *   term it is a prefix of with one binary search (one-letter words only
+ *   match exactly: as prefixes they would pull in most of the index);
+ * - a trigram index over the terms, so misspelt or partial words still find
+ *   candidates ("starscrem" -> "starscream").
+ *
+ * Every query word must match (AND). Documents are ranked by field (title
+ * over artist over tags over year) and match quality (exact over prefix over
+ * trigram). The index has no OpenGL dependency so it can be benchmarked on
+ * its own (see tests/bench_search.cpp).
+ *
+ * Usage:
+ *    ArtworkSearchIndex index;
+ *    ArtworkSearchIndex::Metadata meta;
+ *    meta.title = "Starscream";
+ *    meta.tags = { "transformers", "seeker" };
+ *    index.addDocument(meta, worldPosition, facing, key);
+ *    index.build();
+ *
+ *    std::vector<ArtworkSearchIndex::Result> results;
+ *    index.search("star", 10, results);
+ *    index.getTitle(results[0].doc);
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+// Append-only pool of null-terminated strings addressed by offset
+class StringPool {
+private:
+    std::vector<char> data;
+
+public:
+    uint32_t add(const std::string& value);
+    const char* get(uint32_t offset) const { return data.data() + offset; }
+    size_t memoryUsage() const { return data.capacity(); }
+    void clear() { data.clear(); }
+    void shrink() { data.shrink_to_fit(); }
+};
+
+class ArtworkSearchIndex {
+public:
+    typedef uint32_t DocId;
+
+    // Input metadata for one artwork
+    struct Metadata {
+        std::string title;
+        std::string artist;
+        int year = 0;                  // 0 when unknown
+        std::vector<std::string> tags;
+    };
+
+    struct Result {
+        DocId doc;
+        float score;
+    };
+
+    // Fields a term can come from
+    enum Field {
+        FIELD_TITLE = 1,
+        FIELD_ARTIST = 2,
+        FIELD_TAG = 4,
+        FIELD_YEAR = 8
+    };
+
+private:
+    // Compact per-document record; strings live in the pool
+    struct Document {
+        uint32_t titleOffset;
+        uint32_t artistOffset;
+        uint32_t tagsOffset;    // Tags joined with ", "
+        int32_t year;
+        float position[3];      // World position of the artwork
+        float facing[2];        // XZ direction the artwork faces
+        uint64_t key;           // Caller's identifier (handle key, catalog id...)
+    };
+
+    struct Posting {
+        DocId doc;
+        uint8_t fields;         // Field bits the term occurs in
+    };
+
+    StringPool strings;
+    std::vector<Document> documents;
+
+    // Build input: (term, doc, field) occurrences
+    std::unordered_map<std::string, uint32_t> pendingTermIds;
+    std::vector<std::string> pendingTerms;
+    struct Occurrence { uint32_t term; DocId doc; uint8_t field; };
+    std::vector<Occurrence> occurrences;
+
+    // Built index: terms sorted alphabetically, postings in CSR form
+    StringPool termStrings;
+    std::vector<uint32_t> termOffsets;     // Into termStrings, sorted by term
+    std::vector<uint16_t> termLengths;
+    std::vector<uint32_t> postingStart;    // termOffsets.size() + 1 entries
+    std::vector<Posting> postings;
+
+    // Trigram -> terms containing it (CSR)
+    std::vector<uint32_t> trigramKeys;     // Sorted packed trigrams
+    std::vector<uint32_t> trigramStart;
+    std::vector<uint32_t> trigramTerms;
+
+    bool built;
+
+    // Per-query scratch space, reused between searches
+    mutable std::vector<float> docTokenScore;
+    mutable std::vector<float> docScore;
+    mutable std::vector<uint16_t> docHits;
+    mutable std::vector<DocId> touchedDocs;
+    mutable std::vector<DocId> tokenDocs;
+    mutable std::vector<uint16_t> termTrigramHits;
+    mutable std::vector<uint32_t> touchedTerms;
+
+    void addField(const std::string& text, DocId doc, Field field);
+    const char* termAt(uint32_t index) const { return termStrings.get(termOffsets[index]); }
+    void scoreTerm(uint32_t term, float matchWeight) const;
+
+public:
+    ArtworkSearchIndex();
+
+    // Add a document; call build() once all documents are in
+    DocId addDocument(const Metadata& metadata, const float position[3], const float facing[2], uint64_t key = 0);
+    void build();
+    void clear();
+
+    // Ranked search; out is cleared and receives at most maxResults entries
+    void search(const std::string& query, size_t maxResults, std::vector<Result>& out) const;
+
+    // Document access
+    size_t size() const { return documents.size(); }
+    bool isBuilt() const { return built; }
+    const char* getTitle(DocId doc) const { return strings.get(documents[doc].titleOffset); }
+    const char* getArtist(DocId doc) const { return strings.get(documents[doc].artistOffset); }
+    const char* getTags(DocId doc) const { return strings.get(documents[doc].tagsOffset); }
+    int getYear(DocId doc) const { return documents[doc].year; }
+    const float* getPosition(DocId doc) const { return documents[doc].position; }
+    const float* getFacing(DocId doc) const { return documents[doc].facing; }
+    uint64_t getKey(DocId doc) const { return documents[doc].key; }
+
+    // Approximate heap usage of the built index in bytes
+    size_t memoryUsage() const;
+
+    // Split text into lower-case alphanumeric words
+    static void tokenize(const std::string& text, std::vector<std::string>& tokens);
+};
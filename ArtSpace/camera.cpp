@@ -21,6 +21,10 @@ Camera::Camera() {
     
     // Set default sensitivity - reduced from 0.2f
     mouseSensitivity = 30.3f;
+    
+    version = 0;
+    
+    savePreviousState();
 }
 
 void Camera::update(float deltaTime) {
@@ -40,6 +44,7 @@ void Camera::update(float deltaTime) {
         
         // Ensure angles stay within bounds
         clampAngles();
+        version++;
     }
     
     // Calculate direction vectors based on camera yaw
@@ -57,22 +62,25 @@ void Camera::update(float deltaTime) {
     float moveSpeed = 0.1f;
     
     // Handle WASD movement
-    if (input->isKeyPressed('w') || input->isKeyPressed('W')) {
+    if (input->isMovementKeyPressed()) {
+        version++;
+    }
+    if (input->isActionPressed(InputAction::MoveForward)) {
         // Move forward
         position[0] += forwardX * moveSpeed;
         position[2] += forwardZ * moveSpeed;
     }
-    if (input->isKeyPressed('s') || input->isKeyPressed('S')) {
+    if (input->isActionPressed(InputAction::MoveBackward)) {
         // Move backward
         position[0] -= forwardX * moveSpeed;
         position[2] -= forwardZ * moveSpeed;
     }
-    if (input->isKeyPressed('a') || input->isKeyPressed('A')) {
+    if (input->isActionPressed(InputAction::MoveLeft)) {
         // Move left
         position[0] -= rightX * moveSpeed;
         position[2] -= rightZ * moveSpeed;
     }
-    if (input->isKeyPressed('d') || input->isKeyPressed('D')) {
+    if (input->isActionPressed(InputAction::MoveRight)) {
         // Move right
         position[0] += rightX * moveSpeed;
         position[2] += rightZ * moveSpeed;
@@ -91,6 +99,56 @@ void Camera::applyTransformation() {
     glTranslatef(-position[0], -position[1], -position[2]);
 }
 
+void Camera::applyTransformation(float alpha) {
+    // Yaw wraps at 360 degrees; interpolate along the short way round
+    float yawDelta = rotation[1] - previousRotation[1];
+    if (yawDelta > 180.0f) yawDelta -= 360.0f;
+    if (yawDelta < -180.0f) yawDelta += 360.0f;
+    
+    float pitch = previousRotation[0] + (rotation[0] - previousRotation[0]) * alpha;
+    float yaw = previousRotation[1] + yawDelta * alpha;
+    
+    float pos[3];
+    getInterpolatedPosition(alpha, pos);
+    
+    glLoadIdentity();
+    glRotatef(pitch, 1.0f, 0.0f, 0.0f);
+    glRotatef(yaw, 0.0f, 1.0f, 0.0f);
+    glTranslatef(-pos[0], -pos[1], -pos[2]);
+}
+
+void Camera::savePreviousState() {
+    for (int i = 0; i < 3; i++) {
+        previousPosition[i] = position[i];
+        previousRotation[i] = rotation[i];
+    }
+}
+
+void Camera::addLook(float yawDelta, float pitchDelta) {
+    if (yawDelta == 0.0f && pitchDelta == 0.0f) return;
+    float pitchBefore = rotation[0];
+    setRotation(rotation[0] + pitchDelta, rotation[1] + yawDelta, rotation[2]);
+    
+    // Shift the previous state by the same turn, so alpha does not blend it back out
+    previousRotation[0] += rotation[0] - pitchBefore;
+    previousRotation[1] += yawDelta;
+    if (previousRotation[0] > MAX_PITCH) previousRotation[0] = MAX_PITCH;
+    if (previousRotation[0] < -MAX_PITCH) previousRotation[0] = -MAX_PITCH;
+}
+
+bool Camera::isInterpolating() const {
+    for (int i = 0; i < 3; i++) {
+        if (previousPosition[i] != position[i] || previousRotation[i] != rotation[i]) return true;
+    }
+    return false;
+}
+
+void Camera::getInterpolatedPosition(float alpha, float pos[3]) const {
+    for (int i = 0; i < 3; i++) {
+        pos[i] = previousPosition[i] + (position[i] - previousPosition[i]) * alpha;
+    }
+}
+
 void Camera::clampAngles() {
     // Clamp pitch to prevent camera flipping
     if (rotation[0] > MAX_PITCH) rotation[0] = MAX_PITCH;
@@ -102,16 +160,22 @@ void Camera::clampAngles() {
 }
 
 void Camera::setPosition(float x, float y, float z) {
+    if (x == position[0] && y == position[1] && z == position[2]) return;
+    version++;
     position[0] = x;
     position[1] = y;
     position[2] = z;
 }
 
 void Camera::setRotation(float pitch, float yaw, float roll) {
+    float before[3] = { rotation[0], rotation[1], rotation[2] };
     rotation[0] = pitch;
     rotation[1] = yaw;
     rotation[2] = roll;
     clampAngles();
+    if (rotation[0] != before[0] || rotation[1] != before[1] || rotation[2] != before[2]) {
+        version++;
+    }
 }
 
 void Camera::setMouseSensitivity(float sensitivity) {
@@ -193,12 +257,9 @@ void HumanCamera::update(float deltaTime) {
     
     // Calculate target speed based on input
     float targetSpeed = 0.0f;
-    bool isRunning = input->isSpecialKeyPressed(112); // GLUT_KEY_SHIFT value is 112
+    bool isRunning = input->isActionPressed(InputAction::Run);
     
-    if (input->isKeyPressed('w') || input->isKeyPressed('W') || 
-        input->isKeyPressed('s') || input->isKeyPressed('S') ||
-        input->isKeyPressed('a') || input->isKeyPressed('A') ||
-        input->isKeyPressed('d') || input->isKeyPressed('D')) {
+    if (input->isMovementKeyPressed()) {
         
         targetSpeed = isRunning ? runSpeed : walkSpeed;
     }
@@ -241,19 +302,19 @@ void HumanCamera::update(float deltaTime) {
     float moveZ = 0.0f;
     
     // Combine movement from all directions
-    if (input->isKeyPressed('w') || input->isKeyPressed('W')) {
+    if (input->isActionPressed(InputAction::MoveForward)) {
         moveX += forwardX;
         moveZ += forwardZ;
     }
-    if (input->isKeyPressed('s') || input->isKeyPressed('S')) {
+    if (input->isActionPressed(InputAction::MoveBackward)) {
         moveX -= forwardX;
         moveZ -= forwardZ;
     }
-    if (input->isKeyPressed('a') || input->isKeyPressed('A')) {
+    if (input->isActionPressed(InputAction::MoveLeft)) {
         moveX -= rightX;
         moveZ -= rightZ;
     }
-    if (input->isKeyPressed('d') || input->isKeyPressed('D')) {
+    if (input->isActionPressed(InputAction::MoveRight)) {
         moveX += rightX;
         moveZ += rightZ;
     }
@@ -312,4 +373,29 @@ void HumanCamera::getRotation(float& pitch, float& yaw, float& roll) {
 void HumanCamera::adjustSensitivity(float factor) {
     setMouseSensitivity(getMouseSensitivity() * factor);
     printf("Mouse sensitivity: %.2f\n", getMouseSensitivity());
-}
\ No newline at end of file
+}
+bool HumanCamera::isSettling() {
+    float pos[3];
+    getPosition(pos);
+    return currentSpeed > 0.0f ||
+        std::fabs(lastYawDelta) > 0.001f || std::fabs(lastPitchDelta) > 0.001f ||
+        std::fabs(pos[1] - originalHeight) > 0.0005f;
+}
+
+void HumanCamera::teleport(float x, float y, float z, float pitch, float yaw) {
+    setPosition(x, y, z);
+    setRotation(pitch, yaw, 0.0f);
+    
+    // Arrive standing still
+    currentSpeed = 0.0f;
+    velocity[0] = 0.0f;
+    velocity[1] = 0.0f;
+    velocity[2] = 0.0f;
+    lastYawDelta = 0.0f;
+    lastPitchDelta = 0.0f;
+    bobPhase = 0.0f;
+    isMoving = false;
+    
+    // Don't interpolate across the jump
+    savePreviousState();
+}
@@ -21,6 +21,11 @@
  *    // In render function:
  *    camera.update(deltaTime);
  *    camera.applyTransformation();
+ *    
+ *    // With a fixed simulation step (fixed_timestep.h), render between steps:
+ *    camera.savePreviousState();
+ *    camera.update(step);
+ *    camera.applyTransformation(alpha);
  * 
  * 2. Using the HumanCamera:
  *    HumanCamera humanCamera;
@@ -38,6 +43,7 @@
 #pragma once
 #include <GL/glut.h>
 #include <cmath>
+#include <cstdint>
 #include "input.h"
 
 // Define PI if it's not already defined
@@ -51,6 +57,13 @@ private:
     float rotation[3];    // pitch, yaw, roll
     float mouseSensitivity;
     
+    // State at the start of the current simulation step, for interpolated rendering
+    float previousPosition[3];
+    float previousRotation[3];
+    
+    // Bumped whenever the position or rotation changes (render caching)
+    uint32_t version;
+    
     // Clamp angles to prevent camera flipping
     void clampAngles();
 
@@ -63,6 +76,24 @@ public:
     // Apply camera transformation to OpenGL
     void applyTransformation();
     
+    // Apply the transformation interpolated between the previous and current step (alpha 0..1)
+    void applyTransformation(float alpha);
+    
+    // Remember the current state as the start of the next simulation step
+    void savePreviousState();
+    
+    // Turn by mouse input between simulation steps (late latching); the interpolated view turns too
+    void addLook(float yawDelta, float pitchDelta);
+    
+    // Position interpolated the same way as applyTransformation(alpha)
+    void getInterpolatedPosition(float alpha, float pos[3]) const;
+    
+    // Changes with every move or turn
+    uint32_t getVersion() const { return version; }
+    
+    // Between two different simulation states, so the view changes with alpha
+    bool isInterpolating() const;
+    
     // Get/set camera properties
     void setPosition(float x, float y, float z);
     void getPosition(float& x, float& y, float& z) { x = position[0]; y = position[1]; z = position[2]; }
@@ -122,4 +153,10 @@ public:
     
     // Method to easily adjust sensitivity
     void adjustSensitivity(float factor);
+    
+    // Jump to a position and orientation, dropping any momentum
+    void teleport(float x, float y, float z, float pitch, float yaw);
+    
+    // Still moving, turning or settling after input stopped
+    bool isSettling();
 };
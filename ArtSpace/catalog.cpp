@@ -0,0 +1,550 @@
+#include "catalog.h"
+#include "hitch_monitor.h"
+#include "profiler.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const char CATALOG_MAGIC[4] = { 'A', 'S', 'C', 'T' };
+static const uint32_t CATALOG_VERSION = 2;
+
+// Append a string to a cell's string pool and return its offset
+static uint32_t addString(std::vector<char>& pool, const std::string& value) {
+    uint32_t offset = static_cast<uint32_t>(pool.size());
+    pool.insert(pool.end(), value.begin(), value.end());
+    pool.push_back('\0');
+    return offset;
+}
+
+// Tags are stored as one comma-separated pool string
+static std::string joinTags(const std::vector<std::string>& tags) {
+    std::string joined;
+    for (size_t i = 0; i < tags.size(); i++) {
+        if (i > 0) joined += ',';
+        joined += tags[i];
+    }
+    return joined;
+}
+
+static void splitTags(const std::string& joined, std::vector<std::string>& tags) {
+    tags.clear();
+    size_t start = 0;
+    while (start < joined.size()) {
+        size_t end = joined.find(',', start);
+        if (end == std::string::npos) end = joined.size();
+        if (end > start) {
+            tags.push_back(joined.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+}
+
+// CatalogWriter implementation
+bool CatalogWriter::write(const std::string& path, float cellSize) const {
+    if (cellSize <= 0.0f) {
+        Logger::getInstance().logError("CatalogWriter::write - invalid cell size");
+        return false;
+    }
+
+    // World-space floor positions decide the cell of each entry
+    std::vector<float> worldX(entries.size()), worldZ(entries.size());
+    float minX = 0.0f, minZ = 0.0f, maxX = 0.0f, maxZ = 0.0f;
+    for (size_t i = 0; i < entries.size(); i++) {
+        const ArtworkConfig& config = entries[i].config;
+        float world[3];
+        Artwork::placementToWorld(config.placement, config.posX, config.posY, config.posZ, world);
+        worldX[i] = world[0];
+        worldZ[i] = world[2];
+
+        if (i == 0 || world[0] < minX) minX = world[0];
+        if (i == 0 || world[2] < minZ) minZ = world[2];
+        if (i == 0 || world[0] > maxX) maxX = world[0];
+        if (i == 0 || world[2] > maxZ) maxZ = world[2];
+    }
+
+    CatalogFileHeader header;
+    memcpy(header.magic, CATALOG_MAGIC, sizeof(header.magic));
+    header.version = CATALOG_VERSION;
+    header.cellSize = cellSize;
+    header.originX = std::floor(minX / cellSize) * cellSize;
+    header.originZ = std::floor(minZ / cellSize) * cellSize;
+    header.cellsX = static_cast<uint32_t>((maxX - header.originX) / cellSize) + 1;
+    header.cellsZ = static_cast<uint32_t>((maxZ - header.originZ) / cellSize) + 1;
+    header.entryCount = static_cast<uint32_t>(entries.size());
+
+    // Bucket entries by cell
+    std::vector<std::vector<size_t>> buckets(static_cast<size_t>(header.cellsX) * header.cellsZ);
+    for (size_t i = 0; i < entries.size(); i++) {
+        uint32_t cellX = std::min(header.cellsX - 1, static_cast<uint32_t>((worldX[i] - header.originX) / cellSize));
+        uint32_t cellZ = std::min(header.cellsZ - 1, static_cast<uint32_t>((worldZ[i] - header.originZ) / cellSize));
+        buckets[cellZ * header.cellsX + cellX].push_back(i);
+    }
+
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file) {
+        Logger::getInstance().logError("CatalogWriter::write - could not open " + path);
+        return false;
+    }
+
+    // Header and cell table; the table is rewritten once the block offsets are known
+    std::vector<CatalogCellEntry> table(buckets.size());
+    memset(table.data(), 0, table.size() * sizeof(CatalogCellEntry));
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(CatalogCellEntry));
+
+    std::vector<CatalogRecord> records;
+    std::vector<char> pool;
+    for (size_t cell = 0; cell < buckets.size(); cell++) {
+        if (buckets[cell].empty()) continue;
+
+        records.clear();
+        pool.clear();
+        for (size_t index : buckets[cell]) {
+            const CatalogEntry& entry = entries[index];
+            const ArtworkConfig& config = entry.config;
+
+            CatalogRecord record;
+            memset(&record, 0, sizeof(record));
+            record.id = entry.id;
+            record.posX = config.posX;
+            record.posY = config.posY;
+            record.posZ = config.posZ;
+            record.width = config.width;
+            record.height = config.height;
+            record.placement = static_cast<uint8_t>(config.placement);
+            record.flags = (config.hasRotation ? CATALOG_FLAG_ROTATION : 0) |
+                (config.hasImageStretch ? CATALOG_FLAG_IMAGE_STRETCH : 0) |
+                (config.hasFrameStretch ? CATALOG_FLAG_FRAME_STRETCH : 0);
+            record.rotAngle = config.rotAngle;
+            record.rotX = config.rotX;
+            record.rotY = config.rotY;
+            record.rotZ = config.rotZ;
+            record.imageStretchX = config.imageStretchX;
+            record.imageStretchY = config.imageStretchY;
+            record.frameStretchX = config.frameStretchX;
+            record.frameStretchY = config.frameStretchY;
+            record.nameOffset = addString(pool, config.name);
+            record.imagePathOffset = addString(pool, entry.imagePath);
+            record.framePathOffset = addString(pool, entry.framePath);
+            record.artistOffset = addString(pool, config.artist);
+            record.tagsOffset = addString(pool, joinTags(config.tags));
+            record.year = config.year;
+            records.push_back(record);
+        }
+
+        table[cell].offset = static_cast<uint64_t>(file.tellp());
+        table[cell].recordCount = static_cast<uint32_t>(records.size());
+        table[cell].blockSize = static_cast<uint32_t>(records.size() * sizeof(CatalogRecord) + pool.size());
+        file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(CatalogRecord));
+        file.write(pool.data(), pool.size());
+    }
+
+    file.seekp(sizeof(header));
+    file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(CatalogCellEntry));
+
+    if (!file) {
+        Logger::getInstance().logError("CatalogWriter::write - failed writing " + path);
+        return false;
+    }
+
+    Logger::getInstance().logInfo("Wrote catalog " + path + ": " + std::to_string(entries.size()) +
+        " entries in " + std::to_string(header.cellsX) + "x" + std::to_string(header.cellsZ) + " cells");
+    return true;
+}
+
+// CatalogReader implementation
+CatalogReader::CatalogReader() {
+    memset(&header, 0, sizeof(header));
+}
+
+bool CatalogReader::open(const std::string& path) {
+    close();
+
+    file.open(path.c_str(), std::ios::binary);
+    if (!file) {
+        Logger::getInstance().logError("CatalogReader::open - could not open " + path);
+        return false;
+    }
+
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || memcmp(header.magic, CATALOG_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != CATALOG_VERSION || header.cellSize <= 0.0f) {
+        Logger::getInstance().logError("CatalogReader::open - " + path + " is not a supported catalog");
+        close();
+        return false;
+    }
+
+    cells.resize(static_cast<size_t>(header.cellsX) * header.cellsZ);
+    file.read(reinterpret_cast<char*>(cells.data()), cells.size() * sizeof(CatalogCellEntry));
+    if (!file) {
+        Logger::getInstance().logError("CatalogReader::open - truncated cell table in " + path);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void CatalogReader::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+    file.clear();
+    cells.clear();
+    memset(&header, 0, sizeof(header));
+}
+
+bool CatalogReader::readCell(int cellIndex, std::vector<CatalogEntry>& out) {
+    out.clear();
+    if (!file.is_open() || cellIndex < 0 || cellIndex >= static_cast<int>(cells.size())) {
+        return false;
+    }
+
+    const CatalogCellEntry& cell = cells[cellIndex];
+    if (cell.recordCount == 0) {
+        return true;
+    }
+
+    size_t recordBytes = static_cast<size_t>(cell.recordCount) * sizeof(CatalogRecord);
+    if (cell.blockSize < recordBytes) {
+        return false;
+    }
+
+    // One seek and one read per cell
+    std::vector<char> block(cell.blockSize);
+    file.clear();
+    file.seekg(static_cast<std::streamoff>(cell.offset));
+    file.read(block.data(), block.size());
+    if (!file) {
+        return false;
+    }
+
+    const char* pool = block.data() + recordBytes;
+    size_t poolSize = block.size() - recordBytes;
+    auto readString = [pool, poolSize](uint32_t offset) {
+        if (offset >= poolSize) return std::string();
+        const char* start = pool + offset;
+        const void* end = memchr(start, '\0', poolSize - offset);
+        return end ? std::string(start, static_cast<const char*>(end)) : std::string();
+    };
+
+    out.resize(cell.recordCount);
+    for (uint32_t i = 0; i < cell.recordCount; i++) {
+        CatalogRecord record;
+        memcpy(&record, block.data() + i * sizeof(CatalogRecord), sizeof(record));
+
+        CatalogEntry& entry = out[i];
+        ArtworkConfig& config = entry.config;
+        entry.id = record.id;
+        config.name = readString(record.nameOffset);
+        config.posX = record.posX;
+        config.posY = record.posY;
+        config.posZ = record.posZ;
+        config.width = record.width;
+        config.height = record.height;
+        config.placement = record.placement <= WEST_WALL ? static_cast<ArtworkPlacement>(record.placement) : NORTH_WALL;
+        config.hasRotation = (record.flags & CATALOG_FLAG_ROTATION) != 0;
+        config.rotAngle = record.rotAngle;
+        config.rotX = record.rotX;
+        config.rotY = record.rotY;
+        config.rotZ = record.rotZ;
+        config.hasImageStretch = (record.flags & CATALOG_FLAG_IMAGE_STRETCH) != 0;
+        config.imageStretchX = record.imageStretchX;
+        config.imageStretchY = record.imageStretchY;
+        config.hasFrameStretch = (record.flags & CATALOG_FLAG_FRAME_STRETCH) != 0;
+        config.frameStretchX = record.frameStretchX;
+        config.frameStretchY = record.frameStretchY;
+        entry.imagePath = readString(record.imagePathOffset);
+        entry.framePath = readString(record.framePathOffset);
+        config.artist = readString(record.artistOffset);
+        config.year = record.year;
+        splitTags(readString(record.tagsOffset), config.tags);
+    }
+    return true;
+}
+
+void CatalogReader::getCellBounds(int cellX, int cellZ, float& minX, float& minZ, float& maxX, float& maxZ) const {
+    minX = header.originX + cellX * header.cellSize;
+    minZ = header.originZ + cellZ * header.cellSize;
+    maxX = minX + header.cellSize;
+    maxZ = minZ + header.cellSize;
+}
+
+void CatalogReader::worldToCell(float x, float z, int& cellX, int& cellZ) const {
+    cellX = static_cast<int>(std::floor((x - header.originX) / header.cellSize));
+    cellZ = static_cast<int>(std::floor((z - header.originZ) / header.cellSize));
+}
+
+// CatalogPager implementation
+CatalogPager::CatalogPager()
+    : manager(nullptr)
+    , stopping(false)
+    , loadRadius(30.0f)
+    , unloadRadius(45.0f)
+    , maxIntegrationsPerFrame(4)
+    , residentArtworks(0) {
+}
+
+CatalogPager::~CatalogPager() {
+    close();
+}
+
+bool CatalogPager::open(const std::string& path, ArtworkManager* artworkManager) {
+    close();
+
+    if (!artworkManager || !reader.open(path)) {
+        return false;
+    }
+
+    manager = artworkManager;
+    stopping = false;
+    loader = std::thread(&CatalogPager::loaderThread, this);
+
+    Logger::getInstance().logInfo("Opened catalog " + path + ": " + std::to_string(reader.getEntryCount()) +
+        " artworks in " + std::to_string(reader.getCellsX()) + "x" + std::to_string(reader.getCellsZ()) + " cells");
+    return true;
+}
+
+void CatalogPager::close() {
+    // Stop the loader thread first so nothing new arrives
+    if (loader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            stopping = true;
+            requests.clear();
+        }
+        queueSignal.notify_all();
+        loader.join();
+    }
+    completed.clear();
+    integrating.clear();
+
+    // Drop every paged artwork from the manager
+    if (manager) {
+        for (auto& cell : cells) {
+            for (ArtworkHandle handle : cell.second.artworks) {
+                manager->removeArtwork(handle);
+            }
+        }
+    }
+    cells.clear();
+    residentArtworks = 0;
+    reader.close();
+}
+
+void CatalogPager::setLoadRadius(float radius) {
+    loadRadius = std::max(1.0f, radius);
+    if (unloadRadius < loadRadius) {
+        unloadRadius = loadRadius * 1.5f;
+    }
+}
+
+void CatalogPager::setUnloadRadius(float radius) {
+    unloadRadius = std::max(radius, loadRadius);
+}
+
+size_t CatalogPager::getPendingCells() const {
+    size_t pending = 0;
+    for (const auto& cell : cells) {
+        if (cell.second.state != CELL_RESIDENT) pending++;
+    }
+    return pending;
+}
+
+float CatalogPager::distanceToCell(int cellIndex, float x, float z) const {
+    int cellX = cellIndex % reader.getCellsX();
+    int cellZ = cellIndex / reader.getCellsX();
+    float minX, minZ, maxX, maxZ;
+    reader.getCellBounds(cellX, cellZ, minX, minZ, maxX, maxZ);
+
+    float dx = std::max(0.0f, std::max(minX - x, x - maxX));
+    float dz = std::max(0.0f, std::max(minZ - z, z - maxZ));
+    return std::sqrt(dx * dx + dz * dz);
+}
+
+void CatalogPager::update(const float cameraPos[3]) {
+    if (!reader.isOpen()) return;
+
+    integrateCompleted();
+
+    // Request the missing cells within the load radius, nearest first
+    int centerX, centerZ;
+    reader.worldToCell(cameraPos[0], cameraPos[2], centerX, centerZ);
+    int range = static_cast<int>(std::ceil(loadRadius / reader.getCellSize()));
+
+    std::vector<std::pair<float, int>> wanted;
+    for (int cellZ = std::max(0, centerZ - range); cellZ <= std::min(reader.getCellsZ() - 1, centerZ + range); cellZ++) {
+        for (int cellX = std::max(0, centerX - range); cellX <= std::min(reader.getCellsX() - 1, centerX + range); cellX++) {
+            int cellIndex = cellZ * reader.getCellsX() + cellX;
+            if (cells.count(cellIndex) || reader.getCellRecordCount(cellIndex) == 0) continue;
+
+            float distance = distanceToCell(cellIndex, cameraPos[0], cameraPos[2]);
+            if (distance <= loadRadius) {
+                wanted.push_back(std::make_pair(distance, cellIndex));
+            }
+        }
+    }
+    std::sort(wanted.begin(), wanted.end());
+    for (const auto& cell : wanted) {
+        requestCell(cell.second);
+    }
+
+    // Drop the cells the visitor has walked away from
+    std::vector<int> farCells;
+    for (const auto& cell : cells) {
+        if (distanceToCell(cell.first, cameraPos[0], cameraPos[2]) > unloadRadius) {
+            farCells.push_back(cell.first);
+        }
+    }
+    for (int cellIndex : farCells) {
+        unloadCell(cellIndex);
+    }
+
+    TRACE_COUNTER("Resident artworks", residentArtworks);
+}
+
+void CatalogPager::requestCell(int cellIndex) {
+    CellSlot& slot = cells[cellIndex];
+    slot.state = CELL_QUEUED;
+    slot.artworks.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.push_back(cellIndex);
+    }
+    queueSignal.notify_one();
+}
+
+void CatalogPager::unloadCell(int cellIndex) {
+    auto it = cells.find(cellIndex);
+    if (it == cells.end()) return;
+
+    if (it->second.state == CELL_QUEUED) {
+        // Not read yet: withdraw the request (a read already in flight is discarded on arrival)
+        std::lock_guard<std::mutex> lock(queueMutex);
+        requests.erase(std::remove(requests.begin(), requests.end(), cellIndex), requests.end());
+    }
+    else if (it->second.state == CELL_INTEGRATING) {
+        integrating.erase(std::remove_if(integrating.begin(), integrating.end(),
+            [cellIndex](const std::unique_ptr<CellLoad>& load) { return load->cell == cellIndex; }),
+            integrating.end());
+    }
+
+    for (ArtworkHandle handle : it->second.artworks) {
+        if (manager->removeArtwork(handle)) {
+            residentArtworks--;
+        }
+    }
+    cells.erase(it);
+}
+
+void CatalogPager::integrateCompleted() {
+    TRACE_SCOPE("Catalog integrate");
+    // Take the finished reads off the loader thread
+    std::deque<std::unique_ptr<CellLoad>> arrived;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        arrived.swap(completed);
+    }
+
+    for (std::unique_ptr<CellLoad>& load : arrived) {
+        auto it = cells.find(load->cell);
+        if (it == cells.end() || it->second.state != CELL_QUEUED) {
+            continue;  // Cell was unloaded (or re-requested) while it was being read
+        }
+
+        it->second.state = CELL_INTEGRATING;
+        integrating.push_back(std::move(load));
+    }
+
+    // Texture uploads happen here on the GL thread, a few per frame to avoid hitches
+    int budget = maxIntegrationsPerFrame;
+    while (budget > 0 && !integrating.empty()) {
+        CellLoad& load = *integrating.front();
+        CellSlot& slot = cells[load.cell];
+
+        while (budget > 0 && load.integrated < load.artworks.size()) {
+            DecodedArtwork& decoded = load.artworks[load.integrated++];
+            ArtworkHandle handle = manager->createArtworkFromImages(decoded.image.get(), decoded.frame.get(),
+                decoded.entry.config, decoded.entry.imagePath, decoded.entry.framePath);
+            slot.artworks.push_back(handle);
+            residentArtworks++;
+            budget--;
+
+            // The artwork keeps its own copy; release the decoded pixels now
+            decoded.image.reset();
+            decoded.frame.reset();
+
+            if (onArtworkLoaded) {
+                onArtworkLoaded(handle);
+            }
+        }
+
+        if (load.integrated == load.artworks.size()) {
+            slot.state = CELL_RESIDENT;
+            integrating.pop_front();
+        }
+    }
+}
+
+void CatalogPager::loaderThread() {
+    Profiler::getInstance().setThreadName("Catalog loader");
+    Tracer::getInstance().setThreadName("Catalog loader");
+    std::vector<CatalogEntry> entries;
+
+    while (true) {
+        int cellIndex;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueSignal.wait(lock, [this] { return stopping || !requests.empty(); });
+            if (stopping) return;
+            cellIndex = requests.front();
+            requests.pop_front();
+        }
+
+        PROFILE_SCOPE("Catalog cell load");
+        std::unique_ptr<CellLoad> load(new CellLoad());
+        load->cell = cellIndex;
+        load->integrated = 0;
+        {
+            TRACE_SCOPE("Catalog read cell");
+            if (!reader.readCell(cellIndex, entries)) {
+                LOG_WARN("CatalogPager - failed to read cell {}", cellIndex);
+            }
+        }
+
+        // Frames are usually shared, so decode each path once per cell
+        std::unordered_map<std::string, std::shared_ptr<sf::Image>> decodedPaths;
+        auto decode = [&](const std::string& path) -> std::shared_ptr<sf::Image> {
+            if (path.empty()) return nullptr;
+            auto found = decodedPaths.find(path);
+            if (found != decodedPaths.end()) return found->second;
+
+            TRACE_SCOPE_DETAIL("Image decode", path);
+            uint64_t decodeStart = Profiler::now();
+            std::shared_ptr<sf::Image> image = std::make_shared<sf::Image>();
+            if (!image->loadFromFile(path)) {
+                LOG_WARN("CatalogPager - failed to decode {} in cell {}", path, cellIndex);
+                image.reset();
+            }
+            HitchMonitor::getInstance().noteEvent("asset", "Cell " + std::to_string(cellIndex) + " decoded " +
+                path + " in " + std::to_string((Profiler::now() - decodeStart) / 1000) + " us");
+            decodedPaths[path] = image;
+            return image;
+        };
+
+        load->artworks.reserve(entries.size());
+        for (const CatalogEntry& entry : entries) {
+            if (stopping) return;
+
+            DecodedArtwork decoded;
+            decoded.entry = entry;
+            decoded.image = decode(entry.imagePath);
+            decoded.frame = decode(entry.framePath);
+            load->artworks.push_back(decoded);
+        }
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        completed.push_back(std::move(load));
+    }
+}
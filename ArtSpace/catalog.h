@@ -0,0 +1,224 @@
+/**
+ * @file catalog.h
+ * @brief Disk-backed artwork catalog partitioned into spatial cells, with a background pager
+ *
+ * A catalog file describes an exhibition too large to keep in memory as
+ * Artwork objects. The floor plan is cut into square cells; each cell's
+ * records (placement, stretch, name and asset paths) are stored as one
+ * contiguous block so a cell is loaded with a single seek and read.
+ *
+ * File layout (little-endian):
+ *    CatalogFileHeader
+ *    CatalogCellEntry[cellsX * cellsZ]      offset/size of each cell block
+ *    cell blocks: CatalogRecord[recordCount] followed by the cell's string pool
+ *
+ * Version 2 added the search metadata (artist, year, tags) to each record.
+ *
+ * The CatalogPager keeps only the cells near the camera instantiated in the
+ * ArtworkManager. Cell blocks are read and their images decoded on a
+ * background thread; the main thread then uploads a bounded number of
+ * artworks per frame, and drops the artworks of cells the visitor has left.
+ *
+ * Usage:
+ *    CatalogWriter writer;
+ *    writer.addEntry(entry);                // repeat for every piece
+ *    writer.write("exhibition.cat", 20.0f); // 20x20 unit cells
+ *
+ *    CatalogPager pager;
+ *    pager.open("exhibition.cat", ArtworkManager::getInstance());
+ *    // Each frame:
+ *    pager.update(cameraPosition);
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <functional>
+#include <SFML/Graphics/Image.hpp>
+#include "artwork_manager.h"
+
+// CatalogRecord::flags
+enum CatalogFlags {
+    CATALOG_FLAG_ROTATION = 1,
+    CATALOG_FLAG_IMAGE_STRETCH = 2,
+    CATALOG_FLAG_FRAME_STRETCH = 4
+};
+
+// On-disk structures
+#pragma pack(push, 1)
+struct CatalogFileHeader {
+    char magic[4];          // "ASCT"
+    uint32_t version;
+    float cellSize;
+    float originX, originZ; // World position of the corner of cell (0, 0)
+    uint32_t cellsX, cellsZ;
+    uint32_t entryCount;
+};
+
+struct CatalogCellEntry {
+    uint64_t offset;        // Start of the cell block in the file
+    uint32_t recordCount;
+    uint32_t blockSize;     // Records plus string pool, in bytes
+};
+
+struct CatalogRecord {
+    uint32_t id;
+    float posX, posY, posZ;
+    float width, height;
+    uint8_t placement;
+    uint8_t flags;          // CATALOG_FLAG_* bits
+    uint16_t reserved;
+    float rotAngle, rotX, rotY, rotZ;
+    float imageStretchX, imageStretchY;
+    float frameStretchX, frameStretchY;
+    uint32_t nameOffset;    // Offsets into the cell's string pool
+    uint32_t imagePathOffset;
+    uint32_t framePathOffset;
+    uint32_t artistOffset;
+    uint32_t tagsOffset;    // Tags joined with ','
+    int32_t year;           // 0 when unknown
+};
+#pragma pack(pop)
+
+// One catalogued piece
+struct CatalogEntry {
+    uint32_t id = 0;
+    ArtworkConfig config;
+    std::string imagePath;
+    std::string framePath;
+};
+
+class CatalogWriter {
+private:
+    std::vector<CatalogEntry> entries;
+
+public:
+    static constexpr float DEFAULT_CELL_SIZE = 20.0f;
+
+    void addEntry(const CatalogEntry& entry) { entries.push_back(entry); }
+    size_t getEntryCount() const { return entries.size(); }
+    void clear() { entries.clear(); }
+
+    // Bucket the entries into cells and write the catalog file
+    bool write(const std::string& path, float cellSize = DEFAULT_CELL_SIZE) const;
+};
+
+class CatalogReader {
+private:
+    std::ifstream file;
+    CatalogFileHeader header;
+    std::vector<CatalogCellEntry> cells;
+
+public:
+    CatalogReader();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file.is_open(); }
+
+    // Read every record of a cell
+    bool readCell(int cellIndex, std::vector<CatalogEntry>& out);
+
+    // Grid queries
+    float getCellSize() const { return header.cellSize; }
+    int getCellsX() const { return static_cast<int>(header.cellsX); }
+    int getCellsZ() const { return static_cast<int>(header.cellsZ); }
+    uint32_t getEntryCount() const { return header.entryCount; }
+    uint32_t getCellRecordCount(int cellIndex) const { return cells[cellIndex].recordCount; }
+    void getCellBounds(int cellX, int cellZ, float& minX, float& minZ, float& maxX, float& maxZ) const;
+    void worldToCell(float x, float z, int& cellX, int& cellZ) const;
+};
+
+class CatalogPager {
+private:
+    enum CellState {
+        CELL_QUEUED,       // Waiting for (or being read by) the loader thread
+        CELL_INTEGRATING,  // Decoded, artworks being created a few per frame
+        CELL_RESIDENT      // All artworks live in the manager
+    };
+
+    struct CellSlot {
+        CellState state;
+        std::vector<ArtworkHandle> artworks;
+    };
+
+    // Artwork decoded by the loader thread, ready for upload
+    struct DecodedArtwork {
+        CatalogEntry entry;
+        std::shared_ptr<sf::Image> image;
+        std::shared_ptr<sf::Image> frame;
+    };
+
+    struct CellLoad {
+        int cell;
+        std::vector<DecodedArtwork> artworks;
+        size_t integrated;  // Artworks already created
+    };
+
+    CatalogReader reader;
+    ArtworkManager* manager;
+    std::function<void(ArtworkHandle)> onArtworkLoaded;
+
+    // Cells this pager has touched (queued, integrating or resident)
+    std::unordered_map<int, CellSlot> cells;
+    std::deque<std::unique_ptr<CellLoad>> integrating;
+
+    // Loader thread and its queues (guarded by queueMutex)
+    std::thread loader;
+    std::mutex queueMutex;
+    std::condition_variable queueSignal;
+    std::deque<int> requests;
+    std::deque<std::unique_ptr<CellLoad>> completed;
+    std::atomic<bool> stopping;
+
+    float loadRadius;
+    float unloadRadius;
+    int maxIntegrationsPerFrame;
+    size_t residentArtworks;
+
+    void loaderThread();
+    void requestCell(int cellIndex);
+    void unloadCell(int cellIndex);
+    void integrateCompleted();
+    float distanceToCell(int cellIndex, float x, float z) const;
+
+public:
+    CatalogPager();
+    ~CatalogPager();
+
+    CatalogPager(const CatalogPager&) = delete;
+    CatalogPager& operator=(const CatalogPager&) = delete;
+
+    // Open a catalog and start the loader thread
+    bool open(const std::string& path, ArtworkManager* artworkManager);
+
+    // Unload every paged artwork and stop the loader thread
+    void close();
+    bool isOpen() const { return reader.isOpen(); }
+
+    // Stream cells around the camera (main thread, once per frame)
+    void update(const float cameraPos[3]);
+
+    // Called for each artwork after it has been added to the manager
+    void setOnArtworkLoaded(std::function<void(ArtworkHandle)> callback) { onArtworkLoaded = callback; }
+
+    // Streaming distances (unload radius is kept above the load radius)
+    void setLoadRadius(float radius);
+    void setUnloadRadius(float radius);
+    void setMaxIntegrationsPerFrame(int count) { maxIntegrationsPerFrame = count > 0 ? count : 1; }
+
+    // Statistics
+    uint32_t getCatalogSize() const { return reader.isOpen() ? reader.getEntryCount() : 0; }
+    size_t getResidentArtworks() const { return residentArtworks; }
+    size_t getTrackedCells() const { return cells.size(); }
+    size_t getPendingCells() const;
+};
@@ -7,9 +7,12 @@
 Config Config::instance;
 
 Config::Config()
-    : displaySettings{1024, 768, false}
-    , cameraSettings{0.5f, 5.0f, 3.0f}
-    , gameplaySettings{45.0f, "assets/"} {
+    : displaySettings{1024, 768, false, 60.0f, true, true, true, -1, true, true, 0.5f, 0.3f, ""}
+    , cameraSettings{0.5f, 5.0f, 3.0f, true, true}
+    , gameplaySettings{45.0f, "assets/", 60.0f}
+    , streamingSettings{"", 30.0f}
+    , diagnosticsSettings{false, "profile.csv", "trace.json", false, true, 100.0f, "", "", "", "", false}
+    , controlSettings{} {
 }
 
 // Singleton access
@@ -45,6 +48,86 @@ void Config::setFullscreen(bool enable) {
     displaySettings.fullscreen = enable; 
 }
 
+float Config::getTargetFrameRate() const {
+    return displaySettings.targetFrameRate;
+}
+
+void Config::setTargetFrameRate(float rate) {
+    displaySettings.targetFrameRate = validateTargetFrameRate(rate);
+}
+
+bool Config::isVsyncEnabled() const {
+    return displaySettings.vsync;
+}
+
+void Config::setVsyncEnabled(bool enable) {
+    displaySettings.vsync = enable;
+}
+
+bool Config::isIdleThrottling() const {
+    return displaySettings.idleThrottling;
+}
+
+void Config::setIdleThrottling(bool enable) {
+    displaySettings.idleThrottling = enable;
+}
+
+bool Config::isRenderCaching() const {
+    return displaySettings.renderCaching;
+}
+
+void Config::setRenderCaching(bool enable) {
+    displaySettings.renderCaching = enable;
+}
+
+int Config::getQualityTier() const {
+    return displaySettings.qualityTier;
+}
+
+void Config::setQualityTier(int tier) {
+    displaySettings.qualityTier = validateQualityTier(tier);
+}
+
+bool Config::isAdaptiveQuality() const {
+    return displaySettings.adaptiveQuality;
+}
+
+void Config::setAdaptiveQuality(bool enable) {
+    displaySettings.adaptiveQuality = enable;
+}
+
+bool Config::isDynamicResolution() const {
+    return displaySettings.dynamicResolution;
+}
+
+void Config::setDynamicResolution(bool enable) {
+    displaySettings.dynamicResolution = enable;
+}
+
+float Config::getMinRenderScale() const {
+    return displaySettings.minRenderScale;
+}
+
+void Config::setMinRenderScale(float scale) {
+    displaySettings.minRenderScale = validateMinRenderScale(scale);
+}
+
+float Config::getUpscaleSharpness() const {
+    return displaySettings.upscaleSharpness;
+}
+
+void Config::setUpscaleSharpness(float sharpness) {
+    displaySettings.upscaleSharpness = validateUpscaleSharpness(sharpness);
+}
+
+const std::string& Config::getUiFontPath() const {
+    return displaySettings.uiFontPath;
+}
+
+void Config::setUiFontPath(const std::string& path) {
+    displaySettings.uiFontPath = path;
+}
+
 // Camera settings
 float Config::getMouseSensitivity() const { 
     return cameraSettings.mouseSensitivity; 
@@ -70,6 +153,22 @@ void Config::setInteractionDistance(float distance) {
     cameraSettings.interactionDistance = validateInteractionDistance(distance); 
 }
 
+bool Config::isLateLatching() const {
+    return cameraSettings.lateLatching;
+}
+
+void Config::setLateLatching(bool enable) {
+    cameraSettings.lateLatching = enable;
+}
+
+bool Config::isRelativeMouse() const {
+    return cameraSettings.relativeMouse;
+}
+
+void Config::setRelativeMouse(bool enable) {
+    cameraSettings.relativeMouse = enable;
+}
+
 // Gameplay settings
 float Config::getRotationStep() const { 
     return gameplaySettings.rotationStep; 
@@ -79,6 +178,14 @@ void Config::setRotationStep(float step) {
     gameplaySettings.rotationStep = validateRotationStep(step); 
 }
 
+float Config::getSimulationRate() const {
+    return gameplaySettings.simulationRate;
+}
+
+void Config::setSimulationRate(float rate) {
+    gameplaySettings.simulationRate = validateSimulationRate(rate);
+}
+
 const std::string& Config::getAssetPath() const {
     return gameplaySettings.assetPath;
 }
@@ -88,6 +195,126 @@ void Config::setAssetPath(const std::string& path) {
     Logger::getInstance().logInfo("Asset path set to: " + path);
 }
 
+// Streaming settings
+const std::string& Config::getCatalogPath() const {
+    return streamingSettings.catalogPath;
+}
+
+void Config::setCatalogPath(const std::string& path) {
+    streamingSettings.catalogPath = path;
+    Logger::getInstance().logInfo("Catalog path set to: " + path);
+}
+
+float Config::getCatalogLoadRadius() const {
+    return streamingSettings.catalogLoadRadius;
+}
+
+void Config::setCatalogLoadRadius(float radius) {
+    streamingSettings.catalogLoadRadius = validateCatalogLoadRadius(radius);
+}
+
+// Diagnostics settings
+bool Config::isProfilerShown() const {
+    return diagnosticsSettings.showProfiler;
+}
+
+void Config::setProfilerShown(bool show) {
+    diagnosticsSettings.showProfiler = show;
+}
+
+const std::string& Config::getProfilerCsvPath() const {
+    return diagnosticsSettings.profilerCsvPath;
+}
+
+void Config::setProfilerCsvPath(const std::string& path) {
+    diagnosticsSettings.profilerCsvPath = path;
+}
+
+const std::string& Config::getTracePath() const {
+    return diagnosticsSettings.tracePath;
+}
+
+void Config::setTracePath(const std::string& path) {
+    diagnosticsSettings.tracePath = path;
+}
+
+bool Config::isTraceAtStartup() const {
+    return diagnosticsSettings.traceAtStartup;
+}
+
+void Config::setTraceAtStartup(bool enable) {
+    diagnosticsSettings.traceAtStartup = enable;
+}
+
+bool Config::isHitchMonitorEnabled() const {
+    return diagnosticsSettings.hitchMonitor;
+}
+
+void Config::setHitchMonitorEnabled(bool enable) {
+    diagnosticsSettings.hitchMonitor = enable;
+}
+
+float Config::getHitchBudgetMs() const {
+    return diagnosticsSettings.hitchBudgetMs;
+}
+
+void Config::setHitchBudgetMs(float milliseconds) {
+    diagnosticsSettings.hitchBudgetMs = validateHitchBudget(milliseconds);
+}
+
+const std::string& Config::getHitchReportDir() const {
+    return diagnosticsSettings.hitchReportDir;
+}
+
+void Config::setHitchReportDir(const std::string& directory) {
+    diagnosticsSettings.hitchReportDir = directory;
+}
+
+const std::string& Config::getBinaryLogPath() const {
+    return diagnosticsSettings.binaryLogPath;
+}
+
+void Config::setBinaryLogPath(const std::string& path) {
+    diagnosticsSettings.binaryLogPath = path;
+}
+
+const std::string& Config::getInputRecordPath() const {
+    return diagnosticsSettings.inputRecordPath;
+}
+
+void Config::setInputRecordPath(const std::string& path) {
+    diagnosticsSettings.inputRecordPath = path;
+}
+
+const std::string& Config::getInputReplayPath() const {
+    return diagnosticsSettings.inputReplayPath;
+}
+
+void Config::setInputReplayPath(const std::string& path) {
+    diagnosticsSettings.inputReplayPath = path;
+}
+
+bool Config::isReplayMaxSpeed() const {
+    return diagnosticsSettings.replayMaxSpeed;
+}
+
+void Config::setReplayMaxSpeed(bool enable) {
+    diagnosticsSettings.replayMaxSpeed = enable;
+}
+
+// Control settings
+const std::map<std::string, std::string>& Config::getKeyBindings() const {
+    return controlSettings.keyBindings;
+}
+
+void Config::setKeyBinding(const std::string& action, const std::string& keys) {
+    if (keys.empty()) {
+        controlSettings.keyBindings.erase(action);
+    } else {
+        controlSettings.keyBindings[action] = keys;
+    }
+}
+
 // Validation methods that enforce limits
 int Config::validateScreenWidth(int width) const {
     if (width < MIN_SCREEN_WIDTH) {
@@ -121,6 +348,73 @@ int Config::validateScreenHeight(int height) const {
     return height;
 }
 
+int Config::validateQualityTier(int tier) const {
+    if (tier < MIN_QUALITY_TIER) {
+        Logger::getInstance().logWarning("Quality tier " + std::to_string(tier) + 
+                                          " is below minimum. Using automatic selection");
+        return MIN_QUALITY_TIER;
+    }
+    else if (tier > MAX_QUALITY_TIER) {
+        Logger::getInstance().logWarning("Quality tier " + std::to_string(tier) + 
+                                          " exceeds maximum. Using maximum value: " + 
+                                          std::to_string(MAX_QUALITY_TIER));
+        return MAX_QUALITY_TIER;
+    }
+    return tier;
+}
+
+float Config::validateMinRenderScale(float scale) const {
+    if (scale < MIN_RENDER_SCALE) {
+        Logger::getInstance().logWarning("Minimum render scale " + std::to_string(scale) + 
+                                          " is below minimum. Using minimum value: " + 
+                                          std::to_string(MIN_RENDER_SCALE));
+        return MIN_RENDER_SCALE;
+    }
+    else if (scale > MAX_RENDER_SCALE) {
+        Logger::getInstance().logWarning("Minimum render scale " + std::to_string(scale) + 
+                                          " exceeds maximum. Using maximum value: " + 
+                                          std::to_string(MAX_RENDER_SCALE));
+        return MAX_RENDER_SCALE;
+    }
+    return scale;
+}
+
+float Config::validateUpscaleSharpness(float sharpness) const {
+    if (sharpness < MIN_UPSCALE_SHARPNESS) {
+        Logger::getInstance().logWarning("Upscale sharpness " + std::to_string(sharpness) + 
+                                          " is below minimum. Using minimum value: " + 
+                                          std::to_string(MIN_UPSCALE_SHARPNESS));
+        return MIN_UPSCALE_SHARPNESS;
+    }
+    else if (sharpness > MAX_UPSCALE_SHARPNESS) {
+        Logger::getInstance().logWarning("Upscale sharpness " + std::to_string(sharpness) + 
+                                          " exceeds maximum. Using maximum value: " + 
+                                          std::to_string(MAX_UPSCALE_SHARPNESS));
+        return MAX_UPSCALE_SHARPNESS;
+    }
+    return sharpness;
+}
+
+float Config::validateTargetFrameRate(float rate) const {
+    // 0 leaves the frame rate to vsync
+    if (rate <= 0.0f) {
+        return 0.0f;
+    }
+    if (rate < MIN_TARGET_FRAME_RATE) {
+        Logger::getInstance().logWarning("Target frame rate " + std::to_string(rate) + 
+                                          " is below minimum. Using minimum value: " + 
+                                          std::to_string(MIN_TARGET_FRAME_RATE));
+        return MIN_TARGET_FRAME_RATE;
+    }
+    else if (rate > MAX_TARGET_FRAME_RATE) {
+        Logger::getInstance().logWarning("Target frame rate " + std::to_string(rate) + 
+                                          " exceeds maximum. Using maximum value: " + 
+                                          std::to_string(MAX_TARGET_FRAME_RATE));
+        return MAX_TARGET_FRAME_RATE;
+    }
+    return rate;
+}
+
 float Config::validateMouseSensitivity(float sensitivity) const {
     if (sensitivity < MIN_MOUSE_SENSITIVITY) {
         Logger::getInstance().logWarning("Mouse sensitivity " + std::to_string(sensitivity) + 
@@ -185,6 +479,54 @@ float Config::validateRotationStep(float step) const {
     return step;
 }
 
+float Config::validateSimulationRate(float rate) const {
+    if (rate < MIN_SIMULATION_RATE) {
+        Logger::getInstance().logWarning("Simulation rate " + std::to_string(rate) + 
+                                         " is below minimum. Using minimum value: " + 
+                                         std::to_string(MIN_SIMULATION_RATE));
+        return MIN_SIMULATION_RATE;
+    }
+    else if (rate > MAX_SIMULATION_RATE) {
+        Logger::getInstance().logWarning("Simulation rate " + std::to_string(rate) + 
+                                         " exceeds maximum. Using maximum value: " + 
+                                         std::to_string(MAX_SIMULATION_RATE));
+        return MAX_SIMULATION_RATE;
+    }
+    return rate;
+}
+
+float Config::validateCatalogLoadRadius(float radius) const {
+    if (radius < MIN_CATALOG_LOAD_RADIUS) {
+        Logger::getInstance().logWarning("Catalog load radius " + std::to_string(radius) + 
+                                         " is below minimum. Using minimum value: " + 
+                                         std::to_string(MIN_CATALOG_LOAD_RADIUS));
+        return MIN_CATALOG_LOAD_RADIUS;
+    }
+    else if (radius > MAX_CATALOG_LOAD_RADIUS) {
+        Logger::getInstance().logWarning("Catalog load radius " + std::to_string(radius) + 
+                                         " exceeds maximum. Using maximum value: " + 
+                                         std::to_string(MAX_CATALOG_LOAD_RADIUS));
+        return MAX_CATALOG_LOAD_RADIUS;
+    }
+    return radius;
+}
+
+float Config::validateHitchBudget(float milliseconds) const {
+    if (milliseconds < MIN_HITCH_BUDGET_MS) {
+        Logger::getInstance().logWarning("Hitch budget " + std::to_string(milliseconds) + 
+                                         " ms is below minimum. Using minimum value: " + 
+                                         std::to_string(MIN_HITCH_BUDGET_MS));
+        return MIN_HITCH_BUDGET_MS;
+    }
+    else if (milliseconds > MAX_HITCH_BUDGET_MS) {
+        Logger::getInstance().logWarning("Hitch budget " + std::to_string(milliseconds) + 
+                                         " ms exceeds maximum. Using maximum value: " + 
+                                         std::to_string(MAX_HITCH_BUDGET_MS));
+        return MAX_HITCH_BUDGET_MS;
+    }
+    return milliseconds;
+}
+
 // Configuration management
 void Config::applyOptimalSettings() {
     // These won't trigger warnings since they're within limits
@@ -192,6 +534,10 @@ void Config::applyOptimalSettings() {
     setMoveSpeed(6.0f);
     setInteractionDistance(2.5f);
     setRotationStep(45.0f);
+
+    // Let the startup benchmark and the quality governor pick render quality
+    setQualityTier(-1);
+    setAdaptiveQuality(true);
     
     Logger::getInstance().logInfo("Applied optimal settings for single-level game");
 }
@@ -200,11 +546,38 @@ void Config::resetToDefaults() {
     displaySettings.screenWidth = 1280;
     displaySettings.screenHeight = 720;
     displaySettings.fullscreen = false;
+    displaySettings.targetFrameRate = 60.0f;
+    displaySettings.vsync = true;
+    displaySettings.idleThrottling = true;
+    displaySettings.renderCaching = true;
+    displaySettings.qualityTier = -1;
+    displaySettings.adaptiveQuality = true;
+    displaySettings.dynamicResolution = true;
+    displaySettings.minRenderScale = 0.5f;
+    displaySettings.upscaleSharpness = 0.3f;
+    displaySettings.uiFontPath = "";
     cameraSettings.mouseSensitivity = 0.1f;
     cameraSettings.moveSpeed = 5.0f;
     cameraSettings.interactionDistance = 2.0f;
+    cameraSettings.lateLatching = true;
+    cameraSettings.relativeMouse = true;
     gameplaySettings.rotationStep = 90.0f;
     gameplaySettings.assetPath = "assets/";
+    gameplaySettings.simulationRate = 60.0f;
+    streamingSettings.catalogPath = "";
+    streamingSettings.catalogLoadRadius = 30.0f;
+    diagnosticsSettings.showProfiler = false;
+    diagnosticsSettings.profilerCsvPath = "profile.csv";
+    diagnosticsSettings.tracePath = "trace.json";
+    diagnosticsSettings.traceAtStartup = false;
+    diagnosticsSettings.hitchMonitor = true;
+    diagnosticsSettings.hitchBudgetMs = 100.0f;
+    diagnosticsSettings.hitchReportDir = "";
+    diagnosticsSettings.binaryLogPath = "";
+    diagnosticsSettings.inputRecordPath = "";
+    diagnosticsSettings.inputReplayPath = "";
+    diagnosticsSettings.replayMaxSpeed = false;
+    controlSettings.keyBindings.clear();
     
     Logger::getInstance().logInfo("Reset all settings to defaults");
 }
@@ -241,16 +614,70 @@ bool Config::loadFromFile(const std::string& filename) {
             setScreenHeight(std::stoi(value));
         } else if (key == "fullscreen") {
             setFullscreen(value == "true" || value == "1");
+        } else if (key == "targetFrameRate") {
+            setTargetFrameRate(std::stof(value));
+        } else if (key == "vsync") {
+            setVsyncEnabled(value == "true" || value == "1");
+        } else if (key == "idleThrottling") {
+            setIdleThrottling(value == "true" || value == "1");
+        } else if (key == "renderCaching") {
+            setRenderCaching(value == "true" || value == "1");
+        } else if (key == "qualityTier") {
+            setQualityTier(std::stoi(value));
+        } else if (key == "adaptiveQuality") {
+            setAdaptiveQuality(value == "true" || value == "1");
+        } else if (key == "dynamicResolution") {
+            setDynamicResolution(value == "true" || value == "1");
+        } else if (key == "minRenderScale") {
+            setMinRenderScale(std::stof(value));
+        } else if (key == "upscaleSharpness") {
+            setUpscaleSharpness(std::stof(value));
+        } else if (key == "uiFontPath") {
+            setUiFontPath(value);
         } else if (key == "mouseSensitivity") {
             setMouseSensitivity(std::stof(value));
         } else if (key == "moveSpeed") {
             setMoveSpeed(std::stof(value));
         } else if (key == "interactionDistance") {
             setInteractionDistance(std::stof(value));
+        } else if (key == "lateLatching") {
+            setLateLatching(value == "true" || value == "1");
+        } else if (key == "relativeMouse") {
+            setRelativeMouse(value == "true" || value == "1");
         } else if (key == "rotationStep") {
             setRotationStep(std::stof(value));
+        } else if (key == "simulationRate") {
+            setSimulationRate(std::stof(value));
         } else if (key == "assetPath") {
             setAssetPath(value);
+        } else if (key == "catalogPath") {
+            setCatalogPath(value);
+        } else if (key == "catalogLoadRadius") {
+            setCatalogLoadRadius(std::stof(value));
+        } else if (key == "showProfiler") {
+            setProfilerShown(value == "true" || value == "1");
+        } else if (key == "profilerCsvPath") {
+            setProfilerCsvPath(value);
+        } else if (key == "tracePath") {
+            setTracePath(value);
+        } else if (key == "traceAtStartup") {
+            setTraceAtStartup(value == "true" || value == "1");
+        } else if (key == "hitchMonitor") {
+            setHitchMonitorEnabled(value == "true" || value == "1");
+        } else if (key == "hitchBudgetMs") {
+            setHitchBudgetMs(std::stof(value));
+        } else if (key == "hitchReportDir") {
+            setHitchReportDir(value);
+        } else if (key == "binaryLogPath") {
+            setBinaryLogPath(value);
+        } else if (key == "inputRecordPath") {
+            setInputRecordPath(value);
+        } else if (key == "inputReplayPath") {
+            setInputReplayPath(value);
+        } else if (key == "replayMaxSpeed") {
+            setReplayMaxSpeed(value == "true" || value == "1");
+        } else if (key.compare(0, 5, "bind.") == 0) {
+            setKeyBinding(key.substr(5), value);
         }
     }
 
@@ -272,16 +699,52 @@ bool Config::saveToFile(const std::string& filename) {
     // Display settings
     file << "screenWidth=" << displaySettings.screenWidth << "\n";
     file << "screenHeight=" << displaySettings.screenHeight << "\n";
-    file << "fullscreen=" << (displaySettings.fullscreen ? "true" : "false") << "\n\n";
+    file << "fullscreen=" << (displaySettings.fullscreen ? "true" : "false") << "\n";
+    file << "targetFrameRate=" << displaySettings.targetFrameRate << "\n";
+    file << "vsync=" << (displaySettings.vsync ? "true" : "false") << "\n";
+    file << "idleThrottling=" << (displaySettings.idleThrottling ? "true" : "false") << "\n";
+    file << "renderCaching=" << (displaySettings.renderCaching ? "true" : "false") << "\n";
+    file << "qualityTier=" << displaySettings.qualityTier << "\n";
+    file << "adaptiveQuality=" << (displaySettings.adaptiveQuality ? "true" : "false") << "\n";
+    file << "dynamicResolution=" << (displaySettings.dynamicResolution ? "true" : "false") << "\n";
+    file << "minRenderScale=" << displaySettings.minRenderScale << "\n";
+    file << "upscaleSharpness=" << displaySettings.upscaleSharpness << "\n";
+    file << "uiFontPath=" << displaySettings.uiFontPath << "\n\n";
 
     // Camera settings
     file << "mouseSensitivity=" << cameraSettings.mouseSensitivity << "\n";
     file << "moveSpeed=" << cameraSettings.moveSpeed << "\n";
-    file << "interactionDistance=" << cameraSettings.interactionDistance << "\n\n";
+    file << "interactionDistance=" << cameraSettings.interactionDistance << "\n";
+    file << "lateLatching=" << (cameraSettings.lateLatching ? "true" : "false") << "\n";
+    file << "relativeMouse=" << (cameraSettings.relativeMouse ? "true" : "false") << "\n\n";
 
     // Gameplay settings
     file << "rotationStep=" << gameplaySettings.rotationStep << "\n";
     file << "assetPath=" << gameplaySettings.assetPath << "\n";
+    file << "simulationRate=" << gameplaySettings.simulationRate << "\n\n";
+
+    // Streaming settings
+    file << "catalogPath=" << streamingSettings.catalogPath << "\n";
+    file << "catalogLoadRadius=" << streamingSettings.catalogLoadRadius << "\n\n";
+
+    // Diagnostics settings
+    file << "showProfiler=" << (diagnosticsSettings.showProfiler ? "true" : "false") << "\n";
+    file << "profilerCsvPath=" << diagnosticsSettings.profilerCsvPath << "\n";
+    file << "tracePath=" << diagnosticsSettings.tracePath << "\n";
+    file << "traceAtStartup=" << (diagnosticsSettings.traceAtStartup ? "true" : "false") << "\n";
+    file << "hitchMonitor=" << (diagnosticsSettings.hitchMonitor ? "true" : "false") << "\n";
+    file << "hitchBudgetMs=" << diagnosticsSettings.hitchBudgetMs << "\n";
+    file << "hitchReportDir=" << diagnosticsSettings.hitchReportDir << "\n";
+    file << "binaryLogPath=" << diagnosticsSettings.binaryLogPath << "\n";
+    file << "inputRecordPath=" << diagnosticsSettings.inputRecordPath << "\n";
+    file << "inputReplayPath=" << diagnosticsSettings.inputReplayPath << "\n";
+    file << "replayMaxSpeed=" << (diagnosticsSettings.replayMaxSpeed ? "true" : "false") << "\n";
+
+    // Control settings
+    if (!controlSettings.keyBindings.empty()) file << "\n";
+    for (const auto& binding : controlSettings.keyBindings) {
+        file << "bind." << binding.first << "=" << binding.second << "\n";
+    }
 
     file.close();
     Logger::getInstance().logInfo("Config saved to file: " + filename);
@@ -1,4 +1,5 @@
 #pragma once
+#include <map>
 #include <string>
 #include "utility.h"  // Include utility.h for Logger
 
@@ -13,6 +14,16 @@ private:
         int screenWidth;
         int screenHeight;
         bool fullscreen;
+        float targetFrameRate;     // 0: uncapped
+        bool vsync;
+        bool idleThrottling;       // Stop redrawing while nothing changes
+        bool renderCaching;        // Reuse the last 3D frame while the scene is unchanged
+        int qualityTier;           // -1: pick by startup benchmark
+        bool adaptiveQuality;      // Step the tier with measured frame times
+        bool dynamicResolution;    // Scale the 3D layer per frame to hold the budget
+        float minRenderScale;      // Lowest dynamic render scale
+        float upscaleSharpness;    // 0: bilinear upscale, up to 1: strongest sharpening
+        std::string uiFontPath;    // TrueType font for UI text; empty: first system font found
     };
     
     // Camera settings struct
@@ -20,24 +31,64 @@ private:
         float mouseSensitivity;
         float moveSpeed;
         float interactionDistance;
+        bool lateLatching;         // Turn the view with the mouse motion that arrives right before rendering
+        bool relativeMouse;        // Hidden cursor kept in the window's middle, so looking never stops at an edge
     };
     
     // Gameplay settings struct
     struct GameplaySettings {
         float rotationStep;
         std::string assetPath;
+        float simulationRate;      // Fixed simulation steps per second
+    };
+    
+    // Streaming settings struct
+    struct StreamingSettings {
+        std::string catalogPath;   // Empty: no catalog paging
+        float catalogLoadRadius;
+    };
+    
+    // Diagnostics settings struct
+    struct DiagnosticsSettings {
+        bool showProfiler;         // Profiler HUD visible at startup
+        std::string profilerCsvPath;
+        std::string tracePath;     // Chrome trace output
+        bool traceAtStartup;       // Capture from before GameManager::init
+        bool hitchMonitor;         // Write a report when a frame exceeds the budget
+        float hitchBudgetMs;
+        std::string hitchReportDir;
+        std::string binaryLogPath; // Unformatted log records; empty: off
+        std::string inputRecordPath;  // Record the session's input here; empty: off
+        std::string inputReplayPath;  // Replay this recording instead of live input; empty: off
+        bool replayMaxSpeed;       // Replay as fast as frames render rather than at the recorded pace
+    };
+    
+    // Control settings struct
+    struct ControlSettings {
+        std::map<std::string, std::string> keyBindings;  // Action name -> keys; unlisted actions keep their defaults
     };
     
     // Settings structs
     DisplaySettings displaySettings;
     CameraSettings cameraSettings;
     GameplaySettings gameplaySettings;
+    StreamingSettings streamingSettings;
+    DiagnosticsSettings diagnosticsSettings;
+    ControlSettings controlSettings;
     
     // Display limits
     static const int MIN_SCREEN_WIDTH = 800;
     static const int MAX_SCREEN_WIDTH = 3840;
     static const int MIN_SCREEN_HEIGHT = 600;
     static const int MAX_SCREEN_HEIGHT = 2160;
+    static constexpr float MIN_TARGET_FRAME_RATE = 15.0f;
+    static constexpr float MAX_TARGET_FRAME_RATE = 240.0f;
+    static const int MIN_QUALITY_TIER = -1;
+    static const int MAX_QUALITY_TIER = 3;
+    static constexpr float MIN_RENDER_SCALE = 0.25f;
+    static constexpr float MAX_RENDER_SCALE = 1.0f;
+    static constexpr float MIN_UPSCALE_SHARPNESS = 0.0f;
+    static constexpr float MAX_UPSCALE_SHARPNESS = 1.0f;
     
     // Camera limits
     static constexpr float MIN_MOUSE_SENSITIVITY = 0.05f;
@@ -50,6 +101,16 @@ private:
     // Gameplay limits
     static constexpr float MIN_ROTATION_STEP = 5.0f;
     static constexpr float MAX_ROTATION_STEP = 180.0f;
+    static constexpr float MIN_SIMULATION_RATE = 10.0f;
+    static constexpr float MAX_SIMULATION_RATE = 240.0f;
+    
+    // Streaming limits
+    static constexpr float MIN_CATALOG_LOAD_RADIUS = 5.0f;
+    static constexpr float MAX_CATALOG_LOAD_RADIUS = 500.0f;
+
+    // Diagnostics limits
+    static constexpr float MIN_HITCH_BUDGET_MS = 5.0f;
+    static constexpr float MAX_HITCH_BUDGET_MS = 10000.0f;
 
     // Private constructor (singleton)
     Config();
@@ -58,10 +119,17 @@ private:
     // Limit validation methods
     int validateScreenWidth(int width) const;
     int validateScreenHeight(int height) const;
+    float validateTargetFrameRate(float rate) const;
+    int validateQualityTier(int tier) const;
+    float validateMinRenderScale(float scale) const;
+    float validateUpscaleSharpness(float sharpness) const;
     float validateMouseSensitivity(float sensitivity) const;
     float validateMoveSpeed(float speed) const;
     float validateInteractionDistance(float distance) const;
     float validateRotationStep(float step) const;
+    float validateSimulationRate(float rate) const;
+    float validateCatalogLoadRadius(float radius) const;
+    float validateHitchBudget(float milliseconds) const;
     
 public:
     // Delete copy constructor and assignment operator
@@ -81,6 +149,26 @@ public:
     void setScreenHeight(int height);
     bool isFullscreen() const;
     void setFullscreen(bool enable);
+    float getTargetFrameRate() const;
+    void setTargetFrameRate(float rate);
+    bool isVsyncEnabled() const;
+    void setVsyncEnabled(bool enable);
+    bool isIdleThrottling() const;
+    void setIdleThrottling(bool enable);
+    bool isRenderCaching() const;
+    void setRenderCaching(bool enable);
+    int getQualityTier() const;
+    void setQualityTier(int tier);
+    bool isAdaptiveQuality() const;
+    void setAdaptiveQuality(bool enable);
+    bool isDynamicResolution() const;
+    void setDynamicResolution(bool enable);
+    float getMinRenderScale() const;
+    void setMinRenderScale(float scale);
+    float getUpscaleSharpness() const;
+    void setUpscaleSharpness(float sharpness);
+    const std::string& getUiFontPath() const;
+    void setUiFontPath(const std::string& path);
 
     // Camera settings
     float getMouseSensitivity() const;
@@ -89,12 +177,53 @@ public:
     void setMoveSpeed(float speed);
     float getInteractionDistance() const;
     void setInteractionDistance(float distance);
+    bool isLateLatching() const;
+    void setLateLatching(bool enable);
+    bool isRelativeMouse() const;
+    void setRelativeMouse(bool enable);
 
     // Gameplay settings
     float getRotationStep() const;
     void setRotationStep(float step);
+    float getSimulationRate() const;
+    void setSimulationRate(float rate);
     const std::string& getAssetPath() const;
     void setAssetPath(const std::string& path);
+    
+    // Streaming settings
+    const std::string& getCatalogPath() const;
+    void setCatalogPath(const std::string& path);
+    float getCatalogLoadRadius() const;
+    void setCatalogLoadRadius(float radius);
+    
+    // Diagnostics settings
+    bool isProfilerShown() const;
+    void setProfilerShown(bool show);
+    const std::string& getProfilerCsvPath() const;
+    void setProfilerCsvPath(const std::string& path);
+    const std::string& getTracePath() const;
+    void setTracePath(const std::string& path);
+    bool isTraceAtStartup() const;
+    void setTraceAtStartup(bool enable);
+    bool isHitchMonitorEnabled() const;
+    void setHitchMonitorEnabled(bool enable);
+    float getHitchBudgetMs() const;
+    void setHitchBudgetMs(float milliseconds);
+    const std::string& getHitchReportDir() const;
+    void setHitchReportDir(const std::string& directory);
+    const std::string& getBinaryLogPath() const;
+    void setBinaryLogPath(const std::string& path);
+    const std::string& getInputRecordPath() const;
+    void setInputRecordPath(const std::string& path);
+    const std::string& getInputReplayPath() const;
+    void setInputReplayPath(const std::string& path);
+    bool isReplayMaxSpeed() const;
+    void setReplayMaxSpeed(bool enable);
+    
+    // Control settings
+    const std::map<std::string, std::string>& getKeyBindings() const;
+    // Keys ("w,W") for an action name ("moveForward"); empty: the default binding
+    void setKeyBinding(const std::string& action, const std::string& keys);
 
     
     // Configuration presets
@@ -0,0 +1,121 @@
+#include "dynamic_resolution.h"
+#include "gl_extensions.h"
+#include "trace.h"
+#include <algorithm>
+#include <cmath>
+
+// Share of the ideal scale to move towards per sample
+const float SCALE_DOWN_RATE = 0.5f;
+const float SCALE_UP_RATE = 0.1f;
+// Ignore smaller increases, so a steady scene keeps a steady size
+const float MIN_SCALE_STEP = 0.01f;
+
+DynamicResolution::DynamicResolution()
+    : enabled(true)
+    , requestedMinScale(0.5f)
+    , minScale(0.5f)
+    , maxScale(1.0f)
+    , scale(1.0f)
+    , budgetMs(12.0f)
+    , queries{}
+    , queryScale{}
+    , queryPending{}
+    , nextQuery(0)
+    , queryActive(false)
+    , gpuTiming(false)
+    , lastSceneMs(0.0f) {
+}
+
+DynamicResolution::~DynamicResolution() {
+    shutdown();
+}
+
+void DynamicResolution::init() {
+    shutdown();
+    if (!glext.timerQueries) return;
+
+    glext.genQueries(QUERY_COUNT, queries);
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        queryPending[i] = false;
+    }
+    nextQuery = 0;
+    gpuTiming = true;
+}
+
+void DynamicResolution::shutdown() {
+    if (gpuTiming) {
+        if (queryActive) {
+            glext.endQuery(GL_TIME_ELAPSED);
+            queryActive = false;
+        }
+        glext.deleteQueries(QUERY_COUNT, queries);
+        gpuTiming = false;
+    }
+}
+
+void DynamicResolution::setEnabled(bool enable) {
+    enabled = enable;
+    scale = maxScale;
+}
+
+void DynamicResolution::setScaleRange(float minimum, float maximum) {
+    requestedMinScale = minimum;
+    maxScale = std::max(0.1f, std::min(maximum, 1.0f));
+    minScale = std::max(0.1f, std::min(minimum, maxScale));
+    scale = std::max(minScale, std::min(scale, maxScale));
+}
+
+void DynamicResolution::beginScene() {
+    // Skip timing this frame if the GPU hasn't finished the oldest query yet
+    if (!gpuTiming || queryPending[nextQuery]) return;
+    glext.beginQuery(GL_TIME_ELAPSED, queries[nextQuery]);
+    queryScale[nextQuery] = getScale();
+    queryActive = true;
+}
+
+void DynamicResolution::endScene() {
+    if (!queryActive) return;
+    glext.endQuery(GL_TIME_ELAPSED);
+    queryActive = false;
+    queryPending[nextQuery] = true;
+    nextQuery = (nextQuery + 1) % QUERY_COUNT;
+}
+
+void DynamicResolution::collectTimings() {
+    if (!gpuTiming) return;
+
+    // Oldest first, stopping at the first one still in flight
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        int index = (nextQuery + i) % QUERY_COUNT;
+        if (!queryPending[index]) continue;
+
+        GLint available = 0;
+        glext.getQueryObjectiv(queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) break;
+
+        uint64_t nanoseconds = 0;
+        glext.getQueryObjectui64v(queries[index], GL_QUERY_RESULT, &nanoseconds);
+        queryPending[index] = false;
+        lastSceneMs = static_cast<float>(nanoseconds / 1.0e6);
+        adjust(lastSceneMs, queryScale[index]);
+    }
+}
+
+void DynamicResolution::addFrameSample(float workMs) {
+    if (gpuTiming) return;
+    lastSceneMs = workMs;
+    adjust(workMs, getScale());
+}
+
+void DynamicResolution::adjust(float sampleMs, float sampleScale) {
+    if (!enabled || sampleMs <= 0.0f) return;
+
+    // Fill-bound cost follows the pixel count, the square of the scale
+    float ideal = sampleScale * std::sqrt(budgetMs / sampleMs);
+    float rate = ideal < scale ? SCALE_DOWN_RATE : SCALE_UP_RATE;
+    float next = std::max(minScale, std::min(scale + (ideal - scale) * rate, maxScale));
+    if (next < scale || next - scale >= MIN_SCALE_STEP || next == maxScale) {
+        scale = next;
+    }
+    TRACE_COUNTER("Render scale %", scale * 100.0f);
+}
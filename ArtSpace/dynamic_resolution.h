@@ -0,0 +1,91 @@
+/**
+ * @file dynamic_resolution.h
+ * @brief Per-frame render scale for the 3D layer, steered by measured scene cost
+ *
+ * On fill-rate bound machines (software rasterisers, large kiosk displays)
+ * the scene's cost grows with its pixel count. DynamicResolution picks the
+ * fraction of the window resolution the scene is drawn at each frame so that
+ * its cost stays inside a time budget:
+ *
+ *    ideal scale = measured scale * sqrt(budget / measured ms)
+ *
+ * The scale moves quickly towards the ideal when over budget and slowly when
+ * under it, within [min scale, max scale]. The max scale comes from the
+ * quality tier.
+ *
+ * Scene cost is measured with GPU timer queries where available. A small ring
+ * of queries is read back a few frames later, so measuring never stalls the
+ * pipeline. Without timer queries the frame's CPU-side work time is used.
+ *
+ * Usage:
+ *    resolution.init();                   // Needs the GL context
+ *
+ *    float scale = resolution.getScale();
+ *    resolution.beginScene();
+ *    drawScene(width * scale, height * scale);
+ *    resolution.endScene();
+ *
+ *    // Once per frame:
+ *    resolution.collectTimings();
+ *    if (noGpuTiming) resolution.addFrameSample(workMs);
+ */
+
+#pragma once
+#include <GL/glut.h>
+
+class DynamicResolution {
+private:
+    static const int QUERY_COUNT = 4;
+
+    bool enabled;
+    float requestedMinScale;
+    float minScale;             // requestedMinScale, but never above maxScale
+    float maxScale;
+    float scale;
+    float budgetMs;
+
+    // Ring of GPU timer queries, each remembering the scale it measured
+    GLuint queries[QUERY_COUNT];
+    float queryScale[QUERY_COUNT];
+    bool queryPending[QUERY_COUNT];
+    int nextQuery;
+    bool queryActive;
+    bool gpuTiming;
+
+    float lastSceneMs;
+
+    void adjust(float sampleMs, float sampleScale);
+
+public:
+    DynamicResolution();
+    ~DynamicResolution();
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    // Create the timer queries when the driver has them
+    void init();
+    void shutdown();
+
+    void setEnabled(bool enable);
+    bool isEnabled() const { return enabled; }
+    void setScaleRange(float minimum, float maximum);
+    void setMaxScale(float maximum) { setScaleRange(requestedMinScale, maximum); }
+    float getMaxScale() const { return maxScale; }
+    // Time the scene may take per frame
+    void setBudgetMs(float milliseconds) { budgetMs = milliseconds; }
+
+    // Scale for the next scene render (max scale while disabled)
+    float getScale() const { return enabled ? scale : maxScale; }
+    bool hasGpuTiming() const { return gpuTiming; }
+    float getLastSceneMs() const { return lastSceneMs; }
+
+    // Bracket the scene draw calls to time them on the GPU
+    void beginScene();
+    void endScene();
+
+    // Read back finished GPU timings and adjust the scale
+    void collectTimings();
+    // CPU-side fallback: work time of a frame that drew the scene
+    void addFrameSample(float workMs);
+};
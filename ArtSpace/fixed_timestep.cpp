@@ -0,0 +1,53 @@
+#include "fixed_timestep.h"
+#include <algorithm>
+
+FixedTimestep::FixedTimestep(double rate)
+    : started(false)
+    , step(1.0 / rate)
+    , accumulator(0.0)
+    , frameSeconds(0.0)
+    , maxFrameSeconds(DEFAULT_MAX_FRAME_SECONDS)
+    , droppedSeconds(0.0) {
+}
+
+void FixedTimestep::setRate(double rate) {
+    if (rate <= 0.0) return;
+
+    // Keep the interpolation position when the rate changes mid-run
+    double alpha = accumulator / step;
+    step = 1.0 / rate;
+    accumulator = alpha * step;
+}
+
+void FixedTimestep::reset() {
+    lastTime = Clock::now();
+    started = true;
+    accumulator = 0.0;
+    frameSeconds = 0.0;
+}
+
+int FixedTimestep::advance() {
+    Clock::time_point now = Clock::now();
+    if (!started) {
+        reset();
+        return 0;
+    }
+
+    frameSeconds = std::chrono::duration<double>(now - lastTime).count();
+    lastTime = now;
+
+    // A stalled frame is not worth a burst of catch-up steps
+    double elapsed = frameSeconds;
+    if (elapsed > maxFrameSeconds) {
+        droppedSeconds += elapsed - maxFrameSeconds;
+        elapsed = maxFrameSeconds;
+    }
+
+    accumulator += elapsed;
+    int steps = static_cast<int>(accumulator / step);
+    accumulator -= steps * step;
+
+    // Guard against rounding leaving a full step behind
+    accumulator = std::max(0.0, std::min(accumulator, step));
+    return steps;
+}
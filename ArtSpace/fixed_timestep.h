@@ -0,0 +1,71 @@
+/**
+ * @file fixed_timestep.h
+ * @brief Fixed-rate simulation clock decoupled from the render rate
+ *
+ * The simulation (input, camera physics, streaming) advances in steps of a
+ * constant length, so smoothing and damping constants that are applied once
+ * per update behave the same at 30 and 240 frames per second. Each rendered
+ * frame asks the clock how many steps the elapsed real time covers, runs
+ * them, and then draws the state interpolated between the last two steps
+ * with getAlpha().
+ *
+ * Time is measured with std::chrono::steady_clock. A frame longer than the
+ * maximum frame time (a hitch, a debugger break) is clamped so the
+ * simulation does not try to catch up with a burst of steps.
+ *
+ * Usage:
+ *    FixedTimestep clock(60.0);
+ *
+ *    // Once per rendered frame:
+ *    int steps = clock.advance();
+ *    for (int i = 0; i < steps; i++) {
+ *        camera.savePreviousState();
+ *        simulate(clock.getStep());
+ *    }
+ *    camera.applyTransformation(clock.getAlpha());
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+class FixedTimestep {
+public:
+    static constexpr double DEFAULT_MAX_FRAME_SECONDS = 0.1;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    Clock::time_point lastTime;
+    bool started;
+
+    double step;            // Seconds per simulation step
+    double accumulator;     // Real time not yet simulated, always < step after advance()
+    double frameSeconds;    // Real time covered by the last advance()
+    double maxFrameSeconds; // Longer frames are clamped to this
+    double droppedSeconds;  // Time lost to clamping
+
+public:
+    explicit FixedTimestep(double rate = 60.0);
+
+    // Simulation steps per second
+    void setRate(double rate);
+    double getRate() const { return 1.0 / step; }
+    float getStep() const { return static_cast<float>(step); }
+
+    void setMaxFrameTime(double seconds) { maxFrameSeconds = seconds; }
+
+    // Restart timing from now, dropping any time not yet simulated
+    void reset();
+
+    // Measure the time since the previous call and return the number of steps to run
+    int advance();
+
+    // Position of the rendered frame between the previous step (0) and the latest one (1)
+    float getAlpha() const { return static_cast<float>(accumulator / step); }
+
+    // Real (unclamped) duration of the last frame, for UI animation
+    float getFrameSeconds() const { return static_cast<float>(frameSeconds); }
+
+    double getDroppedSeconds() const { return droppedSeconds; }
+};
@@ -0,0 +1,184 @@
+#include <GL/glut.h>
+#include "frame_scheduler.h"
+#include "profiler.h"
+#include <algorithm>
+#include <ctime>
+#include <thread>
+#ifdef _WIN32
+#include <mmsystem.h>   // timeBeginPeriod (windows.h comes in through glut.h)
+#pragma comment(lib, "winmm.lib")
+#endif
+
+// Bounds for the stretch before a frame that is spun rather than slept
+static const std::chrono::microseconds MIN_SPIN_MARGIN(100);
+static const std::chrono::microseconds MAX_SPIN_MARGIN(4000);
+
+FrameScheduler FrameScheduler::instance;
+
+FrameScheduler::FrameScheduler()
+    : targetFps(60.0f)
+    , vsyncRequested(true)
+    , vsyncActive(false)
+    , idleThrottling(true)
+    , idleDelay(0.5f)
+    , idlePoll(0.01f)
+    , spinMargin(std::chrono::microseconds(1000))
+    , redrawRequested(true)
+    , animating(false)
+    , idle(false)
+    , initialized(false)
+    , timerResolutionRaised(false)
+    , cpuWindowStartWall(0.0)
+    , cpuWindowStartCpu(0.0)
+    , cpuUsage(0.0f) {
+}
+
+FrameScheduler& FrameScheduler::getInstance() {
+    return instance;
+}
+
+void FrameScheduler::init() {
+#ifdef _WIN32
+    // The default 15.6 ms timer tick makes sleep_for useless for pacing
+    timerResolutionRaised = (timeBeginPeriod(1) == TIMERR_NOERROR);
+#endif
+    initialized = true;
+    applyVsync();
+
+    nextFrame = Clock::now();
+    lastActivity = nextFrame;
+    cpuWindowStartWall = std::chrono::duration<double>(nextFrame.time_since_epoch()).count();
+    cpuWindowStartCpu = getProcessCpuSeconds();
+}
+
+void FrameScheduler::shutdown() {
+#ifdef _WIN32
+    if (timerResolutionRaised) {
+        timeEndPeriod(1);
+        timerResolutionRaised = false;
+    }
+#endif
+}
+
+void FrameScheduler::setTargetFps(float fps) {
+    targetFps = std::max(0.0f, fps);
+}
+
+void FrameScheduler::setVsync(bool enable) {
+    vsyncRequested = enable;
+    if (initialized) {
+        applyVsync();
+    }
+}
+
+void FrameScheduler::applyVsync() {
+    vsyncActive = false;
+#ifdef _WIN32
+    typedef BOOL(WINAPI* SwapIntervalProc)(int interval);
+    SwapIntervalProc swapInterval = reinterpret_cast<SwapIntervalProc>(wglGetProcAddress("wglSwapIntervalEXT"));
+    if (!swapInterval) {
+        Logger::getInstance().logWarning("FrameScheduler - vsync control not available, pacing with sleeps only");
+        return;
+    }
+    vsyncActive = swapInterval(vsyncRequested ? 1 : 0) && vsyncRequested;
+#endif
+}
+
+bool FrameScheduler::waitForFrame() {
+    updateCpuUsage();
+
+    Clock::time_point now = Clock::now();
+    if (redrawRequested.exchange(false, std::memory_order_relaxed) || animating || !idleThrottling) {
+        lastActivity = now;
+    }
+
+    // Nothing has changed for a while: draw nothing and give the core back
+    if (idleThrottling && std::chrono::duration<float>(now - lastActivity).count() > idleDelay) {
+        idle = true;
+        std::this_thread::sleep_for(std::chrono::duration<float>(idlePoll));
+        return false;
+    }
+
+    if (idle) {
+        idle = false;
+        nextFrame = now;
+
+        // The idle wait is not frame time
+        Profiler::getInstance().restartFrame();
+        if (onResume) {
+            onResume();
+        }
+    }
+
+    if (targetFps > 0.0f) {
+        sleepUntil(nextFrame);
+
+        // After a long frame, restart the cadence rather than rush to catch up
+        now = Clock::now();
+        nextFrame += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+        if (nextFrame < now) {
+            nextFrame = now;
+        }
+    }
+    frameStart = Clock::now();
+    return true;
+}
+
+float FrameScheduler::getWorkMs() const {
+    return std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+}
+
+void FrameScheduler::sleepUntil(Clock::time_point deadline) {
+    for (;;) {
+        Clock::duration remaining = deadline - Clock::now();
+        if (remaining <= Clock::duration::zero()) return;
+
+        if (remaining > spinMargin) {
+            Clock::duration requested = remaining - spinMargin;
+            Clock::time_point sleepStart = Clock::now();
+            std::this_thread::sleep_for(requested);
+
+            // Spin only as long as sleeps actually overshoot: widen at once, narrow slowly
+            Clock::duration overshoot = (Clock::now() - sleepStart) - requested;
+            if (overshoot > spinMargin) {
+                spinMargin = std::min<Clock::duration>(overshoot, MAX_SPIN_MARGIN);
+            }
+            else {
+                spinMargin -= (spinMargin - overshoot) / 16;
+                spinMargin = std::max<Clock::duration>(spinMargin, MIN_SPIN_MARGIN);
+            }
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void FrameScheduler::updateCpuUsage() {
+    double wall = std::chrono::duration<double>(Clock::now().time_since_epoch()).count();
+    double elapsed = wall - cpuWindowStartWall;
+    if (elapsed < 1.0) return;
+
+    double cpu = getProcessCpuSeconds();
+    cpuUsage = static_cast<float>(100.0 * (cpu - cpuWindowStartCpu) / elapsed);
+    cpuWindowStartWall = wall;
+    cpuWindowStartCpu = cpu;
+}
+
+double FrameScheduler::getProcessCpuSeconds() {
+#ifdef _WIN32
+    // clock() is wall time on Windows
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        return 0.0;
+    }
+    ULARGE_INTEGER kernel, user;
+    kernel.LowPart = kernelTime.dwLowDateTime;
+    kernel.HighPart = kernelTime.dwHighDateTime;
+    user.LowPart = userTime.dwLowDateTime;
+    user.HighPart = userTime.dwHighDateTime;
+    return (kernel.QuadPart + user.QuadPart) * 1e-7;  // 100 ns units
+#else
+    return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+#endif
+}
@@ -0,0 +1,109 @@
+/**
+ * @file frame_scheduler.h
+ * @brief Frame pacing for the GLUT idle loop, with an on-demand mode for idle kiosks
+ *
+ * GLUT calls the idle callback as fast as it can. Without pacing the
+ * application redraws continuously at 100% of a core. The FrameScheduler
+ * decides, once per idle call, whether a frame should be drawn:
+ * - Active: frames are paced to the target frame rate by sleeping until the
+ *   next frame is due. The last stretch is spun, because OS sleeps overshoot
+ *   by up to a timer tick. Vsync is requested when the driver supports it.
+ * - Idle: once nothing has animated and no input has arrived for a short
+ *   delay, no frames are drawn. Each idle call sleeps briefly and returns,
+ *   until requestRedraw() or setAnimating(true) wakes the scheduler.
+ *
+ * It also measures the process CPU usage, so the effect can be checked on
+ * the target hardware.
+ *
+ * Usage:
+ *    FrameScheduler::getInstance().init();          // After glutCreateWindow
+ *
+ *    void idle() {
+ *        if (!FrameScheduler::getInstance().waitForFrame()) return;
+ *        update();
+ *        glutPostRedisplay();
+ *    }
+ *
+ *    // Input callbacks:
+ *    FrameScheduler::getInstance().requestRedraw();
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <functional>
+
+class FrameScheduler {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static FrameScheduler instance;
+
+    float targetFps;            // 0: uncapped (vsync only)
+    bool vsyncRequested;
+    bool vsyncActive;
+    bool idleThrottling;        // Stop drawing while nothing changes
+    float idleDelay;            // Seconds without activity before going idle
+    float idlePoll;             // Sleep per idle callback while idle
+
+    Clock::time_point nextFrame;
+    Clock::duration spinMargin;         // Tracks how late sleeps wake up
+    Clock::time_point lastActivity;
+    Clock::time_point frameStart;       // When waitForFrame last let a frame through
+    std::atomic<bool> redrawRequested;  // Set from input callbacks (or other threads)
+    bool animating;
+    bool idle;
+    bool initialized;
+    bool timerResolutionRaised;
+
+    // Called when frames resume after an idle period
+    std::function<void()> onResume;
+
+    // CPU usage over the last measurement window
+    double cpuWindowStartWall;
+    double cpuWindowStartCpu;
+    float cpuUsage;
+
+    FrameScheduler();
+
+    void applyVsync();
+    void sleepUntil(Clock::time_point deadline);
+    void updateCpuUsage();
+    static double getProcessCpuSeconds();
+
+public:
+    FrameScheduler(const FrameScheduler&) = delete;
+    FrameScheduler& operator=(const FrameScheduler&) = delete;
+
+    static FrameScheduler& getInstance();
+
+    // Needs the GL context (vsync); call after glutCreateWindow
+    void init();
+    void shutdown();
+
+    // Pace to the next frame; false while idle (nothing to draw this call)
+    bool waitForFrame();
+
+    // Something changed that must be shown (thread-safe)
+    void requestRedraw() { redrawRequested.store(true, std::memory_order_relaxed); }
+
+    // Whether the scene animates on its own (moving camera, live HUD...)
+    void setAnimating(bool isAnimating) { animating = isAnimating; }
+
+    void setOnResume(std::function<void()> callback) { onResume = callback; }
+
+    // Settings
+    void setTargetFps(float fps);
+    float getTargetFps() const { return targetFps; }
+    void setVsync(bool enable);
+    bool isVsyncActive() const { return vsyncActive; }
+    void setIdleThrottling(bool enable) { idleThrottling = enable; }
+    bool isIdleThrottling() const { return idleThrottling; }
+
+    // State
+    bool isIdle() const { return idle; }
+    // Process CPU time over wall time, in percent of one core
+    float getCpuUsage() const { return cpuUsage; }
+    // Milliseconds since the current frame was let through (excludes the pacing wait)
+    float getWorkMs() const;
+};
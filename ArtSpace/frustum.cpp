@@ -0,0 +1,219 @@
+#include "frustum.h"
+#include <GL/glut.h>
+#include <cmath>
+#include <cstring>
+
+// Maximum number of vertices a polygon can have after near-plane clipping
+static const int MAX_CLIPPED_VERTICES = 16;
+
+// ScreenRect implementation
+void ScreenRect::intersect(const ScreenRect& other) {
+    if (other.minX > minX) minX = other.minX;
+    if (other.minY > minY) minY = other.minY;
+    if (other.maxX < maxX) maxX = other.maxX;
+    if (other.maxY < maxY) maxY = other.maxY;
+}
+
+void ScreenRect::expand(const ScreenRect& other) {
+    if (other.isEmpty()) return;
+    if (isEmpty()) {
+        *this = other;
+        return;
+    }
+    if (other.minX < minX) minX = other.minX;
+    if (other.minY < minY) minY = other.minY;
+    if (other.maxX > maxX) maxX = other.maxX;
+    if (other.maxY > maxY) maxY = other.maxY;
+}
+
+void ScreenRect::expand(float x, float y) {
+    if (minX > maxX) {
+        minX = maxX = x;
+        minY = maxY = y;
+        return;
+    }
+    if (x < minX) minX = x;
+    if (y < minY) minY = y;
+    if (x > maxX) maxX = x;
+    if (y > maxY) maxY = y;
+}
+
+// ViewFrustum implementation
+ViewFrustum::ViewFrustum() {
+    // Start with identity matrices
+    float identity[16] = {
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        0, 0, 1, 0,
+        0, 0, 0, 1
+    };
+    setMatrices(identity, identity);
+}
+
+void ViewFrustum::captureFromGL() {
+    glGetFloatv(GL_MODELVIEW_MATRIX, modelview);
+    glGetFloatv(GL_PROJECTION_MATRIX, projection);
+    updateDerived();
+}
+
+void ViewFrustum::setMatrices(const float modelviewMatrix[16], const float projectionMatrix[16]) {
+    memcpy(modelview, modelviewMatrix, sizeof(modelview));
+    memcpy(projection, projectionMatrix, sizeof(projection));
+    updateDerived();
+}
+
+void ViewFrustum::updateDerived() {
+    // viewProjection = projection * modelview (column-major)
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += projection[k * 4 + row] * modelview[col * 4 + k];
+            }
+            viewProjection[col * 4 + row] = sum;
+        }
+    }
+
+    // Extract clip planes (Gribb/Hartmann). Row i of the matrix is m[i], m[4+i], m[8+i], m[12+i].
+    const float* m = viewProjection;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            float rowI = m[j * 4 + i];
+            float row3 = m[j * 4 + 3];
+            planes[i * 2][j] = row3 + rowI;     // left, bottom, near
+            planes[i * 2 + 1][j] = row3 - rowI; // right, top, far
+        }
+    }
+
+    // Normalize planes so sphere tests can use the distance directly
+    for (int p = 0; p < 6; p++) {
+        float length = std::sqrt(planes[p][0] * planes[p][0] +
+            planes[p][1] * planes[p][1] +
+            planes[p][2] * planes[p][2]);
+        if (length > 0.0f) {
+            for (int j = 0; j < 4; j++) {
+                planes[p][j] /= length;
+            }
+        }
+    }
+}
+
+void ViewFrustum::toClip(const float point[3], float clip[4]) const {
+    const float* m = viewProjection;
+    for (int row = 0; row < 4; row++) {
+        clip[row] = m[row] * point[0] + m[4 + row] * point[1] + m[8 + row] * point[2] + m[12 + row];
+    }
+}
+
+bool ViewFrustum::isSphereVisible(const float center[3], float radius) const {
+    for (int p = 0; p < 6; p++) {
+        float distance = planes[p][0] * center[0] + planes[p][1] * center[1] +
+            planes[p][2] * center[2] + planes[p][3];
+        if (distance < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ViewFrustum::isPointVisible(const float point[3]) const {
+    return isSphereVisible(point, 0.0f);
+}
+
+bool ViewFrustum::projectPoint(const float point[3], float ndc[3]) const {
+    float clip[4];
+    toClip(point, clip);
+    if (clip[2] < -clip[3] || clip[3] <= 0.0f) {
+        return false;
+    }
+    ndc[0] = clip[0] / clip[3];
+    ndc[1] = clip[1] / clip[3];
+    ndc[2] = clip[2] / clip[3];
+    return true;
+}
+
+bool ViewFrustum::projectPolygon(const float* points, int count, ScreenRect& outRect) const {
+    if (count < 3 || count > MAX_CLIPPED_VERTICES - 2) {
+        return false;
+    }
+
+    // Transform to clip space
+    float input[MAX_CLIPPED_VERTICES][4];
+    for (int i = 0; i < count; i++) {
+        toClip(points + i * 3, input[i]);
+    }
+
+    // Sutherland-Hodgman against the near plane (z + w >= 0)
+    float output[MAX_CLIPPED_VERTICES][4];
+    int outCount = 0;
+    for (int i = 0; i < count; i++) {
+        const float* current = input[i];
+        const float* next = input[(i + 1) % count];
+        float dCurrent = current[2] + current[3];
+        float dNext = next[2] + next[3];
+
+        if (dCurrent >= 0.0f) {
+            memcpy(output[outCount++], current, sizeof(float) * 4);
+        }
+        if ((dCurrent >= 0.0f) != (dNext >= 0.0f)) {
+            float t = dCurrent / (dCurrent - dNext);
+            for (int j = 0; j < 4; j++) {
+                output[outCount][j] = current[j] + (next[j] - current[j]) * t;
+            }
+            outCount++;
+        }
+    }
+
+    if (outCount < 3) {
+        return false;
+    }
+
+    // Bounds of the clipped polygon in NDC
+    outRect = ScreenRect::empty();
+    for (int i = 0; i < outCount; i++) {
+        float w = output[i][3];
+        if (w <= 1e-6f) {
+            // Vertex sits on the eye plane: the polygon spans the whole view
+            outRect = ScreenRect::full();
+            return true;
+        }
+        outRect.expand(output[i][0] / w, output[i][1] / w);
+    }
+    return true;
+}
+
+bool ViewFrustum::projectSphere(const float center[3], float radius, ScreenRect& outRect, float& outMinDepth) const {
+    if (!isSphereVisible(center, radius)) {
+        return false;
+    }
+
+    outRect = ScreenRect::empty();
+    outMinDepth = 1.0f;
+
+    // Project the corners of the sphere's bounding box
+    for (int i = 0; i < 8; i++) {
+        float corner[3] = {
+            center[0] + ((i & 1) ? radius : -radius),
+            center[1] + ((i & 2) ? radius : -radius),
+            center[2] + ((i & 4) ? radius : -radius)
+        };
+
+        float ndc[3];
+        if (!projectPoint(corner, ndc)) {
+            // Box crosses the near plane: assume it covers the screen at the nearest depth
+            outRect = ScreenRect::full();
+            outMinDepth = -1.0f;
+            return true;
+        }
+
+        outRect.expand(ndc[0], ndc[1]);
+        if (ndc[2] < outMinDepth) outMinDepth = ndc[2];
+    }
+    return true;
+}
+
+float ViewFrustum::viewDepth(const float point[3]) const {
+    // Camera looks down -Z, so depth is the negated eye-space z
+    float eyeZ = modelview[2] * point[0] + modelview[6] * point[1] + modelview[10] * point[2] + modelview[14];
+    return -eyeZ;
+}
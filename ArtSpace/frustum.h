@@ -0,0 +1,91 @@
+/**
+ * @file frustum.h
+ * @brief View frustum and screen-space projection helpers for visibility culling
+ *
+ * ViewFrustum captures the current OpenGL modelview and projection matrices (or
+ * takes them explicitly) and answers the questions culling code needs:
+ * - Is a bounding sphere inside the frustum?
+ * - Where does a world-space polygon (e.g. a door portal) land on screen?
+ * - Which screen rectangle and nearest depth does a bounding sphere cover?
+ *
+ * Screen positions are reported in normalized device coordinates ([-1, 1] on
+ * both axes, depth in [-1, 1] with -1 at the near plane), so they are
+ * independent of the window size.
+ *
+ * Usage:
+ *    camera->applyTransformation();
+ *    ViewFrustum frustum;
+ *    frustum.captureFromGL();
+ *
+ *    ScreenRect rect;
+ *    if (frustum.projectPolygon(portalCorners, 4, rect)) {
+ *        rect.intersect(parentClip);
+ *    }
+ */
+
+#pragma once
+
+// Axis-aligned rectangle in normalized device coordinates
+struct ScreenRect {
+    float minX, minY, maxX, maxY;
+
+    ScreenRect() : minX(-1.0f), minY(-1.0f), maxX(1.0f), maxY(1.0f) {}
+    ScreenRect(float x0, float y0, float x1, float y1) : minX(x0), minY(y0), maxX(x1), maxY(y1) {}
+
+    // Full screen rectangle
+    static ScreenRect full() { return ScreenRect(-1.0f, -1.0f, 1.0f, 1.0f); }
+
+    // Empty rectangle that any expand() call will grow from
+    static ScreenRect empty() { return ScreenRect(1.0f, 1.0f, -1.0f, -1.0f); }
+
+    bool isEmpty() const { return minX >= maxX || minY >= maxY; }
+    bool overlaps(const ScreenRect& other) const {
+        return minX < other.maxX && maxX > other.minX && minY < other.maxY && maxY > other.minY;
+    }
+
+    void intersect(const ScreenRect& other);
+    void expand(const ScreenRect& other);
+    void expand(float x, float y);
+};
+
+class ViewFrustum {
+private:
+    float modelview[16];      // Column-major, as returned by glGetFloatv
+    float projection[16];
+    float viewProjection[16]; // projection * modelview
+    float planes[6][4];       // left, right, bottom, top, near, far (a, b, c, d)
+
+    void updateDerived();
+
+    // Transform a world-space point into clip space
+    void toClip(const float point[3], float clip[4]) const;
+
+public:
+    ViewFrustum();
+
+    // Read the current GL_MODELVIEW and GL_PROJECTION matrices
+    void captureFromGL();
+
+    // Use explicit column-major matrices
+    void setMatrices(const float modelviewMatrix[16], const float projectionMatrix[16]);
+
+    // Frustum tests
+    bool isSphereVisible(const float center[3], float radius) const;
+    bool isPointVisible(const float point[3]) const;
+
+    // Project a world-space point to NDC. Returns false if the point is behind the near plane.
+    bool projectPoint(const float point[3], float ndc[3]) const;
+
+    // Project a convex world-space polygon (count points, xyz packed) after clipping it
+    // against the near plane. Returns false if nothing of the polygon is in front of the camera.
+    bool projectPolygon(const float* points, int count, ScreenRect& outRect) const;
+
+    // Conservative screen rectangle and nearest NDC depth of a bounding sphere.
+    // Returns false if the sphere is outside the frustum.
+    bool projectSphere(const float center[3], float radius, ScreenRect& outRect, float& outMinDepth) const;
+
+    // Camera-space depth (distance along the view direction) of a world point
+    float viewDepth(const float point[3]) const;
+
+    const float* getViewProjection() const { return viewProjection; }
+};
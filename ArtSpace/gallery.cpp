@@ -0,0 +1,428 @@
+#include "gallery.h"
+#include "camera.h"
+#include "utility.h"
+#include "profiler.h"
+#include <cmath>
+#include <algorithm>
+
+// Tolerance used to decide that two walls share a plane
+const float WALL_PLANE_EPSILON = 0.01f;
+
+// Collision margins, matching the single-room clamping they replace
+const float WALL_OFFSET = 0.2f;
+const float FLOOR_OFFSET = 0.1f;
+const float EYE_HEIGHT = 1.7f;
+
+// Distance from a portal plane at which the camera counts as standing in the doorway
+const float PORTAL_NEAR_DISTANCE = 0.3f;
+
+Gallery::Gallery()
+    : currentRoom(-1)
+    , maxPortalDepth(8)
+    , artworkDrawDistance(0.0f)
+    , cameraPosition{ 0.0f, 0.0f, 0.0f }
+    , occlusionEnabled(true)
+    , roomsRendered(0)
+    , artworksRendered(0)
+    , artworksCulled(0)
+    , artworksOccluded(0) {
+}
+
+Gallery::~Gallery() {
+    for (GalleryRoom& entry : rooms) {
+        delete entry.room;
+    }
+    rooms.clear();
+}
+
+int Gallery::addRoom(Room* room) {
+    if (!room) return -1;
+
+    GalleryRoom entry;
+    entry.room = room;
+    rooms.push_back(entry);
+    return static_cast<int>(rooms.size()) - 1;
+}
+
+Room* Gallery::getRoom(int index) const {
+    if (index >= 0 && index < static_cast<int>(rooms.size())) {
+        return rooms[index].room;
+    }
+    return nullptr;
+}
+
+bool Gallery::connectRooms(int roomA, int roomB, float doorWidth, float doorHeight) {
+    Room* a = getRoom(roomA);
+    Room* b = getRoom(roomB);
+    if (!a || !b || a == b) return false;
+
+    const float* posA = a->getPosition();
+    const float* posB = b->getPosition();
+    const float* dimA = a->getDimensions();
+    float widthA = dimA[0], heightA = dimA[1], depthA = dimA[2];
+    const float* dimB = b->getDimensions();
+    float widthB = dimB[0], heightB = dimB[1], depthB = dimB[2];
+
+    // Find the wall pair that lies on a common plane
+    RoomWall wallA, wallB;
+    float overlapMin, overlapMax;
+    if (std::fabs((posA[0] + widthA / 2) - (posB[0] - widthB / 2)) < WALL_PLANE_EPSILON) {
+        wallA = WALL_RIGHT; wallB = WALL_LEFT;
+    }
+    else if (std::fabs((posA[0] - widthA / 2) - (posB[0] + widthB / 2)) < WALL_PLANE_EPSILON) {
+        wallA = WALL_LEFT; wallB = WALL_RIGHT;
+    }
+    else if (std::fabs((posA[2] - depthA / 2) - (posB[2] + depthB / 2)) < WALL_PLANE_EPSILON) {
+        wallA = WALL_BACK; wallB = WALL_FRONT;
+    }
+    else if (std::fabs((posA[2] + depthA / 2) - (posB[2] - depthB / 2)) < WALL_PLANE_EPSILON) {
+        wallA = WALL_FRONT; wallB = WALL_BACK;
+    }
+    else {
+        Logger::getInstance().logWarning("Gallery::connectRooms - rooms " + std::to_string(roomA) +
+            " and " + std::to_string(roomB) + " do not share a wall");
+        return false;
+    }
+
+    // Overlap of the two walls along their common axis
+    bool alongX = (wallA == WALL_BACK || wallA == WALL_FRONT);
+    int axis = alongX ? 0 : 2;
+    float halfA = (alongX ? widthA : depthA) / 2;
+    float halfB = (alongX ? widthB : depthB) / 2;
+    overlapMin = std::max(posA[axis] - halfA, posB[axis] - halfB);
+    overlapMax = std::min(posA[axis] + halfA, posB[axis] + halfB);
+    if (overlapMax - overlapMin < doorWidth) {
+        Logger::getInstance().logWarning("Gallery::connectRooms - shared wall too short for door");
+        return false;
+    }
+
+    // Door centered on the shared stretch of wall
+    float center = (overlapMin + overlapMax) / 2;
+    float height = std::min(doorHeight, std::min(heightA, heightB));
+    int doorA = a->addDoor(wallA, center - posA[axis], doorWidth, height);
+    int doorB = b->addDoor(wallB, center - posB[axis], doorWidth, height);
+
+    // One portal per direction
+    Portal portalAB;
+    portalAB.fromRoom = roomA;
+    portalAB.toRoom = roomB;
+    portalAB.doorIndex = doorA;
+    a->getDoorCorners(doorA, portalAB.corners);
+
+    Portal portalBA;
+    portalBA.fromRoom = roomB;
+    portalBA.toRoom = roomA;
+    portalBA.doorIndex = doorB;
+    b->getDoorCorners(doorB, portalBA.corners);
+
+    // Normals point back into the room the portal leaves
+    for (int i = 0; i < 3; i++) {
+        portalAB.normal[i] = 0.0f;
+        portalBA.normal[i] = 0.0f;
+    }
+    float sign = (wallA == WALL_RIGHT || wallA == WALL_FRONT) ? -1.0f : 1.0f;
+    portalAB.normal[axis == 0 ? 2 : 0] = sign;
+    portalBA.normal[axis == 0 ? 2 : 0] = -sign;
+
+    portals.push_back(portalAB);
+    rooms[roomA].portals.push_back(static_cast<int>(portals.size()) - 1);
+    portals.push_back(portalBA);
+    rooms[roomB].portals.push_back(static_cast<int>(portals.size()) - 1);
+
+    roomClip.resize(rooms.size());
+    roomVisible.resize(rooms.size());
+    return true;
+}
+
+void Gallery::assignArtwork(int roomIndex, ArtworkHandle handle) {
+    if (roomIndex >= 0 && roomIndex < static_cast<int>(rooms.size())) {
+        rooms[roomIndex].artworks.push_back(handle);
+    }
+}
+
+void Gallery::assignArtworks(ArtworkManager* manager) {
+    if (!manager || rooms.empty()) return;
+
+    for (GalleryRoom& entry : rooms) {
+        entry.artworks.clear();
+    }
+
+    for (size_t i = 0; i < manager->getArtworkCount(); i++) {
+        addArtwork(manager, manager->getHandle(static_cast<int>(i)));
+    }
+}
+
+void Gallery::addArtwork(ArtworkManager* manager, ArtworkHandle handle) {
+    Artwork* artwork = manager ? manager->getArtwork(handle) : nullptr;
+    if (!artwork || rooms.empty()) return;
+
+    float pos[3];
+    artwork->getWorldPosition(pos);
+
+    // Artworks hang on walls, so fall back to the nearest room center
+    int roomIndex = findRoom(pos[0], pos[1], pos[2]);
+    if (roomIndex < 0) {
+        float bestDistance = 1e30f;
+        for (size_t r = 0; r < rooms.size(); r++) {
+            const float* c = rooms[r].room->getPosition();
+            float dx = pos[0] - c[0], dy = pos[1] - c[1], dz = pos[2] - c[2];
+            float distance = dx * dx + dy * dy + dz * dz;
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                roomIndex = static_cast<int>(r);
+            }
+        }
+    }
+    assignArtwork(roomIndex, handle);
+}
+
+int Gallery::findRoom(float x, float /*y*/, float z) const {
+    for (size_t i = 0; i < rooms.size(); i++) {
+        const float* c = rooms[i].room->getPosition();
+        // Height is ignored so head bob or a high camera never loses its room
+        if (rooms[i].room->contains(x, c[1], z)) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+bool Gallery::isInDoorSpan(const Room* room, RoomWall wall, const float pos[3], float margin) const {
+    const float* c = room->getPosition();
+    float t = (wall == WALL_BACK || wall == WALL_FRONT) ? pos[0] - c[0] : pos[2] - c[2];
+    for (const RoomDoor& door : room->getDoors()) {
+        if (door.wall == wall &&
+            t >= door.offset - door.width / 2 + margin &&
+            t <= door.offset + door.width / 2 - margin) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Gallery::constrainCamera(HumanCamera* camera) {
+    if (!camera || rooms.empty()) return;
+
+    float pos[3];
+    camera->getPosition(pos);
+
+    if (currentRoom < 0) {
+        currentRoom = std::max(0, findRoom(pos[0], pos[1], pos[2]));
+    }
+
+    // Walked through a door into a neighbouring room?
+    Room* room = rooms[currentRoom].room;
+    if (!room->contains(pos[0], room->getPosition()[1], pos[2])) {
+        for (int portalIndex : rooms[currentRoom].portals) {
+            const Portal& portal = portals[portalIndex];
+            Room* next = rooms[portal.toRoom].room;
+            const RoomDoor& door = room->getDoors()[portal.doorIndex];
+            if (next->contains(pos[0], next->getPosition()[1], pos[2]) &&
+                isInDoorSpan(room, door.wall, pos, 0.0f)) {
+                currentRoom = portal.toRoom;
+                room = next;
+                break;
+            }
+        }
+    }
+
+    // Constrain to the current room, except through door openings
+    const float* c = room->getPosition();
+    const float* dimensions = room->getDimensions();
+    float roomWidth = dimensions[0];
+    float roomHeight = dimensions[1];
+    float roomDepth = dimensions[2];
+
+    if (pos[0] < c[0] - roomWidth / 2 + WALL_OFFSET && !isInDoorSpan(room, WALL_LEFT, pos, WALL_OFFSET))
+        pos[0] = c[0] - roomWidth / 2 + WALL_OFFSET;
+    if (pos[0] > c[0] + roomWidth / 2 - WALL_OFFSET && !isInDoorSpan(room, WALL_RIGHT, pos, WALL_OFFSET))
+        pos[0] = c[0] + roomWidth / 2 - WALL_OFFSET;
+    if (pos[2] < c[2] - roomDepth / 2 + WALL_OFFSET && !isInDoorSpan(room, WALL_BACK, pos, WALL_OFFSET))
+        pos[2] = c[2] - roomDepth / 2 + WALL_OFFSET;
+    if (pos[2] > c[2] + roomDepth / 2 - WALL_OFFSET && !isInDoorSpan(room, WALL_FRONT, pos, WALL_OFFSET))
+        pos[2] = c[2] + roomDepth / 2 - WALL_OFFSET;
+    if (pos[1] < c[1] - roomHeight / 2 + EYE_HEIGHT + FLOOR_OFFSET)
+        pos[1] = c[1] - roomHeight / 2 + EYE_HEIGHT + FLOOR_OFFSET;
+
+    // Partitions block the camera like walls do
+    room->pushOutOfPartitions(pos, WALL_OFFSET);
+
+    camera->setPosition(pos[0], pos[1], pos[2]);
+}
+
+// Nearest point of the bounding sphere is past the draw distance
+bool Gallery::isBeyondDrawDistance(const float center[3], float radius) const {
+    float dx = center[0] - cameraPosition[0];
+    float dy = center[1] - cameraPosition[1];
+    float dz = center[2] - cameraPosition[2];
+    float limit = artworkDrawDistance + radius;
+    return dx * dx + dy * dy + dz * dz > limit * limit;
+}
+
+bool Gallery::isCameraInPortal(const Portal& portal) const {
+    // Distance from the door plane
+    float dx = cameraPosition[0] - portal.corners[0];
+    float dy = cameraPosition[1] - portal.corners[1];
+    float dz = cameraPosition[2] - portal.corners[2];
+    float distance = dx * portal.normal[0] + dy * portal.normal[1] + dz * portal.normal[2];
+    if (std::fabs(distance) > PORTAL_NEAR_DISTANCE) return false;
+
+    // Within the door rectangle (corners 0 and 2 are opposite)
+    for (int axis = 0; axis < 3; axis++) {
+        float lo = std::min(portal.corners[axis], portal.corners[6 + axis]);
+        float hi = std::max(portal.corners[axis], portal.corners[6 + axis]);
+        if (portal.normal[axis] == 0.0f && (cameraPosition[axis] < lo || cameraPosition[axis] > hi)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Gallery::collectVisibleRooms(int roomIndex, const ScreenRect& clip, int depth) {
+    roomVisible[roomIndex] = 1;
+    roomClip[roomIndex].expand(clip);
+
+    if (depth >= maxPortalDepth) return;
+
+    portalPath.push_back(roomIndex);
+    for (int portalIndex : rooms[roomIndex].portals) {
+        const Portal& portal = portals[portalIndex];
+
+        // Never walk back along the current path
+        if (std::find(portalPath.begin(), portalPath.end(), portal.toRoom) != portalPath.end()) {
+            continue;
+        }
+
+        ScreenRect portalRect;
+        if (isCameraInPortal(portal)) {
+            // Standing in the doorway: the portal fills the view
+            portalRect = clip;
+        }
+        else {
+            // Portal must face the camera from the room we are looking out of
+            float dx = cameraPosition[0] - portal.corners[0];
+            float dy = cameraPosition[1] - portal.corners[1];
+            float dz = cameraPosition[2] - portal.corners[2];
+            if (dx * portal.normal[0] + dy * portal.normal[1] + dz * portal.normal[2] <= 0.0f) {
+                continue;
+            }
+
+            if (!frustum.projectPolygon(portal.corners, 4, portalRect)) {
+                continue;
+            }
+            portalRect.intersect(clip);
+        }
+
+        if (!portalRect.isEmpty()) {
+            collectVisibleRooms(portal.toRoom, portalRect, depth + 1);
+        }
+    }
+    portalPath.pop_back();
+}
+
+void Gallery::renderRoom(int roomIndex, ArtworkManager* manager, bool scissor, const int viewport[4]) {
+    const ScreenRect& clip = roomClip[roomIndex];
+
+    if (scissor) {
+        // Restrict drawing to the part of the screen the room is seen through
+        int x0 = viewport[0] + static_cast<int>(std::floor((clip.minX * 0.5f + 0.5f) * viewport[2]));
+        int y0 = viewport[1] + static_cast<int>(std::floor((clip.minY * 0.5f + 0.5f) * viewport[3]));
+        int x1 = viewport[0] + static_cast<int>(std::ceil((clip.maxX * 0.5f + 0.5f) * viewport[2]));
+        int y1 = viewport[1] + static_cast<int>(std::ceil((clip.maxY * 0.5f + 0.5f) * viewport[3]));
+        glEnable(GL_SCISSOR_TEST);
+        glScissor(x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0));
+    }
+
+    {
+        PROFILE_SCOPE("Room render");
+        rooms[roomIndex].room->render();
+        roomsRendered++;
+    }
+
+    PROFILE_SCOPE("Artwork render");
+    std::vector<ArtworkHandle>& handles = rooms[roomIndex].artworks;
+    for (size_t i = 0; i < handles.size();) {
+        Artwork* artwork = manager->getArtwork(handles[i]);
+        if (!artwork) {
+            // Artwork was removed from the manager: drop the stale handle
+            handles[i] = handles.back();
+            handles.pop_back();
+            continue;
+        }
+
+        float center[3];
+        float radius;
+        artwork->getBoundingSphere(center, radius);
+
+        ScreenRect bounds;
+        float nearestDepth;
+        if (artworkDrawDistance > 0.0f && isBeyondDrawDistance(center, radius)) {
+            artworksCulled++;
+        }
+        else if (!frustum.projectSphere(center, radius, bounds, nearestDepth) || !bounds.overlaps(clip)) {
+            artworksCulled++;
+        }
+        else if (occlusionEnabled && occlusion.isOccluded(bounds, nearestDepth)) {
+            artworksOccluded++;
+        }
+        else {
+            artwork->render();
+            artworksRendered++;
+        }
+        i++;
+    }
+
+    if (scissor) {
+        glDisable(GL_SCISSOR_TEST);
+    }
+}
+
+void Gallery::render(ArtworkManager* manager, const float cameraPos[3]) {
+    roomsRendered = 0;
+    artworksRendered = 0;
+    artworksCulled = 0;
+    artworksOccluded = 0;
+
+    if (rooms.empty() || !manager) return;
+
+    cameraPosition[0] = cameraPos[0];
+    cameraPosition[1] = cameraPos[1];
+    cameraPosition[2] = cameraPos[2];
+
+    if (currentRoom < 0) {
+        currentRoom = std::max(0, findRoom(cameraPos[0], cameraPos[1], cameraPos[2]));
+    }
+
+    frustum.captureFromGL();
+
+    // Walk the portals from the camera's room
+    roomClip.assign(rooms.size(), ScreenRect::empty());
+    roomVisible.assign(rooms.size(), 0);
+    portalPath.clear();
+    collectVisibleRooms(currentRoom, ScreenRect::full(), 0);
+
+    // Fill the occlusion buffer with the walls and partitions of every visible room
+    if (occlusionEnabled) {
+        PROFILE_SCOPE("Occlusion");
+        occluderQuads.clear();
+        for (size_t i = 0; i < rooms.size(); i++) {
+            if (roomVisible[i]) {
+                rooms[i].room->getOccluderQuads(occluderQuads);
+            }
+        }
+        occlusion.beginFrame(frustum);
+        occlusion.addOccluders(occluderQuads);
+        occlusion.finishOccluders();
+    }
+
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // Camera's room first (unclipped), then the rooms seen through doors
+    renderRoom(currentRoom, manager, false, viewport);
+    for (size_t i = 0; i < rooms.size(); i++) {
+        if (roomVisible[i] && static_cast<int>(i) != currentRoom) {
+            renderRoom(static_cast<int>(i), manager, true, viewport);
+        }
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file gallery.h
+ * @brief Multi-room gallery with door portals and portal-based visibility culling
+ *
+ * A Gallery owns a set of Rooms that are joined by door portals. Each room keeps
+ * the handles of the artworks hanging in it. Rendering starts in the room the
+ * camera stands in and walks through the portals it can see, narrowing the
+ * visible screen region to each portal's projection on the way. Only rooms
+ * reached that way are drawn (scissored to their visible region), and only the
+ * artworks whose bounds overlap that region are submitted. Artworks that pass
+ * are finally tested against a software occlusion buffer filled with the wall
+ * sections and partitions of the visible rooms.
+ *
+ * Usage:
+ *    Gallery* gallery = new Gallery();
+ *    int hall = gallery->addRoom(new Room(30.0f, 16.0f, 30.0f));
+ *    Room* wing = new Room(20.0f, 16.0f, 20.0f);
+ *    wing->setPosition(25.0f, 0.0f, -5.0f);
+ *    int east = gallery->addRoom(wing);
+ *    gallery->connectRooms(hall, east, 4.0f, 6.0f); // door on the shared wall
+ *    gallery->assignArtworks(ArtworkManager::getInstance());
+ *
+ *    // Each update:
+ *    gallery->constrainCamera(camera);
+ *
+ *    // Each frame, after camera->applyTransformation():
+ *    gallery->render(ArtworkManager::getInstance(), cameraPosition);
+ */
+
+#pragma once
+#include <vector>
+#include "room.h"
+#include "frustum.h"
+#include "occlusion.h"
+#include "artwork_manager.h"
+
+class HumanCamera;
+
+class Gallery {
+private:
+    // One-way opening from one room into another
+    struct Portal {
+        int fromRoom;
+        int toRoom;
+        int doorIndex;      // Door in fromRoom
+        float corners[12];  // World-space door quad
+        float normal[3];    // Points into fromRoom
+    };
+
+    struct GalleryRoom {
+        Room* room;
+        std::vector<ArtworkHandle> artworks;
+        std::vector<int> portals;  // Portals leaving this room
+    };
+
+    std::vector<GalleryRoom> rooms;
+    std::vector<Portal> portals;
+    int currentRoom;
+    int maxPortalDepth;
+    float artworkDrawDistance;  // 0 = unlimited
+
+    // Per-frame visibility state
+    ViewFrustum frustum;
+    std::vector<ScreenRect> roomClip;
+    std::vector<char> roomVisible;
+    std::vector<int> portalPath;
+    float cameraPosition[3];
+
+    // Software occlusion culling against walls and partitions
+    OcclusionBuffer occlusion;
+    std::vector<float> occluderQuads;
+    bool occlusionEnabled;
+
+    // Statistics from the last render
+    int roomsRendered;
+    int artworksRendered;
+    int artworksCulled;
+    int artworksOccluded;
+
+    void collectVisibleRooms(int roomIndex, const ScreenRect& clip, int depth);
+    bool isCameraInPortal(const Portal& portal) const;
+    bool isBeyondDrawDistance(const float center[3], float radius) const;
+    bool isInDoorSpan(const Room* room, RoomWall wall, const float pos[3], float margin) const;
+    void renderRoom(int roomIndex, ArtworkManager* manager, bool scissor, const int viewport[4]);
+
+public:
+    Gallery();
+    ~Gallery();
+
+    Gallery(const Gallery&) = delete;
+    Gallery& operator=(const Gallery&) = delete;
+
+    // Building the gallery (takes ownership of rooms)
+    int addRoom(Room* room);
+    bool connectRooms(int roomA, int roomB, float doorWidth, float doorHeight);
+    void assignArtwork(int roomIndex, ArtworkHandle handle);
+    void assignArtworks(ArtworkManager* manager);
+    void addArtwork(ArtworkManager* manager, ArtworkHandle handle);  // Into the room it hangs in
+
+    // Room lookup
+    int findRoom(float x, float y, float z) const;
+    size_t getRoomCount() const { return rooms.size(); }
+    Room* getRoom(int index) const;
+    int getCurrentRoom() const { return currentRoom; }
+    // Re-detect the camera's room on the next constrainCamera (after a teleport)
+    void resetCurrentRoom() { currentRoom = -1; }
+    const std::vector<ArtworkHandle>& getRoomArtworks(int index) const { return rooms[index].artworks; }
+
+    // Keep the camera inside the gallery, switching rooms when it walks through a door
+    void constrainCamera(HumanCamera* camera);
+
+    // Draw the potentially visible rooms and artworks (modelview must hold the camera transform)
+    void render(ArtworkManager* manager, const float cameraPos[3]);
+
+    // Software occlusion culling
+    void setOcclusionEnabled(bool enabled) { occlusionEnabled = enabled; }
+    bool isOcclusionEnabled() const { return occlusionEnabled; }
+    const OcclusionBuffer& getOcclusionBuffer() const { return occlusion; }
+
+    // Portal traversal depth limit
+    void setMaxPortalDepth(int depth) { maxPortalDepth = depth; }
+
+    // Artworks further away than this are skipped (0 = no limit)
+    void setArtworkDrawDistance(float distance) { artworkDrawDistance = distance; }
+
+    // Statistics from the last render
+    int getRoomsRendered() const { return roomsRendered; }
+    int getArtworksRendered() const { return artworksRendered; }
+    int getArtworksCulled() const { return artworksCulled; }
+    int getArtworksOccluded() const { return artworksOccluded; }
+};
@@ -6,12 +6,32 @@
 #include <string>
 #include <cmath>
 #include <iomanip>
+#include <algorithm>
 #include "camera.h"
 #include "artwork.h"
 #include "artwork_manager.h"
 #include "room.h"
+#include "gallery.h"
+#include "catalog.h"
+#include "artwork_search.h"
+#include "fixed_timestep.h"
+#include "gl_extensions.h"
+#include "render_target.h"
+#include "quality_governor.h"
+#include "dynamic_resolution.h"
+#include "upscale_filter.h"
+#include "text_renderer.h"
+#include "ui_layer.h"
+#include "frame_scheduler.h"
+#include "profiler.h"
+#include "hitch_monitor.h"
+#include "trace.h"
 #include "input.h"
+#include "input_actions.h"
+#include "input_latency.h"
+#include "input_recorder.h"
 #include "config.h"
+#include "utility.h"
 
 // Define artwork IDs for easy reference
 enum ArtworkID {
@@ -35,28 +55,73 @@ private:
     
     // Game objects
     HumanCamera* camera;
-    Room* room;
+    Room* room;          // Main hall, owned by the gallery
+    Gallery* gallery;
     InputSystem* inputSystem;
     ArtworkManager* artworkManager;
-    float lastTime;
+    CatalogPager* catalogPager;   // Streams catalog artworks around the camera (null without a catalog)
+    
+    // Simulation runs at a fixed rate; rendering interpolates between steps
+    FixedTimestep simulationClock;
+    
+    // Artwork search ('/' opens the search box)
+    ArtworkSearchIndex searchIndex;
+    TextBox* searchBox;
+    std::vector<ArtworkSearchIndex::Result> searchResults;
+    int selectedResult;
+    
+    // Frame profiler HUD (F3 toggles, F4 dumps CSV; F5 starts/stops a trace)
+    ProfilerHud* profilerHud;
+    
+    // Last rendered 3D layer, reused while nothing in the scene changes
+    RenderTarget* sceneLayer;
+    bool sceneCached;
+    uint32_t cachedCameraVersion;
+    uint32_t cachedArtworkVersion;
+    
+    int cachedSceneWidth;
+    int cachedSceneHeight;
+    
+    // The 3D layer is drawn at a fraction of the window size and upscaled
+    DynamicResolution dynamicResolution;
+    UpscaleFilter upscaleFilter;
+    bool sceneRedrawn;          // This frame drew the scene rather than reusing the cache
+    
+    // Input events after this Profiler::now() time wait for the next simulation step
+    uint64_t stepInputDeadline;
+    
+    // Interpolation between the last two steps for this frame (recorded with the input)
+    float renderAlpha;
+    bool frameAdvanced;         // advanceFrame() ran since the last endFrame()
+    
+    // Seed of the artwork layout; recorded so a replay lays out the same gallery
+    unsigned int randomSeed;
+    InputRecorder::Frame replayFrame;
+    
+    // The search key is queued; typing until it is handled goes to the search box
+    bool searchOpening;
+    
+    // Overlays drawn once per change and blended over the scene
+    UILayer overlayLayer;
+    bool overlayChanged;        // Search results or selection changed since the layer was drawn
     
     // Array of image and frame paths
     std::string* imageID;
     std::string* frameID;
     ArtworkConfig* artworkConfigs;
     
+    // The game pieces. Paged catalog artworks are scenery: they come and go with
+    // their cell, so they are never selected, edited or counted for the win.
+    ArtworkHandle pieceHandles[ARTWORK_COUNT];
+    
     // Closest artwork tracking
-    int closestArtworkID;
+    ArtworkHandle closestArtwork;
     float closestArtworkDistance;
     bool debugProximity;
     
-    // Store the mapping between index in artworkManager and actual artwork IDs
-    std::vector<int> artworkIndexToID;
-    
     // Win condition tracking
     bool gameWon;
     float winTimer;
-    std::vector<float> artworkRotations;
     
     // Constructor is private for singleton
     GameManager();
@@ -73,9 +138,6 @@ private:
     // Find closest artwork to camera
     void updateClosestArtwork();
     
-    // Get artwork name from ID
-    std::string getArtworkName(int id);
-    
     // Rotate closest artwork
     void rotateClosestArtwork(float angle);
     
@@ -85,6 +147,46 @@ private:
     // Handle win state (print WIN message and exit)
     void handleWinState(float deltaTime);
     
+    // Search box helpers
+    void openSearch();
+    void closeSearch();
+    bool handleSearchKey(unsigned char key);
+    void teleportToResult(ArtworkSearchIndex::DocId doc);
+    void renderSearchOverlay();
+    
+    // Screen-space UI drawn over the 3D view
+    void renderOverlays();
+    
+    // Whether the next frame could differ without new input
+    bool isAnimating() const;
+    
+    // Turn the camera with the mouse motion that arrived since the last step
+    void latchCameraLook();
+    
+    // Rooms and artworks from the camera's point of view
+    void renderScene();
+    bool isSceneUnchanged() const;
+    
+    // Quality tiers
+    void applyQualityTier(const QualityTier& tier);
+    float measureBenchmarkFrames();
+    
+    // Start a trace capture, or stop the running one and write it out
+    void toggleTrace();
+    
+    // Input recording and replay (InputRecorder)
+    void initRecording();
+    void advanceReplayFrame();
+    // Hash of the simulation state, compared frame by frame between a recording and its replay
+    uint64_t computeStateChecksum();
+    
+    // Key bindings: the handlers of the one-shot actions
+    void registerActions();
+    // Closest artwork if it is near enough to edit; null (and a message) otherwise
+    Artwork* getEditableArtwork();
+    // Add to the closest artwork's image and frame stretch
+    void stretchClosestArtwork(float imageX, float imageY, float frameX, float frameY);
+    
 public:
     // Destructor
     ~GameManager();
@@ -101,20 +203,28 @@ public:
     void initRoom();
     void initCamera();
     void initArtworks();
+    void initCatalog();
+    void initSearch();
     void init();
     
     // Main game loop methods
-    void update(float deltaTime);
-    float getDeltaTime();
+    void advanceFrame();            // Run the simulation steps due since the last frame
+    void update(float deltaTime);   // One fixed simulation step
+    void updateInterface(float deltaTime);
     
     // Input handling
     void handleKeyPress(unsigned char key, int x, int y);
     void handleKeyRelease(unsigned char key, int x, int y);
+    void handleSpecialKeyPress(int key, int x, int y);
+    void handleSpecialKeyRelease(int key, int x, int y);
     void handleMouseMotion(int x, int y);
     void handleMouseButton(int button, int state, int x, int y);
+    void handleWindowEntry(int state);
     
     // Rendering
     void render();
+    // After the buffer swap: feed the frame's work time to the quality governor
+    void endFrame();
     
     // Cleanup
     void cleanup();
@@ -122,16 +232,21 @@ public:
     // Getters
     HumanCamera* getCamera() const { return camera; }
     Room* getRoom() const { return room; }
+    Gallery* getGallery() const { return gallery; }
     ArtworkManager* getArtworkManager() const { return artworkManager; }
     InputSystem* getInputSystem() const { return inputSystem; }
-    int getClosestArtworkID() const { return closestArtworkID; }
+    ArtworkHandle getClosestArtwork() const { return closestArtwork; }
     float getClosestArtworkDistance() const { return closestArtworkDistance; }
+    bool isSearchOpen() const { return searchBox && searchBox->getVisible(); }
+    // Every recorded frame has been replayed
+    bool isReplayFinished() const { return InputRecorder::getInstance().isFinished(); }
     
     // Toggle debug mode
     void toggleDebugProximity() { debugProximity = !debugProximity; }
     
     // Utility functions
     void printControls();
+    void printOcclusionStats();
 };
 
 // Initialize static instance to nullptr
@@ -139,16 +254,22 @@ GameManager* GameManager::instance = nullptr;
 
 // Constructor
 GameManager::GameManager() 
-    : camera(nullptr), room(nullptr), inputSystem(nullptr), artworkManager(nullptr), lastTime(0.0f),
-      closestArtworkID(-1), closestArtworkDistance(999999.0f), debugProximity(false),
+    : camera(nullptr), room(nullptr), gallery(nullptr), inputSystem(nullptr), artworkManager(nullptr),
+      catalogPager(nullptr), searchBox(nullptr), selectedResult(0),
+      profilerHud(nullptr), sceneLayer(nullptr), sceneCached(false),
+      cachedCameraVersion(0), cachedArtworkVersion(0),
+      cachedSceneWidth(0), cachedSceneHeight(0), sceneRedrawn(false), stepInputDeadline(UINT64_MAX),
+      renderAlpha(0.0f), frameAdvanced(false), randomSeed(static_cast<unsigned int>(time(nullptr))),
+      searchOpening(false), overlayChanged(true),
+      closestArtworkDistance(999999.0f), debugProximity(false),
       gameWon(false), winTimer(0.0f) {
     // Initialize arrays
     imageID = new std::string[ARTWORK_COUNT];
     frameID = new std::string[ARTWORK_COUNT];
     artworkConfigs = new ArtworkConfig[ARTWORK_COUNT];
     
-    // Initialize random seed
-    srand(static_cast<unsigned int>(time(nullptr)));
+    // Initialize random seed (a replay reseeds with the recorded one)
+    srand(randomSeed);
     
     // Init will be called separately
 }
@@ -179,16 +300,6 @@ float GameManager::calculateDistance(float x1, float y1, float z1, float x2, flo
     return std::sqrt(dx*dx + dy*dy + dz*dz);
 }
 
-// Get artwork name from ID
-std::string GameManager::getArtworkName(int id) {
-    switch (id) {
-        case ARTWORK_MEGATRON_ONE: return "Megatron One";
-        case ARTWORK_MEGATRON_PRIME: return "Megatron Prime";
-        case ARTWORK_STARSCREAM: return "StarScream";
-        default: return "Unknown";
-    }
-}
-
 // Calculate perceptual distance between camera and artwork
 float GameManager::calculateArtworkDistance(Artwork* artwork, float cameraX, float cameraY, float cameraZ) {
     if (!artwork) return 999999.0f;
@@ -218,17 +329,16 @@ void GameManager::updateClosestArtwork() {
         std::cout << "Camera position: " << cameraPos[0] << ", " << cameraPos[1] << ", " << cameraPos[2] << std::endl;
     }
     
-    // Check each artwork
-    for (size_t i = 0; i < artworkManager->getArtworkCount(); i++) {
-        Artwork* artwork = artworkManager->getArtwork(i);
+    // Check each game piece
+    for (int i = 0; i < ARTWORK_COUNT; i++) {
+        Artwork* artwork = artworkManager->getArtwork(pieceHandles[i]);
         if (artwork) {
             float dist = calculateArtworkDistance(artwork, cameraPos[0], cameraPos[1], cameraPos[2]);
             
             // In debug mode, output all distances
             if (debugProximity) {
                 float* artPos = artwork->getPosition();
-                int artID = i < artworkIndexToID.size() ? artworkIndexToID[i] : i;
-                std::cout << "Artwork " << artID << " (" << getArtworkName(artID) << "): " << std::endl;
+                std::cout << "Artwork " << i << " (" << artworkManager->getArtworkName(artwork->getHandle()) << "): " << std::endl;
                 std::cout << "  Position: " << artPos[0] << ", " << artPos[1] << ", " << artPos[2] << std::endl;
                 std::cout << "  Distance: " << std::fixed << std::setprecision(2) << dist << std::endl;
             }
@@ -245,16 +355,16 @@ void GameManager::updateClosestArtwork() {
         std::cout << "----------------------------------------" << std::endl;
     }
     
-    // Map the closestIdx to the correct artwork ID
-    int artworkID = closestIdx < artworkIndexToID.size() ? artworkIndexToID[closestIdx] : closestIdx;
+    // Handles stay valid across removals, unlike dense indices
+    ArtworkHandle closestHandle = closestIdx >= 0 ? pieceHandles[closestIdx] : ArtworkHandle();
     
     // Only update and print if the closest artwork changed or distance changed significantly
-    if (artworkID != closestArtworkID || std::abs(closestDist - closestArtworkDistance) > 0.05f) {
-        closestArtworkID = artworkID;
+    if (closestHandle != closestArtwork || std::abs(closestDist - closestArtworkDistance) > 0.05f) {
+        closestArtwork = closestHandle;
         closestArtworkDistance = closestDist;
         
         // Print the closest artwork info
-        std::cout << "Closest artwork: " << getArtworkName(closestArtworkID) << ", ";
+        std::cout << "Closest artwork: " << artworkManager->getArtworkName(closestArtwork) << ", ";
         std::cout << "distance: " << std::fixed << std::setprecision(2) << closestArtworkDistance << " units" << std::endl;
     }
 }
@@ -278,6 +388,16 @@ void GameManager::initPaths() {
 
 // Initialize artwork configurations
 void GameManager::initArtworkConfigs() {
+    // Display names
+    artworkConfigs[ARTWORK_MEGATRON_ONE].name = "Megatron One";
+    artworkConfigs[ARTWORK_MEGATRON_PRIME].name = "Megatron Prime";
+    artworkConfigs[ARTWORK_STARSCREAM].name = "StarScream";
+    
+    // Search tags
+    artworkConfigs[ARTWORK_MEGATRON_ONE].tags = { "transformers", "decepticon", "megatron" };
+    artworkConfigs[ARTWORK_MEGATRON_PRIME].tags = { "transformers", "decepticon", "megatron" };
+    artworkConfigs[ARTWORK_STARSCREAM].tags = { "transformers", "decepticon", "seeker" };
+    
     // ARTWORK_MEGATRON_ONE configuration
     artworkConfigs[ARTWORK_MEGATRON_ONE].posX = 0.0f;
     artworkConfigs[ARTWORK_MEGATRON_ONE].posY = 0.0f;
@@ -349,9 +469,6 @@ void GameManager::initArtworkConfigs() {
     artworkConfigs[ARTWORK_STARSCREAM].frameStretchX = 1.40f;
     artworkConfigs[ARTWORK_STARSCREAM].frameStretchY = 1.10f;
     
-    // Clear and initialize our rotation tracking
-    artworkRotations.clear();
-    
     // Print initial artwork configurations
     std::cout << "Initial artwork rotations: " << std::endl;
     std::cout << "  Megatron One: " << artworkConfigs[ARTWORK_MEGATRON_ONE].rotAngle << "°" << std::endl;
@@ -361,39 +478,54 @@ void GameManager::initArtworkConfigs() {
 
 // Initialize room
 void GameManager::initRoom() {
-    room = new Room(30.0f, 16.0f, 30.0f);
+    gallery = new Gallery();
 
     std::string wallTexturePath = basePath4T + "wall4.bmp";
     std::string floorTexturePath = basePath4T + "floor3.bmp";
     std::string roofTexturePath = basePath4T + "wall4.bmp";
 
-    room->setWallTexture(wallTexturePath);
-    room->setFloorTexture(floorTexturePath);
-    room->setRoofTexture(roofTexturePath);
+    // Main hall at the origin with a wing on either side
+    room = new Room(30.0f, 16.0f, 30.0f);
+    Room* eastWing = new Room(20.0f, 16.0f, 20.0f);
+    eastWing->setPosition(25.0f, 0.0f, -5.0f);
+    Room* westWing = new Room(20.0f, 16.0f, 20.0f);
+    westWing->setPosition(-25.0f, 0.0f, -5.0f);
+
+    Room* galleryRooms[] = { room, eastWing, westWing };
+    for (Room* galleryRoom : galleryRooms) {
+        galleryRoom->setWallTexture(wallTexturePath);
+        galleryRoom->setFloorTexture(floorTexturePath);
+        galleryRoom->setRoofTexture(roofTexturePath);
+    }
+
+    // Free-standing partitions in the hall hide whatever hangs behind them
+    room->addPartition(-7.0f, 8.0f, 8.0f, 6.0f, 0.3f, true);
+    room->addPartition(7.0f, 8.0f, 8.0f, 6.0f, 0.3f, true);
+
+    int hall = gallery->addRoom(room);
+    int east = gallery->addRoom(eastWing);
+    int west = gallery->addRoom(westWing);
+
+    // Doors reach from the floor to head height
+    gallery->connectRooms(hall, east, 3.0f, 5.0f);
+    gallery->connectRooms(hall, west, 3.0f, 5.0f);
 }
 
 // Initialize camera
 void GameManager::initCamera() {
     camera = new HumanCamera();
     camera->setPosition(0.0f, 0.0f, 3.0f);
+    camera->savePreviousState();
 }
 
 // Initialize artworks
 void GameManager::initArtworks() {
-    // Clear the artwork index to ID mapping
-    artworkIndexToID.clear();
-    
-    // Clear rotation tracking
-    artworkRotations.clear();
-    
     // Create artwork #1 using config
     Artwork* painting1 = artworkManager->createArtworkFromConfig(
         imageID[ARTWORK_MEGATRON_ONE], 
         frameID[ARTWORK_MEGATRON_ONE], 
         artworkConfigs[ARTWORK_MEGATRON_ONE]
     );
-    artworkIndexToID.push_back(ARTWORK_MEGATRON_ONE);
-    artworkRotations.push_back(artworkConfigs[ARTWORK_MEGATRON_ONE].rotAngle);
     
     // Create artwork #2 using config but with manual adjustment
     ArtworkConfig config = artworkConfigs[ARTWORK_MEGATRON_PRIME];
@@ -402,8 +534,6 @@ void GameManager::initArtworks() {
         frameID[ARTWORK_MEGATRON_PRIME], 
         config
     );
-    artworkIndexToID.push_back(ARTWORK_MEGATRON_PRIME);
-    artworkRotations.push_back(artworkConfigs[ARTWORK_MEGATRON_PRIME].rotAngle);
     
     // Apply additional manual adjustments
     painting2->translate(-4.0f, 0.0f, 0.0f);
@@ -414,8 +544,10 @@ void GameManager::initArtworks() {
         frameID[ARTWORK_STARSCREAM], 
         artworkConfigs[ARTWORK_STARSCREAM]
     );
-    artworkIndexToID.push_back(ARTWORK_STARSCREAM);
-    artworkRotations.push_back(artworkConfigs[ARTWORK_STARSCREAM].rotAngle);
+    
+    pieceHandles[ARTWORK_MEGATRON_ONE] = painting1->getHandle();
+    pieceHandles[ARTWORK_MEGATRON_PRIME] = painting2->getHandle();
+    pieceHandles[ARTWORK_STARSCREAM] = painting3->getHandle();
     
     // Adjust Y positions of all artworks to be at eye level
     for (size_t i = 0; i < artworkManager->getArtworkCount(); i++) {
@@ -424,20 +556,143 @@ void GameManager::initArtworks() {
         artwork->setPosition(pos[0], 1.0f, pos[2]); // Setting y to be at eye level
     }
 
+    // Hang each artwork in the room it sits in
+    gallery->assignArtworks(artworkManager);
+
     std::cout << "Initialized " << artworkManager->getArtworkCount() << " artworks" << std::endl;
-    std::cout << "Artwork mapping: " << std::endl;
-    for (size_t i = 0; i < artworkIndexToID.size(); i++) {
-        std::cout << "  Index " << i << " -> ID " << artworkIndexToID[i] 
-                  << " (" << getArtworkName(artworkIndexToID[i]) << ")" 
-                  << ", Rotation: " << artworkRotations[i] << "°" << std::endl;
+    std::cout << "Artwork handles: " << std::endl;
+    for (size_t i = 0; i < artworkManager->getArtworkCount(); i++) {
+        ArtworkHandle handle = artworkManager->getHandle(i);
+        std::cout << "  Index " << i << " -> Handle " << handle.index << ":" << handle.generation
+                  << " (" << artworkManager->getArtworkName(handle) << ")" 
+                  << ", Rotation: " << artworkManager->getArtwork(handle)->getRotationAngle() << "°" << std::endl;
+    }
+}
+
+// Initialize catalog paging
+void GameManager::initCatalog() {
+    const std::string& catalogPath = Config::getInstance().getCatalogPath();
+    if (catalogPath.empty()) {
+        return;
+    }
+
+    catalogPager = new CatalogPager();
+    catalogPager->setLoadRadius(Config::getInstance().getCatalogLoadRadius());
+    catalogPager->setOnArtworkLoaded([this](ArtworkHandle handle) {
+        gallery->addArtwork(artworkManager, handle);
+    });
+
+    if (!catalogPager->open(catalogPath, artworkManager)) {
+        delete catalogPager;
+        catalogPager = nullptr;
+    }
+}
+
+// Build the search index over the placed artworks and the whole catalog
+void GameManager::initSearch() {
+    searchIndex.clear();
+
+    ArtworkSearchIndex::Metadata meta;
+    float position[3];
+    float facing[2];
+    for (size_t i = 0; i < artworkManager->getArtworkCount(); i++) {
+        ArtworkHandle handle = artworkManager->getHandle(i);
+        Artwork* artwork = artworkManager->getArtwork(handle);
+        ArtworkInfo* info = artworkManager->getArtworkInfo(handle);
+        if (!artwork || !info) continue;
+
+        meta.title = info->name;
+        meta.artist = info->artist;
+        meta.year = info->year;
+        meta.tags = info->tags;
+        artwork->getWorldPosition(position);
+        Artwork::placementFacing(artwork->getPlacement(), facing);
+        searchIndex.addDocument(meta, position, facing, handle.index);
+    }
+
+    // Catalog pieces are searchable before their cell is paged in
+    const std::string& catalogPath = Config::getInstance().getCatalogPath();
+    CatalogReader reader;
+    if (catalogPager && reader.open(catalogPath)) {
+        std::vector<CatalogEntry> entries;
+        int cellCount = reader.getCellsX() * reader.getCellsZ();
+        for (int cell = 0; cell < cellCount; cell++) {
+            if (reader.getCellRecordCount(cell) == 0 || !reader.readCell(cell, entries)) continue;
+            for (const CatalogEntry& entry : entries) {
+                const ArtworkConfig& config = entry.config;
+                meta.title = config.name;
+                meta.artist = config.artist;
+                meta.year = config.year;
+                meta.tags = config.tags;
+                Artwork::placementToWorld(config.placement, config.posX, config.posY, config.posZ, position);
+                Artwork::placementFacing(config.placement, facing);
+                searchIndex.addDocument(meta, position, facing, entry.id);
+            }
+        }
+    }
+
+    searchIndex.build();
+    std::cout << "Search index: " << searchIndex.size() << " artworks, "
+              << searchIndex.memoryUsage() / 1024 << " KB" << std::endl;
+
+    searchBox = new TextBox("", "Search title, artist, year or tag");
+    searchBox->setVisible(false);
+    searchBox->setOnChange([this](const std::string& text) {
+        searchIndex.search(text, 5, searchResults);
+        selectedResult = 0;
+        overlayChanged = true;
+    });
+    searchBox->setOnSubmit([this](const std::string&) {
+        if (!searchResults.empty()) {
+            teleportToResult(searchResults[selectedResult].doc);
+        }
+        closeSearch();
+    });
+}
+
+// Replay a recording, or record this session, as the config asks
+void GameManager::initRecording() {
+    Config& config = Config::getInstance();
+    InputRecorder& recorder = InputRecorder::getInstance();
+    
+    if (!config.getInputReplayPath().empty() &&
+        recorder.startReplay(config.getInputReplayPath(), config.isReplayMaxSpeed())) {
+        // Same layout as the recorded session; live input is ignored (Esc still quits)
+        randomSeed = recorder.getSeed();
+        srand(randomSeed);
+        inputSystem->setLiveInput(false);
+        return;
+    }
+    
+    if (!config.getInputRecordPath().empty()) {
+        simulationClock.setRate(config.getSimulationRate());
+        recorder.startRecording(config.getInputRecordPath(), randomSeed, simulationClock.getStep());
     }
 }
 
 // Main initialization
 void GameManager::init() {
+    PROFILE_SCOPE("Init");
+    Profiler::getInstance().setThreadName("Main");
+    loadGLExtensions();
+    TextRenderer::getInstance().loadFont(Config::getInstance().getUiFontPath());
+    
     // Get input system instance
     inputSystem = InputSystem::getInstance();
     
+    // Before anything random: a replay lays the gallery out with the recorded seed
+    // and switches live input off
+    initRecording();
+    
+    // Mouse look uses relative mouse unless the config turns it off; a replay
+    // leaves the cursor alone
+    if (inputSystem->isLiveInput()) {
+        inputSystem->setRelativeMouse(Config::getInstance().isRelativeMouse());
+        if (!inputSystem->isRelativeMouse()) {
+            inputSystem->centerPointer();
+        }
+    }
+    
     // Get artwork manager instance
     artworkManager = ArtworkManager::getInstance();
     
@@ -448,16 +703,97 @@ void GameManager::init() {
     initArtworkConfigs();
     
     // Initialize room
-    initRoom();
+    {
+        TRACE_SCOPE("initRoom");
+        initRoom();
+    }
     
     // Initialize camera
     initCamera();
     
     // Initialize artworks
-    initArtworks();
+    {
+        TRACE_SCOPE("initArtworks");
+        initArtworks();
+    }
+    
+    // Open the exhibition catalog, if one is configured
+    {
+        TRACE_SCOPE("initCatalog");
+        initCatalog();
+    }
     
-    // Initialize lastTime
-    lastTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
+    // Index everything for the search box
+    {
+        TRACE_SCOPE("initSearch");
+        initSearch();
+    }
+    
+    // Profiler HUD, hidden unless the config asks for it
+    profilerHud = new ProfilerHud();
+    profilerHud->setVisible(Config::getInstance().isProfilerShown());
+    
+    // Hitch reports
+    HitchMonitor& hitchMonitor = HitchMonitor::getInstance();
+    hitchMonitor.setEnabled(Config::getInstance().isHitchMonitorEnabled());
+    hitchMonitor.setBudgetMs(Config::getInstance().getHitchBudgetMs());
+    hitchMonitor.setReportDirectory(Config::getInstance().getHitchReportDir());
+    Logger::getInstance().setLineObserver([](const std::string& line, Logger::TimePoint when) {
+        HitchMonitor::getInstance().noteEvent("log", line, when);
+    });
+    const std::string& binaryLogPath = Config::getInstance().getBinaryLogPath();
+    if (!binaryLogPath.empty() && !Logger::getInstance().enableBinaryLogging(true, binaryLogPath)) {
+        LOG_WARN("Could not open binary log {}", binaryLogPath);
+    }
+    
+    // Frame pacing; after an idle period the simulation resumes from now
+    FrameScheduler& scheduler = FrameScheduler::getInstance();
+    scheduler.setTargetFps(Config::getInstance().getTargetFrameRate());
+    scheduler.setVsync(Config::getInstance().isVsyncEnabled());
+    scheduler.setIdleThrottling(Config::getInstance().isIdleThrottling());
+    scheduler.setOnResume([this]() { simulationClock.reset(); });
+    if (InputRecorder::getInstance().isReplaying()) {
+        scheduler.setIdleThrottling(false);
+        if (InputRecorder::getInstance().isMaxSpeed()) {
+            scheduler.setTargetFps(0.0f);
+            scheduler.setVsync(false);
+        }
+    }
+    
+    // Reuse the last 3D frame while nothing in the scene changes
+    if (Config::getInstance().isRenderCaching() && glext.framebufferObjects) {
+        sceneLayer = new RenderTarget();
+        
+        // Per-frame render scale within the quality tier, upscaled with optional sharpening
+        dynamicResolution.init();
+        dynamicResolution.setEnabled(Config::getInstance().isDynamicResolution());
+        dynamicResolution.setScaleRange(Config::getInstance().getMinRenderScale(), 1.0f);
+        upscaleFilter.init();
+        upscaleFilter.setSharpness(Config::getInstance().getUpscaleSharpness());
+    }
+    
+    // Render quality: a fixed tier from the config, or the best one the benchmark can hold
+    QualityGovernor& governor = QualityGovernor::getInstance();
+    governor.setOnChange([this](const QualityTier& tier) { applyQualityTier(tier); });
+    governor.setTargetFrameRate(Config::getInstance().getTargetFrameRate());
+    if (Config::getInstance().getQualityTier() < 0) {
+        TRACE_SCOPE("Quality benchmark");
+        governor.runBenchmark([this]() { return measureBenchmarkFrames(); });
+    }
+    else {
+        governor.setTier(Config::getInstance().getQualityTier());
+    }
+    governor.setAdaptive(Config::getInstance().isAdaptiveQuality());
+    
+    // The scene gets most of the frame; presenting and the UI take the rest
+    dynamicResolution.setBudgetMs(governor.getBudgetMs() * 0.75f);
+    
+    // Start simulating from now, not from when loading began
+    simulationClock.setRate(Config::getInstance().getSimulationRate());
+    simulationClock.reset();
+    
+    // Key bindings (defaults, then the config's overrides)
+    registerActions();
     
     // Print controls
     printControls();
@@ -467,45 +803,117 @@ void GameManager::init() {
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
-// Get delta time
-float GameManager::getDeltaTime() {
-    float currentTime = glutGet(GLUT_ELAPSED_TIME) / 1000.0f;
-    float deltaTime = currentTime - lastTime;
-    lastTime = currentTime;
-    if (deltaTime > 0.1f) deltaTime = 0.1f;
-    return deltaTime;
+// Run the simulation steps covered by the real time since the last frame
+void GameManager::advanceFrame() {
+    if (InputRecorder::getInstance().isReplaying()) {
+        advanceReplayFrame();
+        return;
+    }
+    
+    // Long frames are clamped so the camera doesn't jump; HitchMonitor reports them
+    int steps = simulationClock.advance();
+    renderAlpha = simulationClock.getAlpha();
+    InputRecorder& recorder = InputRecorder::getInstance();
+    recorder.recordFrame(steps, renderAlpha, simulationClock.getFrameSeconds());
+    
+    // Each step takes the input that arrived during the real time it stands for;
+    // the last one takes everything left, so no input waits for the next frame
+    uint64_t frameTime = Profiler::now();
+    double stepNs = simulationClock.getStep() * 1.0e9;
+    for (int i = 0; i < steps; i++) {
+        uint64_t behind = static_cast<uint64_t>((simulationClock.getAlpha() + steps - 1 - i) * stepNs);
+        stepInputDeadline = i + 1 < steps && behind < frameTime ? frameTime - behind : UINT64_MAX;
+        camera->savePreviousState();
+        update(simulationClock.getStep());
+        recorder.recordStep(inputSystem->getStepEvents());
+    }
+    frameAdvanced = true;
+    
+    // The last step took every queued key, the search key included
+    if (steps > 0) {
+        searchOpening = false;
+    }
+    
+    updateInterface(simulationClock.getFrameSeconds());
+    FrameScheduler::getInstance().setAnimating(isAnimating());
+    
+    // Relative mouse: back to the middle for the next frame's motion
+    inputSystem->recenterPointer();
 }
 
-// Update game state
+// Replay: the recorded steps with the recorded events, at the recorded or maximum pace
+void GameManager::advanceReplayFrame() {
+    InputRecorder& recorder = InputRecorder::getInstance();
+    if (!recorder.nextFrame(replayFrame)) return;
+    recorder.waitForFrame(replayFrame);
+    
+    stepInputDeadline = UINT64_MAX;
+    for (const std::vector<InputEvent>& events : replayFrame.stepEvents) {
+        for (const InputEvent& event : events) {
+            inputSystem->injectEvent(event);
+        }
+        camera->savePreviousState();
+        update(recorder.getStepSeconds());
+    }
+    renderAlpha = replayFrame.alpha;
+    frameAdvanced = true;
+    
+    updateInterface(replayFrame.frameSeconds);
+    FrameScheduler::getInstance().setAnimating(true);
+}
+
+bool GameManager::isAnimating() const {
+    return camera->isSettling() || inputSystem->isMovementKeyPressed() ||
+        (catalogPager && catalogPager->getPendingCells() > 0) ||
+        isSearchOpen() ||                   // Blinking cursor
+        profilerHud->getVisible() ||        // Live graph
+        gameWon;
+}
+
+// Advance the game state by one fixed step
 void GameManager::update(float deltaTime) {
+    PROFILE_SCOPE("Update");
+    
     // Update input system
-    inputSystem->update();
+    {
+        PROFILE_SCOPE("Input");
+        inputSystem->update(stepInputDeadline);
+    }
+    
+    // One-shot actions and search typing, in the order they arrived
+    ActionMap& actions = ActionMap::getInstance();
+    for (const InputEvent& event : inputSystem->getStepEvents()) {
+        if (event.type == InputEvent::KeyDown) {
+            actions.dispatchKey(static_cast<unsigned char>(event.code));
+        } else if (event.type == InputEvent::SpecialKeyDown) {
+            actions.dispatchSpecialKey(event.code);
+        } else if (event.type == InputEvent::Text && isSearchOpen()) {
+            handleSearchKey(static_cast<unsigned char>(event.code));
+        }
+    }
     
     // Update camera
-    camera->update(deltaTime);
+    {
+        PROFILE_SCOPE("Camera");
+        camera->update(deltaTime);
 
-    // Constrain camera to room boundaries
-    const float* roomDimensions = room->getDimensions();
-    float roomWidth = roomDimensions[0];
-    float roomHeight = roomDimensions[1];
-    float roomDepth = roomDimensions[2];
-
-    float pos[3];
-    camera->getPosition(pos);
-
-    float wallOffset = 0.2f;
-    float floorOffset = 0.1f;
-
-    if (pos[0] < -roomWidth / 2 + wallOffset) pos[0] = -roomWidth / 2 + wallOffset;
-    if (pos[0] > roomWidth / 2 - wallOffset) pos[0] = roomWidth / 2 - wallOffset;
-    if (pos[2] < -roomDepth / 2 + wallOffset) pos[2] = -roomDepth / 2 + wallOffset;
-    if (pos[2] > roomDepth / 2 - wallOffset) pos[2] = roomDepth / 2 - wallOffset;
-    if (pos[1] < -roomHeight / 2 + 1.7f + floorOffset) pos[1] = -roomHeight / 2 + 1.7f + floorOffset;
-
-    camera->setPosition(pos[0], pos[1], pos[2]);
+        // Constrain camera to the gallery (walls block, doors let it through)
+        gallery->constrainCamera(camera);
+    }
+    
+    // Stream catalog cells around the visitor
+    if (catalogPager) {
+        PROFILE_SCOPE("Streaming");
+        float cameraPos[3];
+        camera->getPosition(cameraPos);
+        catalogPager->update(cameraPos);
+    }
     
     // Update closest artwork tracking
-    updateClosestArtwork();
+    {
+        PROFILE_SCOPE("Proximity");
+        updateClosestArtwork();
+    }
     
     // Handle win state if game is won
     if (gameWon) {
@@ -513,8 +921,239 @@ void GameManager::update(float deltaTime) {
     }
 }
 
+// UI animates once per rendered frame, with the real frame time
+void GameManager::updateInterface(float deltaTime) {
+    if (isSearchOpen()) {
+        searchBox->update(deltaTime);
+    }
+    if (profilerHud->getVisible()) {
+        FrameScheduler& scheduler = FrameScheduler::getInstance();
+        std::string cap = scheduler.getTargetFps() > 0.0f ?
+            std::to_string(static_cast<int>(scheduler.getTargetFps())) + " fps" : "off";
+        QualityGovernor& governor = QualityGovernor::getInstance();
+        char status[160];
+        snprintf(status, sizeof(status), "CPU %.0f%%  cap %s  vsync %s\nquality %s%s  scale %.0f%%  scene %.1f ms (%s)",
+            scheduler.getCpuUsage(), cap.c_str(), scheduler.isVsyncActive() ? "on" : "off",
+            governor.getCurrentTier().name, governor.isAdaptive() ? " (auto)" : "",
+            dynamicResolution.getScale() * 100.0f, dynamicResolution.getLastSceneMs(),
+            dynamicResolution.hasGpuTiming() ? "GPU" : "CPU");
+        profilerHud->setStatusLine(std::string(status) + "\n" + InputLatency::getInstance().describe());
+        profilerHud->update(deltaTime);
+    }
+}
+
 // Render the game
 void GameManager::render() {
+    PROFILE_SCOPE("Render");
+    int width = glutGet(GLUT_WINDOW_WIDTH);
+    int height = glutGet(GLUT_WINDOW_HEIGHT);
+    sceneRedrawn = false;
+    
+    // Before the cache check, so a latched turn redraws the scene
+    latchCameraLook();
+    
+    // Without render caching (or framebuffer objects) draw straight to the window
+    if (!sceneLayer) {
+        renderScene();
+        renderOverlays();
+        sceneRedrawn = true;
+        return;
+    }
+    
+    // The layer is allocated at the tier's scale; dynamic resolution draws into part of it.
+    // A scene that has stopped changing is redrawn once at full detail.
+    float maxScale = dynamicResolution.getMaxScale();
+    bool unchanged = isSceneUnchanged();
+    float scale = unchanged ? maxScale : dynamicResolution.getScale();
+    int layerWidth = std::max(1, static_cast<int>(width * maxScale + 0.5f));
+    int layerHeight = std::max(1, static_cast<int>(height * maxScale + 0.5f));
+    int sceneWidth = std::min(std::max(1, static_cast<int>(width * scale + 0.5f)), layerWidth);
+    int sceneHeight = std::min(std::max(1, static_cast<int>(height * scale + 0.5f)), layerHeight);
+    
+    // Redraw the 3D layer only when something in it changed; the UI goes on top every frame
+    bool layerResized = sceneLayer->getWidth() != layerWidth || sceneLayer->getHeight() != layerHeight;
+    if (!unchanged || layerResized || sceneWidth != cachedSceneWidth || sceneHeight != cachedSceneHeight) {
+        sceneRedrawn = true;
+        if (!sceneLayer->ensureSize(layerWidth, layerHeight)) {
+            Logger::getInstance().logWarning("Render caching disabled: cannot create the scene framebuffer");
+            delete sceneLayer;
+            sceneLayer = nullptr;
+            glViewport(0, 0, width, height);
+            renderScene();
+            renderOverlays();
+            return;
+        }
+        
+        sceneLayer->bind(sceneWidth, sceneHeight);
+        dynamicResolution.beginScene();
+        renderScene();
+        dynamicResolution.endScene();
+        RenderTarget::unbind();
+        
+        sceneCached = true;
+        cachedSceneWidth = sceneWidth;
+        cachedSceneHeight = sceneHeight;
+        cachedCameraVersion = camera->getVersion();
+        cachedArtworkVersion = Artwork::getSceneVersion();
+    }
+    
+    {
+        PROFILE_SCOPE("Scene present");
+        upscaleFilter.present(*sceneLayer, cachedSceneWidth, cachedSceneHeight, width, height);
+    }
+    
+    // UI stays at native resolution
+    renderOverlays();
+}
+
+// Judge the quality tier and render scale on frames that actually drew the scene
+void GameManager::endFrame() {
+    // Recording and replay compare the state of every frame that ran steps
+    if (frameAdvanced) {
+        InputRecorder& recorder = InputRecorder::getInstance();
+        if (recorder.getMode() != InputRecorder::Mode::Off) {
+            uint64_t checksum = computeStateChecksum();
+            recorder.recordChecksum(checksum);
+            recorder.noteReplayedFrame(replayFrame, checksum, Profiler::getInstance().getLastFrameMs());
+        }
+        frameAdvanced = false;
+    }
+    
+    dynamicResolution.collectTimings();
+    if (sceneRedrawn) {
+        float workMs = FrameScheduler::getInstance().getWorkMs();
+        QualityGovernor::getInstance().addFrameSample(workMs);
+        dynamicResolution.addFrameSample(workMs);
+    }
+}
+
+// FNV-1a over what the simulation steps change: camera, the game pieces, game progress.
+// Catalog artworks page in on a loader thread and are never edited, so they are left out.
+uint64_t GameManager::computeStateChecksum() {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    
+    float position[3];
+    float rotation[3];
+    camera->getPosition(position);
+    camera->getRotation(rotation[0], rotation[1], rotation[2]);
+    mix(position, sizeof(position));
+    mix(rotation, sizeof(rotation));
+    
+    for (int i = 0; i < ARTWORK_COUNT; i++) {
+        Artwork* artwork = artworkManager->getArtwork(pieceHandles[i]);
+        if (!artwork) continue;
+        float values[5] = {
+            artwork->getRotationAngle(),
+            artwork->getImageStretchX(), artwork->getImageStretchY(),
+            artwork->getFrameStretchX(), artwork->getFrameStretchY()
+        };
+        mix(values, sizeof(values));
+    }
+    
+    mix(&gameWon, sizeof(gameWon));
+    mix(&winTimer, sizeof(winTimer));
+    return hash;
+}
+
+// Scene resolution, texture detail and culling distances for a quality tier
+void GameManager::applyQualityTier(const QualityTier& tier) {
+    // Without the offscreen layer the scene is always drawn at window size
+    dynamicResolution.setMaxScale(sceneLayer ? tier.renderScale : 1.0f);
+    Image::setTextureQuality(tier.maxTextureSize, tier.mipBias);
+    gallery->setArtworkDrawDistance(tier.drawDistance);
+    gallery->setMaxPortalDepth(tier.portalDepth);
+    sceneCached = false;
+}
+
+// Average time of a scene frame at the current tier, looking around from the start position
+float GameManager::measureBenchmarkFrames() {
+    const int VIEWS = 4;
+    const int FRAMES_PER_VIEW = 4;
+    int width = glutGet(GLUT_WINDOW_WIDTH);
+    int height = glutGet(GLUT_WINDOW_HEIGHT);
+    float scale = dynamicResolution.getMaxScale();
+    int sceneWidth = std::max(1, static_cast<int>(width * scale + 0.5f));
+    int sceneHeight = std::max(1, static_cast<int>(height * scale + 0.5f));
+    if (sceneLayer && !sceneLayer->ensureSize(sceneWidth, sceneHeight)) {
+        return 0.0f;  // render() will fall back to direct drawing; nothing to measure here
+    }
+    
+    float position[3];
+    float pitch, yaw, roll;
+    camera->getPosition(position);
+    camera->getRotation(pitch, yaw, roll);
+    
+    // The first frame pays for texture level changes; don't count it
+    uint64_t total = 0;
+    int counted = 0;
+    for (int view = 0; view < VIEWS; view++) {
+        camera->teleport(position[0], position[1], position[2], pitch, yaw + view * 360.0f / VIEWS);
+        for (int frame = 0; frame <= FRAMES_PER_VIEW; frame++) {
+            uint64_t start = Profiler::now();
+            if (sceneLayer) {
+                sceneLayer->bind();
+                renderScene();
+                RenderTarget::unbind();
+                upscaleFilter.present(*sceneLayer, sceneWidth, sceneHeight, width, height);
+            }
+            else {
+                renderScene();
+            }
+            glFinish();
+            if (view > 0 || frame > 0) {
+                total += Profiler::now() - start;
+                counted++;
+            }
+        }
+    }
+    
+    camera->teleport(position[0], position[1], position[2], pitch, yaw);
+    sceneCached = false;
+    return static_cast<float>(total / 1.0e6 / counted);
+}
+
+// Late latching: the steps ran in idle(), and motion may have arrived since.
+// Only the rotation is updated here; movement waits for the next step.
+void GameManager::latchCameraLook() {
+    // A redraw without a new frame (expose, resize) turns nothing
+    if (!frameAdvanced) return;
+    
+    InputRecorder& recorder = InputRecorder::getInstance();
+    if (recorder.isReplaying()) {
+        if (replayFrame.hasLook) {
+            camera->addLook(replayFrame.lookYaw, replayFrame.lookPitch);
+        }
+        return;
+    }
+    if (!Config::getInstance().isLateLatching()) return;
+    
+    float deltaX, deltaY;
+    if (inputSystem->latchMouseDelta(deltaX, deltaY)) {
+        PROFILE_SCOPE("Late latch");
+        float sensitivity = camera->getMouseSensitivity();
+        camera->addLook(deltaX * sensitivity, deltaY * sensitivity);
+        recorder.recordLook(deltaX * sensitivity, deltaY * sensitivity);
+    }
+}
+
+// Nothing renderScene() draws has changed since the cached layer was drawn
+bool GameManager::isSceneUnchanged() const {
+    return sceneCached &&
+        !camera->isInterpolating() &&
+        camera->getVersion() == cachedCameraVersion &&
+        Artwork::getSceneVersion() == cachedArtworkVersion;
+}
+
+void GameManager::renderScene() {
+    PROFILE_SCOPE("Scene render");
+    
     // Set clear color
     glClearColor(0.2f, 0.2f, 0.3f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -523,117 +1162,171 @@ void GameManager::render() {
     glMatrixMode(GL_MODELVIEW);
     glLoadIdentity();
 
-    // Apply camera transformation
-    camera->applyTransformation();
+    // Apply camera transformation, between the last two simulation steps
+    float alpha = renderAlpha;
+    camera->applyTransformation(alpha);
     
-    // Render room
-    room->render();
+    // Render the rooms and artworks visible through the door portals
+    float cameraPos[3];
+    camera->getInterpolatedPosition(alpha, cameraPos);
+    gallery->render(artworkManager, cameraPos);
+    TRACE_COUNTER("Artworks rendered", gallery->getArtworksRendered());
+}
+
+// Draw the HUD and search box in screen space, reusing the last drawing while nothing changed
+void GameManager::renderOverlays() {
+    if (!isSearchOpen() && !profilerHud->getVisible()) {
+        overlayLayer.invalidate();
+        return;
+    }
+    
+    PROFILE_SCOPE("UI render");
+    int width = glutGet(GLUT_WINDOW_WIDTH);
+    int height = glutGet(GLUT_WINDOW_HEIGHT);
+    bool changed = overlayChanged || profilerHud->isDirty() || searchBox->isDirty();
     
-    // Render all artworks
-    artworkManager->renderAll();
+    overlayLayer.render(width, height, changed, [this, width, height]() {
+        beginScreenSpace(width, height);
+        
+        if (profilerHud->getVisible()) {
+            profilerHud->setPosition(10.0f, height - 10.0f - profilerHud->getSize()[1]);
+            profilerHud->render();
+        }
+        if (isSearchOpen()) {
+            renderSearchOverlay();
+        }
+        
+        endScreenSpace();
+    });
+    
+    overlayChanged = false;
+    profilerHud->clearDirty();
+    searchBox->clearDirty();
 }
 
-// Handle key press
+// Handle key press; keys take effect in the next simulation step (GameManager::update)
 void GameManager::handleKeyPress(unsigned char key, int x, int y) {
-    // First pass the key to the input system for movement handling
+    // The search box takes all typing while it is open, or about to open
+    if (isSearchOpen() || searchOpening) {
+        inputSystem->handleTextInput(key);
+        return;
+    }
+    if (ActionMap::getInstance().getKeyAction(key) == InputAction::OpenSearch) {
+        searchOpening = true;
+    }
+    
+    // Held state for movement; one-shot actions run their handler once per press
     inputSystem->handleKeyPress(key, x, y);
+}
+
+// Bind the one-shot actions to what they do; the keys come from the ActionMap
+void GameManager::registerActions() {
+    ActionMap& actions = ActionMap::getInstance();
+    actions.resetToDefaults();
+    actions.loadFromConfig();
+    
+    actions.setHandler(InputAction::OpenSearch, [this]() {
+        openSearch();
+        glutPostRedisplay();
+    });
     
-    // Artwork rotation keys
-    if (key == 'k') {
-        // Rotate counterclockwise by 15 degrees
+    // Artwork rotation
+    actions.setHandler(InputAction::RotateArtworkLeft, [this]() {
         rotateClosestArtwork(-15.0f);
         glutPostRedisplay();
-        return;
-    } else if (key == 'l') {
-        // Rotate clockwise by 15 degrees
+    });
+    actions.setHandler(InputAction::RotateArtworkRight, [this]() {
         rotateClosestArtwork(15.0f);
         glutPostRedisplay();
-        return;
-    }
+    });
+    
+    // Image and frame stretching
+    actions.setHandler(InputAction::ImageWider, [this]() { stretchClosestArtwork(0.1f, 0.0f, 0.0f, 0.0f); });
+    actions.setHandler(InputAction::ImageNarrower, [this]() { stretchClosestArtwork(-0.1f, 0.0f, 0.0f, 0.0f); });
+    actions.setHandler(InputAction::ImageTaller, [this]() { stretchClosestArtwork(0.0f, 0.1f, 0.0f, 0.0f); });
+    actions.setHandler(InputAction::ImageShorter, [this]() { stretchClosestArtwork(0.0f, -0.1f, 0.0f, 0.0f); });
+    actions.setHandler(InputAction::FrameWider, [this]() { stretchClosestArtwork(0.0f, 0.0f, 0.1f, 0.0f); });
+    actions.setHandler(InputAction::FrameNarrower, [this]() { stretchClosestArtwork(0.0f, 0.0f, -0.1f, 0.0f); });
+    actions.setHandler(InputAction::FrameTaller, [this]() { stretchClosestArtwork(0.0f, 0.0f, 0.0f, 0.1f); });
+    actions.setHandler(InputAction::FrameShorter, [this]() { stretchClosestArtwork(0.0f, 0.0f, 0.0f, -0.1f); });
+    actions.setHandler(InputAction::ResetImage, [this]() {
+        if (Artwork* art = getEditableArtwork()) {
+            art->resetImageStretch();
+            std::cout << artworkManager->getArtworkName(closestArtwork) << " - Image stretching reset" << std::endl;
+            glutPostRedisplay();
+        }
+    });
+    actions.setHandler(InputAction::ResetFrame, [this]() {
+        if (Artwork* art = getEditableArtwork()) {
+            art->resetFrameStretch();
+            std::cout << artworkManager->getArtworkName(closestArtwork) << " - Frame stretching reset" << std::endl;
+            glutPostRedisplay();
+        }
+    });
     
-    // Toggle debug proximity with 'p' key
-    if (key == 'p') {
+    // Debugging
+    actions.setHandler(InputAction::ToggleProximityDebug, [this]() {
         toggleDebugProximity();
         std::cout << "Debug proximity " << (debugProximity ? "enabled" : "disabled") << std::endl;
-        return;
+    });
+    actions.setHandler(InputAction::ToggleOcclusion, [this]() {
+        gallery->setOcclusionEnabled(!gallery->isOcclusionEnabled());
+        std::cout << "Occlusion culling " << (gallery->isOcclusionEnabled() ? "enabled" : "disabled") << std::endl;
+        printOcclusionStats();
+        glutPostRedisplay();
+    });
+    actions.setHandler(InputAction::ToggleProfiler, [this]() {
+        profilerHud->setVisible(!profilerHud->getVisible());
+        overlayChanged = true;
+        glutPostRedisplay();
+    });
+    actions.setHandler(InputAction::DumpProfiler, []() {
+        Profiler::getInstance().dumpCsv(Config::getInstance().getProfilerCsvPath());
+        std::cout << "Profiler samples written to " << Config::getInstance().getProfilerCsvPath() << std::endl;
+    });
+    actions.setHandler(InputAction::ToggleTrace, [this]() { toggleTrace(); });
+}
+
+Artwork* GameManager::getEditableArtwork() {
+    Artwork* art = nullptr;
+    if (artworkManager->getArtworkCount() > 0 && closestArtwork.isValid() && closestArtworkDistance <= 25.0f) {
+        art = artworkManager->getArtwork(closestArtwork);
     }
-    
-    // Check if we have artwork to manipulate
-    if (artworkManager->getArtworkCount() > 0 && closestArtworkID >= 0 && closestArtworkDistance <= 25.0f) {
-        // Get the closest artwork for stretching
-        int artworkIndex = -1;
-        for (size_t i = 0; i < artworkIndexToID.size(); i++) {
-            if (artworkIndexToID[i] == closestArtworkID) {
-                artworkIndex = i;
-                break;
-            }
-        }
-        
-        if (artworkIndex >= 0 && artworkIndex < artworkManager->getArtworkCount()) {
-            Artwork* art = artworkManager->getArtwork(artworkIndex);
-            
-            if (art) {
-                switch (key) {
-                    // Image stretching
-                    case 'x': // Increase X stretch of image
-                        art->stretchImage(art->getImageStretchX() + 0.1f, art->getImageStretchY());
-                        std::cout << getArtworkName(closestArtworkID) << " - Image X stretch: " << art->getImageStretchX() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'X': // Decrease X stretch of image
-                        art->stretchImage(art->getImageStretchX() - 0.1f, art->getImageStretchY());
-                        std::cout << getArtworkName(closestArtworkID) << " - Image X stretch: " << art->getImageStretchX() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'y': // Increase Y stretch of image
-                        art->stretchImage(art->getImageStretchX(), art->getImageStretchY() + 0.1f);
-                        std::cout << getArtworkName(closestArtworkID) << " - Image Y stretch: " << art->getImageStretchY() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'Y': // Decrease Y stretch of image
-                        art->stretchImage(art->getImageStretchX(), art->getImageStretchY() - 0.1f);
-                        std::cout << getArtworkName(closestArtworkID) << " - Image Y stretch: " << art->getImageStretchY() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                        
-                    // Frame stretching
-                    case 'f': // Increase X stretch of frame
-                        art->stretchFrame(art->getFrameStretchX() + 0.1f, art->getFrameStretchY());
-                        std::cout << getArtworkName(closestArtworkID) << " - Frame X stretch: " << art->getFrameStretchX() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'F': // Decrease X stretch of frame
-                        art->stretchFrame(art->getFrameStretchX() - 0.1f, art->getFrameStretchY());
-                        std::cout << getArtworkName(closestArtworkID) << " - Frame X stretch: " << art->getFrameStretchX() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'g': // Increase Y stretch of frame
-                        art->stretchFrame(art->getFrameStretchX(), art->getFrameStretchY() + 0.1f);
-                        std::cout << getArtworkName(closestArtworkID) << " - Frame Y stretch: " << art->getFrameStretchY() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'G': // Decrease Y stretch of frame
-                        art->stretchFrame(art->getFrameStretchX(), art->getFrameStretchY() - 0.1f);
-                        std::cout << getArtworkName(closestArtworkID) << " - Frame Y stretch: " << art->getFrameStretchY() << std::endl;
-                        glutPostRedisplay();
-                        break;
-                        
-                    // Reset stretching
-                    case 'r': // Reset image stretching
-                        art->resetImageStretch();
-                        std::cout << getArtworkName(closestArtworkID) << " - Image stretching reset" << std::endl;
-                        glutPostRedisplay();
-                        break;
-                    case 'R': // Reset frame stretching
-                        art->resetFrameStretch();
-                        std::cout << getArtworkName(closestArtworkID) << " - Frame stretching reset" << std::endl;
-                        glutPostRedisplay();
-                        break;
-                }
-            }
-        } else {
-            std::cout << "No artwork selected or too far away to modify." << std::endl;
-        }
+    if (!art) {
+        std::cout << "No artwork selected or too far away to modify." << std::endl;
+    }
+    return art;
+}
+
+void GameManager::stretchClosestArtwork(float imageX, float imageY, float frameX, float frameY) {
+    Artwork* art = getEditableArtwork();
+    if (!art) return;
+    
+    const std::string& artName = artworkManager->getArtworkName(closestArtwork);
+    if (imageX != 0.0f || imageY != 0.0f) {
+        art->stretchImage(art->getImageStretchX() + imageX, art->getImageStretchY() + imageY);
+        std::cout << artName << " - Image stretch: " << art->getImageStretchX() << " x "
+                  << art->getImageStretchY() << std::endl;
+    }
+    if (frameX != 0.0f || frameY != 0.0f) {
+        art->stretchFrame(art->getFrameStretchX() + frameX, art->getFrameStretchY() + frameY);
+        std::cout << artName << " - Frame stretch: " << art->getFrameStretchX() << " x "
+                  << art->getFrameStretchY() << std::endl;
+    }
+    glutPostRedisplay();
+}
+
+// Start a trace, or stop it and write the JSON timeline
+void GameManager::toggleTrace() {
+    Tracer& tracer = Tracer::getInstance();
+    const std::string& tracePath = Config::getInstance().getTracePath();
+    if (tracer.isEnabled()) {
+        tracer.stop();
+        tracer.writeJson(tracePath);
+        std::cout << "Trace written to " << tracePath << " (open it in ui.perfetto.dev)" << std::endl;
+    } else {
+        tracer.start();
+        std::cout << "Tracing started, press " << ActionMap::getInstance().describe(InputAction::ToggleTrace) << " again to stop" << std::endl;
     }
 }
 
@@ -642,65 +1335,260 @@ void GameManager::handleKeyRelease(unsigned char key, int x, int y) {
     inputSystem->handleKeyRelease(key, x, y);
 }
 
+// Handle special key press (function and arrow keys)
+void GameManager::handleSpecialKeyPress(int key, int x, int y) {
+    inputSystem->handleSpecialKeyPress(key, x, y);
+}
+
+// Handle special key release
+void GameManager::handleSpecialKeyRelease(int key, int x, int y) {
+    inputSystem->handleSpecialKeyRelease(key, x, y);
+}
+
 // Handle mouse motion
 void GameManager::handleMouseMotion(int x, int y) {
     inputSystem->handleMouseMotion(x, y);
 }
 
+// Handle the pointer entering or leaving the window
+void GameManager::handleWindowEntry(int state) {
+    inputSystem->handleWindowEntry(state);
+}
+
 // Handle mouse button
 void GameManager::handleMouseButton(int button, int state, int x, int y) {
-    // Currently not implemented
+    inputSystem->handleMouseButton(button, state, x, y);
+}
+
+// Show the search box and start typing into it
+void GameManager::openSearch() {
+    searchOpening = false;
+    if (!searchBox) return;
+
+    searchBox->setText("");
+    searchBox->setVisible(true);
+    searchBox->setFocus(true);
+    searchResults.clear();
+    selectedResult = 0;
+    overlayChanged = true;
+}
+
+void GameManager::closeSearch() {
+    if (!searchBox) return;
+    searchBox->setFocus(false);
+    searchBox->setVisible(false);
+    overlayChanged = true;
+}
+
+bool GameManager::handleSearchKey(unsigned char key) {
+    // Tab cycles through the results
+    if (key == '\t') {
+        if (!searchResults.empty()) {
+            selectedResult = (selectedResult + 1) % static_cast<int>(searchResults.size());
+            overlayChanged = true;
+        }
+        return true;
+    }
+
+    bool handled = searchBox->handleKeyEvent(key);
+
+    // Escape drops focus without submitting
+    if (isSearchOpen() && !searchBox->isFocused()) {
+        closeSearch();
+    }
+    return handled;
+}
+
+// Stand a few steps in front of an artwork, facing it
+void GameManager::teleportToResult(ArtworkSearchIndex::DocId doc) {
+    const float VIEW_DISTANCE = 3.0f;
+    const float* target = searchIndex.getPosition(doc);
+    const float* facing = searchIndex.getFacing(doc);
+
+    float cameraPos[3];
+    camera->getPosition(cameraPos);
+    float x = target[0] + facing[0] * VIEW_DISTANCE;
+    float z = target[2] + facing[1] * VIEW_DISTANCE;
+
+    // Forward is (sin yaw, -cos yaw); look back along the facing direction
+    float yaw = std::atan2(-facing[0], facing[1]) * 180.0f / static_cast<float>(M_PI);
+    camera->teleport(x, cameraPos[1], z, 0.0f, yaw);
+    gallery->resetCurrentRoom();
+    gallery->constrainCamera(camera);
+
+    std::cout << "Teleported to " << searchIndex.getTitle(doc) << std::endl;
+}
+
+// Search box and live results (screen space is already set up)
+void GameManager::renderSearchOverlay() {
+    const float BOX_WIDTH = 400.0f;
+    const float BOX_HEIGHT = 30.0f;
+    const float LINE_HEIGHT = 20.0f;
+
+    int width = glutGet(GLUT_WINDOW_WIDTH);
+    int height = glutGet(GLUT_WINDOW_HEIGHT);
+    float boxX = (width - BOX_WIDTH) / 2;
+    float boxY = height - 60.0f;
+
+    searchBox->setPosition(boxX, boxY);
+    searchBox->setSize(BOX_WIDTH, BOX_HEIGHT);
+    searchBox->render();
+
+    if (!searchResults.empty()) {
+        float listHeight = LINE_HEIGHT * searchResults.size() + 6.0f;
+        glColor4f(0.0f, 0.0f, 0.0f, 0.6f);
+        glBegin(GL_QUADS);
+        glVertex2f(boxX, boxY - listHeight);
+        glVertex2f(boxX + BOX_WIDTH, boxY - listHeight);
+        glVertex2f(boxX + BOX_WIDTH, boxY);
+        glVertex2f(boxX, boxY);
+        glEnd();
+
+        float normalColor[4] = { 0.85f, 0.85f, 0.85f, 1.0f };
+        float selectedColor[4] = { 1.0f, 0.85f, 0.3f, 1.0f };
+        for (size_t i = 0; i < searchResults.size(); i++) {
+            ArtworkSearchIndex::DocId doc = searchResults[i].doc;
+            std::string line = (static_cast<int>(i) == selectedResult ? "> " : "  ");
+            line += searchIndex.getTitle(doc);
+            if (searchIndex.getArtist(doc)[0] != '\0') {
+                line += " - ";
+                line += searchIndex.getArtist(doc);
+            }
+            if (searchIndex.getYear(doc) != 0) {
+                line += " (" + std::to_string(searchIndex.getYear(doc)) + ")";
+            }
+            renderText(boxX + 8.0f, boxY - LINE_HEIGHT * (i + 1), line,
+                static_cast<int>(i) == selectedResult ? selectedColor : normalColor);
+        }
+    }
+}
+
+// Print culling statistics of the last rendered frame
+void GameManager::printOcclusionStats() {
+    const OcclusionStats& stats = gallery->getOcclusionBuffer().getStats();
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Visibility (last frame):" << std::endl;
+    std::cout << "  Rooms rendered: " << gallery->getRoomsRendered() << std::endl;
+    std::cout << "  Artworks rendered: " << gallery->getArtworksRendered()
+              << ", frustum/portal culled: " << gallery->getArtworksCulled()
+              << ", occluded: " << gallery->getArtworksOccluded() << std::endl;
+    std::cout << "  Occluders: " << stats.occluders << " quads, " << stats.trianglesRasterized << " triangles" << std::endl;
+    std::cout << "  Occlusion pass: " << stats.rasterMs << " ms raster, " << stats.testMs << " ms tests ("
+              << stats.objectsTested << " tested)" << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+    std::cout.precision(precision);
 }
 
 // Print game controls
 void GameManager::printControls() {
+    const ActionMap& actions = ActionMap::getInstance();
     std::cout << "ArtSpace Room & Camera Demo" << std::endl;
-    std::cout << "Controls:" << std::endl;
-    std::cout << "  WASD - Move" << std::endl;
+    std::cout << "Controls (rebind with bind.<action>=<keys> lines in the config):" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::MoveForward) << " / " << actions.describe(InputAction::MoveLeft)
+              << " / " << actions.describe(InputAction::MoveBackward) << " / " << actions.describe(InputAction::MoveRight)
+              << " - Move" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::Run) << " - Run" << std::endl;
     std::cout << "  Mouse - Look around" << std::endl;
-    std::cout << "  F - Toggle wireframe mode" << std::endl;
-    std::cout << "  +/- - Adjust mouse sensitivity" << std::endl;
     std::cout << "  ESC - Exit" << std::endl;
     std::cout << std::endl;
     std::cout << "Artwork Rotation Controls:" << std::endl;
-    std::cout << "  k - Rotate closest artwork counterclockwise by 15 degrees" << std::endl;
-    std::cout << "  l - Rotate closest artwork clockwise by 15 degrees" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::RotateArtworkLeft)
+              << " - Rotate closest artwork counterclockwise by 15 degrees" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::RotateArtworkRight)
+              << " - Rotate closest artwork clockwise by 15 degrees" << std::endl;
     std::cout << std::endl;
     std::cout << "Win Condition:" << std::endl;
     std::cout << "  Rotate all artworks to be vertical (0 degrees rotation)" << std::endl;
     std::cout << std::endl;
     std::cout << "Stretching Controls (closest artwork):" << std::endl;
-    std::cout << "  x/X - Increase/decrease image width" << std::endl;
-    std::cout << "  y/Y - Increase/decrease image height" << std::endl;
-    std::cout << "  f/F - Increase/decrease frame width" << std::endl;
-    std::cout << "  g/G - Increase/decrease frame height" << std::endl;
-    std::cout << "  r/R - Reset image/frame stretching" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::ImageWider) << "/" << actions.describe(InputAction::ImageNarrower)
+              << " - Increase/decrease image width" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::ImageTaller) << "/" << actions.describe(InputAction::ImageShorter)
+              << " - Increase/decrease image height" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::FrameWider) << "/" << actions.describe(InputAction::FrameNarrower)
+              << " - Increase/decrease frame width" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::FrameTaller) << "/" << actions.describe(InputAction::FrameShorter)
+              << " - Increase/decrease frame height" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::ResetImage) << "/" << actions.describe(InputAction::ResetFrame)
+              << " - Reset image/frame stretching" << std::endl;
     
     // Add information about the closest artwork feature
     std::cout << std::endl;
     std::cout << "Proximity Features:" << std::endl;
     std::cout << "  The console will display the closest artwork to you as you move." << std::endl;
-    std::cout << "  Press 'p' to toggle detailed proximity debugging information." << std::endl;
+    std::cout << "  Press " << actions.describe(InputAction::ToggleProximityDebug)
+              << " to toggle detailed proximity debugging information." << std::endl;
+    std::cout << "  Press " << actions.describe(InputAction::ToggleOcclusion)
+              << " to toggle occlusion culling and print its statistics." << std::endl;
+    std::cout << "  " << actions.describe(InputAction::ToggleProfiler) << " - Toggle the frame profiler HUD, "
+              << actions.describe(InputAction::DumpProfiler) << " - Write profiler samples to CSV" << std::endl;
+    std::cout << "  " << actions.describe(InputAction::ToggleTrace)
+              << " - Start/stop a timeline trace (Chrome trace JSON)" << std::endl;
+    std::cout << "  Press " << actions.describe(InputAction::OpenSearch)
+              << " to search artworks; Tab picks a result, Enter teleports to it, Esc closes." << std::endl;
     std::cout << "  You must be within 25 units of an artwork to interact with it." << std::endl;
 }
 
 // Cleanup
 void GameManager::cleanup() {
+    // Keep a trace that is still running (e.g. started with --trace)
+    if (Tracer::getInstance().isEnabled()) {
+        toggleTrace();
+    }
+    
+    InputRecorder::getInstance().stop();
+    
+    if (InputLatency::getInstance().getSampleCount() > 0) {
+        LOG_INFO("Session {}", InputLatency::getInstance().describe());
+    }
+    
     // Clean up camera
     if (camera) {
         delete camera;
         camera = nullptr;
     }
 
-    // Clean up room
-    if (room) {
-        delete room;
+    // Unload paged artworks and stop the catalog loader
+    if (catalogPager) {
+        delete catalogPager;
+        catalogPager = nullptr;
+    }
+
+    // Clean up gallery (owns the rooms)
+    if (gallery) {
+        delete gallery;
+        gallery = nullptr;
         room = nullptr;
     }
     
-    // Clear the tracking vectors
-    artworkIndexToID.clear();
-    artworkRotations.clear();
+    // Profiler HUD
+    if (profilerHud) {
+        delete profilerHud;
+        profilerHud = nullptr;
+    }
+    
+    dynamicResolution.shutdown();
+    upscaleFilter.shutdown();
+    TextRenderer::getInstance().release();
+    overlayLayer.release();
+    if (sceneLayer) {
+        delete sceneLayer;
+        sceneLayer = nullptr;
+    }
+    
+    // Search box
+    if (searchBox) {
+        delete searchBox;
+        searchBox = nullptr;
+    }
+    searchIndex.clear();
+    
+    // Forget the tracked artwork and the pieces
+    closestArtwork = ArtworkHandle();
+    for (int i = 0; i < ARTWORK_COUNT; i++) {
+        pieceHandles[i] = ArtworkHandle();
+    }
     
     // Note: InputSystem and ArtworkManager are singletons and will 
     // be cleaned up by their own destructors when the program ends
@@ -708,54 +1596,45 @@ void GameManager::cleanup() {
 
 // Rotate closest artwork
 void GameManager::rotateClosestArtwork(float angle) {
-    if (closestArtworkID < 0 || closestArtworkDistance > 25.0f) {
+    if (!closestArtwork.isValid() || closestArtworkDistance > 25.0f) {
         // No artwork nearby or too far away
         std::cout << "Too far from artwork to rotate. Current distance: " 
                   << closestArtworkDistance << " units" << std::endl;
         return;
     }
     
-    // Find the artwork in the manager using our mapping
-    int artworkIndex = -1;
-    for (size_t i = 0; i < artworkIndexToID.size(); i++) {
-        if (artworkIndexToID[i] == closestArtworkID) {
-            artworkIndex = i;
-            break;
-        }
-    }
-    
-    if (artworkIndex >= 0 && artworkIndex < artworkManager->getArtworkCount()) {
-        Artwork* artwork = artworkManager->getArtwork(artworkIndex);
-        if (artwork) {
-            // Update our tracked rotation value
-            artworkRotations[artworkIndex] += angle;
-            
-            // Normalize angle to 0-360 range
-            while (artworkRotations[artworkIndex] < 0) artworkRotations[artworkIndex] += 360.0f;
-            while (artworkRotations[artworkIndex] >= 360.0f) artworkRotations[artworkIndex] -= 360.0f;
-            
-            // Apply rotation to the artwork
-            artwork->rotate(artworkRotations[artworkIndex], 0.0f, 0.0f, 1.0f);
-            
-            std::cout << "Rotated " << getArtworkName(closestArtworkID) << " by " << angle 
-                    << " degrees to " << artworkRotations[artworkIndex] << " degrees" << std::endl;
-            
-            // Check if win condition is met
-            if (checkWinCondition()) {
-                gameWon = true;
-                winTimer = 0.0f;
-                std::cout << "\n\nYOU WIN!\n\n" << std::endl;
-                std::cout << "All artworks are now properly aligned. Closing in 3 seconds..." << std::endl;
-            }
+    // O(1) handle lookup; a stale handle (artwork removed) simply yields nullptr
+    Artwork* artwork = artworkManager->getArtwork(closestArtwork);
+    if (artwork) {
+        // Normalize angle to 0-360 range
+        float rotation = artwork->getRotationAngle() + angle;
+        while (rotation < 0) rotation += 360.0f;
+        while (rotation >= 360.0f) rotation -= 360.0f;
+        
+        // Apply rotation to the artwork
+        artwork->rotate(rotation, 0.0f, 0.0f, 1.0f);
+        
+        std::cout << "Rotated " << artworkManager->getArtworkName(closestArtwork) << " by " << angle 
+                << " degrees to " << rotation << " degrees" << std::endl;
+        
+        // Check if win condition is met
+        if (checkWinCondition()) {
+            gameWon = true;
+            winTimer = 0.0f;
+            std::cout << "\n\nYOU WIN!\n\n" << std::endl;
+            std::cout << "All artworks are now properly aligned. Closing in 3 seconds..." << std::endl;
         }
     }
 }
 
-// Check if all artworks are at 0 rotation (vertically aligned)
+// Check if all game pieces are at 0 rotation (vertically aligned)
 bool GameManager::checkWinCondition() {
-    for (size_t i = 0; i < artworkRotations.size(); i++) {
+    for (int i = 0; i < ARTWORK_COUNT; i++) {
+        Artwork* artwork = artworkManager->getArtwork(pieceHandles[i]);
+        if (!artwork) continue;
+        
         // Normalize angle to 0-360 range
-        float angle = artworkRotations[i];
+        float angle = artwork->getRotationAngle();
         while (angle < 0) angle += 360.0f;
         while (angle >= 360.0f) angle -= 360.0f;
         
@@ -776,6 +1655,7 @@ void GameManager::handleWinState(float deltaTime) {
     // After 3 seconds, exit the game
     if (winTimer >= 3.0f) {
         std::cout << "Game completed successfully!" << std::endl;
+        InputRecorder::getInstance().stop();
         exit(0);
     }
 } 
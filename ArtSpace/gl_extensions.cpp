@@ -0,0 +1,97 @@
+#include "gl_extensions.h"
+#include <GL/freeglut_ext.h>
+#include "utility.h"
+#include <cstdio>
+#include <cstring>
+
+GLExtensions glext = {};
+
+// Core name first, then the extension's suffixed name
+template <typename Proc>
+static bool loadProc(Proc& proc, const char* name, const char* suffix) {
+    proc = reinterpret_cast<Proc>(glutGetProcAddress(name));
+    if (!proc) {
+        std::string suffixed = std::string(name) + suffix;
+        proc = reinterpret_cast<Proc>(glutGetProcAddress(suffixed.c_str()));
+    }
+    return proc != nullptr;
+}
+
+void loadGLExtensions() {
+    if (glext.loaded) return;
+    glext.loaded = true;
+
+    // "major.minor[.release] [vendor info]"
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (!version || sscanf(version, "%d.%d", &glext.versionMajor, &glext.versionMinor) != 2) {
+        glext.versionMajor = 1;
+        glext.versionMinor = 1;
+    }
+    glext.textureLevels = glext.versionMajor > 1 || glext.versionMinor >= 4;
+
+    glext.separateBlend = (glext.versionMajor > 1 || glext.versionMinor >= 4 || hasGLExtension("GL_EXT_blend_func_separate")) &&
+        loadProc(glext.blendFuncSeparate, "glBlendFuncSeparate", "EXT");
+
+    bool fbo = true;
+    fbo &= loadProc(glext.genFramebuffers, "glGenFramebuffers", "EXT");
+    fbo &= loadProc(glext.deleteFramebuffers, "glDeleteFramebuffers", "EXT");
+    fbo &= loadProc(glext.bindFramebuffer, "glBindFramebuffer", "EXT");
+    fbo &= loadProc(glext.framebufferTexture2D, "glFramebufferTexture2D", "EXT");
+    fbo &= loadProc(glext.checkFramebufferStatus, "glCheckFramebufferStatus", "EXT");
+    fbo &= loadProc(glext.genRenderbuffers, "glGenRenderbuffers", "EXT");
+    fbo &= loadProc(glext.deleteRenderbuffers, "glDeleteRenderbuffers", "EXT");
+    fbo &= loadProc(glext.bindRenderbuffer, "glBindRenderbuffer", "EXT");
+    fbo &= loadProc(glext.renderbufferStorage, "glRenderbufferStorage", "EXT");
+    fbo &= loadProc(glext.framebufferRenderbuffer, "glFramebufferRenderbuffer", "EXT");
+    glext.framebufferObjects = fbo;
+
+    // Entry points can resolve on drivers that lack the feature: check the version too
+    bool timer = (glext.versionMajor > 3 || (glext.versionMajor == 3 && glext.versionMinor >= 3)) ||
+        hasGLExtension("GL_ARB_timer_query") || hasGLExtension("GL_EXT_timer_query");
+    timer &= loadProc(glext.genQueries, "glGenQueries", "ARB");
+    timer &= loadProc(glext.deleteQueries, "glDeleteQueries", "ARB");
+    timer &= loadProc(glext.beginQuery, "glBeginQuery", "ARB");
+    timer &= loadProc(glext.endQuery, "glEndQuery", "ARB");
+    timer &= loadProc(glext.getQueryObjectiv, "glGetQueryObjectiv", "ARB");
+    timer &= loadProc(glext.getQueryObjectui64v, "glGetQueryObjectui64v", "EXT");
+    glext.timerQueries = timer;
+
+    bool glsl = glext.versionMajor >= 2;
+    glsl &= loadProc(glext.createShader, "glCreateShader", "ARB");
+    glsl &= loadProc(glext.deleteShader, "glDeleteShader", "ARB");
+    glsl &= loadProc(glext.shaderSource, "glShaderSource", "ARB");
+    glsl &= loadProc(glext.compileShader, "glCompileShader", "ARB");
+    glsl &= loadProc(glext.getShaderiv, "glGetShaderiv", "ARB");
+    glsl &= loadProc(glext.getShaderInfoLog, "glGetShaderInfoLog", "ARB");
+    glsl &= loadProc(glext.createProgram, "glCreateProgram", "ARB");
+    glsl &= loadProc(glext.deleteProgram, "glDeleteProgram", "ARB");
+    glsl &= loadProc(glext.attachShader, "glAttachShader", "ARB");
+    glsl &= loadProc(glext.linkProgram, "glLinkProgram", "ARB");
+    glsl &= loadProc(glext.getProgramiv, "glGetProgramiv", "ARB");
+    glsl &= loadProc(glext.getProgramInfoLog, "glGetProgramInfoLog", "ARB");
+    glsl &= loadProc(glext.useProgram, "glUseProgram", "ARB");
+    glsl &= loadProc(glext.getUniformLocation, "glGetUniformLocation", "ARB");
+    glsl &= loadProc(glext.uniform1i, "glUniform1i", "ARB");
+    glsl &= loadProc(glext.uniform1f, "glUniform1f", "ARB");
+    glsl &= loadProc(glext.uniform2f, "glUniform2f", "ARB");
+    glext.shaders = glsl;
+
+    const char* renderer = reinterpret_cast<const char*>(glGetString(GL_RENDERER));
+    Logger::getInstance().logInfo(std::string("OpenGL ") + (version ? version : "?") + " on " +
+        (renderer ? renderer : "?") + (fbo ? "" : " - framebuffer objects unavailable") +
+        (timer ? "" : " - no GPU timer queries") + (glsl ? "" : " - no shaders"));
+}
+
+bool hasGLExtension(const char* name) {
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!extensions) return false;
+
+    // Whole words only: "GL_EXT_foo" must not match "GL_EXT_foo_bar"
+    size_t length = strlen(name);
+    for (const char* found = strstr(extensions, name); found; found = strstr(found + length, name)) {
+        bool starts = found == extensions || found[-1] == ' ';
+        bool ends = found[length] == ' ' || found[length] == '\0';
+        if (starts && ends) return true;
+    }
+    return false;
+}
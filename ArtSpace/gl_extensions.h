@@ -0,0 +1,170 @@
+/**
+ * @file gl_extensions.h
+ * @brief Entry points above OpenGL 1.1, resolved at run time
+ *
+ * The Windows OpenGL headers stop at version 1.1; anything newer has to be
+ * looked up from the driver once a context exists. loadGLExtensions() does
+ * that through glutGetProcAddress. It tries the core name first and then the
+ * EXT/ARB name, and records which feature sets are complete. Callers check a
+ * feature flag and fall back to plain 1.1 rendering when it is missing.
+ *
+ * Usage:
+ *    glutCreateWindow(...);
+ *    loadGLExtensions();
+ *
+ *    if (glext.framebufferObjects) {
+ *        glext.genFramebuffers(1, &framebuffer);
+ *        glext.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+ *    }
+ */
+
+#pragma once
+#include <GL/glut.h>
+#include <cstdint>
+
+#ifndef APIENTRY
+#define APIENTRY
+#endif
+
+// Framebuffer objects (GL 3.0 / EXT_framebuffer_object)
+#ifndef GL_FRAMEBUFFER
+#define GL_FRAMEBUFFER                  0x8D40
+#define GL_RENDERBUFFER                 0x8D41
+#define GL_COLOR_ATTACHMENT0            0x8CE0
+#define GL_DEPTH_ATTACHMENT             0x8D00
+#define GL_FRAMEBUFFER_COMPLETE         0x8CD5
+#endif
+#ifndef GL_DEPTH_COMPONENT24
+#define GL_DEPTH_COMPONENT24            0x81A6
+#endif
+#ifndef GL_CLAMP_TO_EDGE
+#define GL_CLAMP_TO_EDGE                0x812F
+#endif
+
+// Texture level control (GL 1.2 / 1.4)
+#ifndef GL_TEXTURE_BASE_LEVEL
+#define GL_TEXTURE_BASE_LEVEL           0x813C
+#endif
+#ifndef GL_GENERATE_MIPMAP
+#define GL_GENERATE_MIPMAP              0x8191
+#endif
+#ifndef GL_TEXTURE_LOD_BIAS
+#define GL_TEXTURE_LOD_BIAS             0x8501
+#endif
+
+// Timer queries (GL 3.3 / ARB_timer_query / EXT_timer_query)
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED                 0x88BF
+#endif
+#ifndef GL_QUERY_RESULT
+#define GL_QUERY_RESULT                 0x8866
+#define GL_QUERY_RESULT_AVAILABLE       0x8867
+#endif
+
+// Shaders (GL 2.0)
+#ifndef GL_FRAGMENT_SHADER
+#define GL_FRAGMENT_SHADER              0x8B30
+#define GL_COMPILE_STATUS               0x8B81
+#define GL_LINK_STATUS                  0x8B82
+#endif
+
+typedef void (APIENTRY* GLGenFramebuffersProc)(GLsizei count, GLuint* framebuffers);
+typedef void (APIENTRY* GLDeleteFramebuffersProc)(GLsizei count, const GLuint* framebuffers);
+typedef void (APIENTRY* GLBindFramebufferProc)(GLenum target, GLuint framebuffer);
+typedef void (APIENTRY* GLFramebufferTexture2DProc)(GLenum target, GLenum attachment, GLenum textureTarget, GLuint texture, GLint level);
+typedef GLenum (APIENTRY* GLCheckFramebufferStatusProc)(GLenum target);
+typedef void (APIENTRY* GLGenRenderbuffersProc)(GLsizei count, GLuint* renderbuffers);
+typedef void (APIENTRY* GLDeleteRenderbuffersProc)(GLsizei count, const GLuint* renderbuffers);
+typedef void (APIENTRY* GLBindRenderbufferProc)(GLenum target, GLuint renderbuffer);
+typedef void (APIENTRY* GLRenderbufferStorageProc)(GLenum target, GLenum format, GLsizei width, GLsizei height);
+typedef void (APIENTRY* GLFramebufferRenderbufferProc)(GLenum target, GLenum attachment, GLenum renderbufferTarget, GLuint renderbuffer);
+
+typedef void (APIENTRY* GLBlendFuncSeparateProc)(GLenum sourceRGB, GLenum destinationRGB, GLenum sourceAlpha, GLenum destinationAlpha);
+
+typedef void (APIENTRY* GLGenQueriesProc)(GLsizei count, GLuint* queries);
+typedef void (APIENTRY* GLDeleteQueriesProc)(GLsizei count, const GLuint* queries);
+typedef void (APIENTRY* GLBeginQueryProc)(GLenum target, GLuint query);
+typedef void (APIENTRY* GLEndQueryProc)(GLenum target);
+typedef void (APIENTRY* GLGetQueryObjectivProc)(GLuint query, GLenum name, GLint* value);
+typedef void (APIENTRY* GLGetQueryObjectui64vProc)(GLuint query, GLenum name, uint64_t* value);
+
+typedef GLuint (APIENTRY* GLCreateShaderProc)(GLenum type);
+typedef void (APIENTRY* GLDeleteShaderProc)(GLuint shader);
+typedef void (APIENTRY* GLShaderSourceProc)(GLuint shader, GLsizei count, const char* const* sources, const GLint* lengths);
+typedef void (APIENTRY* GLCompileShaderProc)(GLuint shader);
+typedef void (APIENTRY* GLGetShaderivProc)(GLuint shader, GLenum name, GLint* value);
+typedef void (APIENTRY* GLGetShaderInfoLogProc)(GLuint shader, GLsizei size, GLsizei* length, char* log);
+typedef GLuint (APIENTRY* GLCreateProgramProc)();
+typedef void (APIENTRY* GLDeleteProgramProc)(GLuint program);
+typedef void (APIENTRY* GLAttachShaderProc)(GLuint program, GLuint shader);
+typedef void (APIENTRY* GLLinkProgramProc)(GLuint program);
+typedef void (APIENTRY* GLGetProgramivProc)(GLuint program, GLenum name, GLint* value);
+typedef void (APIENTRY* GLGetProgramInfoLogProc)(GLuint program, GLsizei size, GLsizei* length, char* log);
+typedef void (APIENTRY* GLUseProgramProc)(GLuint program);
+typedef GLint (APIENTRY* GLGetUniformLocationProc)(GLuint program, const char* name);
+typedef void (APIENTRY* GLUniform1iProc)(GLint location, GLint value);
+typedef void (APIENTRY* GLUniform1fProc)(GLint location, GLfloat value);
+typedef void (APIENTRY* GLUniform2fProc)(GLint location, GLfloat x, GLfloat y);
+
+struct GLExtensions {
+    bool loaded;
+    int versionMajor;
+    int versionMinor;
+
+    // Driver-generated mipmaps, base level and LOD bias texture parameters (GL 1.4)
+    bool textureLevels;
+
+    // Different blend factors for color and alpha (GL 1.4 / EXT_blend_func_separate)
+    bool separateBlend;
+    GLBlendFuncSeparateProc blendFuncSeparate;
+
+    // Framebuffer objects
+    bool framebufferObjects;
+    GLGenFramebuffersProc genFramebuffers;
+    GLDeleteFramebuffersProc deleteFramebuffers;
+    GLBindFramebufferProc bindFramebuffer;
+    GLFramebufferTexture2DProc framebufferTexture2D;
+    GLCheckFramebufferStatusProc checkFramebufferStatus;
+    GLGenRenderbuffersProc genRenderbuffers;
+    GLDeleteRenderbuffersProc deleteRenderbuffers;
+    GLBindRenderbufferProc bindRenderbuffer;
+    GLRenderbufferStorageProc renderbufferStorage;
+    GLFramebufferRenderbufferProc framebufferRenderbuffer;
+
+    // GPU timer queries
+    bool timerQueries;
+    GLGenQueriesProc genQueries;
+    GLDeleteQueriesProc deleteQueries;
+    GLBeginQueryProc beginQuery;
+    GLEndQueryProc endQuery;
+    GLGetQueryObjectivProc getQueryObjectiv;
+    GLGetQueryObjectui64vProc getQueryObjectui64v;
+
+    // GLSL programs (fragment-only programs keep the fixed-function vertex stage)
+    bool shaders;
+    GLCreateShaderProc createShader;
+    GLDeleteShaderProc deleteShader;
+    GLShaderSourceProc shaderSource;
+    GLCompileShaderProc compileShader;
+    GLGetShaderivProc getShaderiv;
+    GLGetShaderInfoLogProc getShaderInfoLog;
+    GLCreateProgramProc createProgram;
+    GLDeleteProgramProc deleteProgram;
+    GLAttachShaderProc attachShader;
+    GLLinkProgramProc linkProgram;
+    GLGetProgramivProc getProgramiv;
+    GLGetProgramInfoLogProc getProgramInfoLog;
+    GLUseProgramProc useProgram;
+    GLGetUniformLocationProc getUniformLocation;
+    GLUniform1iProc uniform1i;
+    GLUniform1fProc uniform1f;
+    GLUniform2fProc uniform2f;
+};
+
+extern GLExtensions glext;
+
+// Resolve the entry points; needs a current GL context. Safe to call again.
+void loadGLExtensions();
+
+// Whether the driver lists the extension (e.g. "GL_ARB_timer_query")
+bool hasGLExtension(const char* name);
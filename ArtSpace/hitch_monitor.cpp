@@ -0,0 +1,142 @@
+#include "hitch_monitor.h"
+#include "profiler.h"
+#include "logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+
+// Frame times listed in a report
+static const int REPORT_FRAME_HISTORY = 60;
+
+HitchMonitor HitchMonitor::instance;
+
+HitchMonitor::HitchMonitor()
+    : eventHead(0)
+    , enabled(true)
+    , budgetMs(100.0f)
+    , windowMs(1000.0f)
+    , cooldownMs(5000.0f)
+    , maxReports(50)
+    , lastReportTime(0)
+    , reportsWritten(0)
+    , hitchesDetected(0) {
+}
+
+HitchMonitor& HitchMonitor::getInstance() {
+    return instance;
+}
+
+void HitchMonitor::noteEvent(const char* category, const std::string& text) {
+    noteEvent(category, text, std::chrono::steady_clock::now());
+}
+
+void HitchMonitor::noteEvent(const char* category, const std::string& text, std::chrono::steady_clock::time_point when) {
+    // Back to the profiler clock, which counts from its own origin
+    int64_t age = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - when).count();
+    uint64_t now = Profiler::now();
+    uint64_t timestamp = age > 0 && static_cast<uint64_t>(age) < now ? now - age : now;
+    std::lock_guard<std::mutex> lock(eventMutex);
+    if (events.size() < EVENT_CAPACITY) {
+        events.push_back(Event{ timestamp, category, text });
+    }
+    else {
+        events[eventHead] = Event{ timestamp, category, text };
+        eventHead = (eventHead + 1) % EVENT_CAPACITY;
+    }
+}
+
+void HitchMonitor::endFrame() {
+    float frameMs = Profiler::getInstance().getLastFrameMs();
+    if (!enabled || frameMs <= budgetMs) return;
+
+    hitchesDetected++;
+    uint64_t frameEnd = Profiler::now();
+
+    // Writing a report is itself slow; don't chase our own tail
+    if (reportsWritten >= maxReports) return;
+    if (lastReportTime != 0 && (frameEnd - lastReportTime) / 1000000.0f < cooldownMs) return;
+
+    // Log lines still queued for the writer belong in the report
+    Logger::getInstance().flush();
+    writeReport(frameMs, frameEnd);
+    lastReportTime = Profiler::now();
+}
+
+bool HitchMonitor::writeReport(float frameMs, uint64_t frameEnd) {
+    Profiler& profiler = Profiler::getInstance();
+
+    std::time_t now = std::time(nullptr);
+    struct tm timeInfo;
+#ifdef _WIN32
+    localtime_s(&timeInfo, &now);
+#else
+    localtime_r(&now, &timeInfo);
+#endif
+
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", &timeInfo);
+    std::string path = reportDirectory;
+    if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+        path += '/';
+    }
+    path += "hitch_" + std::string(stamp) + "_f" + std::to_string(profiler.getFrameIndex()) + ".txt";
+
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        Logger::getInstance().logError("HitchMonitor - cannot write report " + path);
+        return false;
+    }
+
+    uint64_t frameStart = frameEnd - static_cast<uint64_t>(frameMs * 1000000.0);
+    uint64_t windowStart = frameStart - std::min(frameStart, static_cast<uint64_t>(windowMs * 1000000.0));
+
+    char line[256];
+    strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &timeInfo);
+    file << "ArtSpace hitch report\n";
+    file << "Time: " << stamp << "\n";
+    snprintf(line, sizeof(line), "Frame %u took %.2f ms (budget %.2f ms); window: %.0f ms before it\n\n",
+        profiler.getFrameIndex(), frameMs, budgetMs, windowMs);
+    file << line;
+
+    // Where the hitch frame spent its time
+    std::vector<Profiler::SectionStats> sections;
+    profiler.getSectionStats(sections);
+    file << "[Sections] hitch frame / average / p99 (ms)\n";
+    for (const Profiler::SectionStats& section : sections) {
+        snprintf(line, sizeof(line), "  %-20s %9.3f %9.3f %9.3f\n",
+            section.name.c_str(), section.last, section.average, section.p99);
+        file << line;
+    }
+
+    std::vector<float> history;
+    profiler.getFrameHistory(history);
+    file << "\n[Recent frame times] (ms, oldest first)\n ";
+    size_t firstFrame = history.size() > REPORT_FRAME_HISTORY ? history.size() - REPORT_FRAME_HISTORY : 0;
+    for (size_t i = firstFrame; i < history.size(); i++) {
+        snprintf(line, sizeof(line), " %.1f", history[i]);
+        file << line;
+    }
+    file << "\n\n";
+
+    // Log lines and asset loads, relative to the start of the hitch frame
+    file << "[Events] (ms relative to the start of the hitch frame)\n";
+    {
+        std::lock_guard<std::mutex> lock(eventMutex);
+        for (size_t i = 0; i < events.size(); i++) {
+            const Event& event = events[(eventHead + i) % events.size()];
+            if (event.timestamp < windowStart) continue;
+
+            double offset = (static_cast<double>(event.timestamp) - static_cast<double>(frameStart)) / 1000000.0;
+            snprintf(line, sizeof(line), "  %+9.2f  %-6s ", offset, event.category);
+            file << line << event.text << "\n";
+        }
+    }
+
+    file << "\n[Profiler samples]\n";
+    profiler.writeSamples(file, windowStart);
+
+    reportsWritten++;
+    LOG_WARN("Frame took {:.0f} ms, hitch report written to {}", frameMs, path);
+    return true;
+}
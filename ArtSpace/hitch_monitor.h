@@ -0,0 +1,89 @@
+/**
+ * @file hitch_monitor.h
+ * @brief Detects frames over budget and writes a report of the second that led up to them
+ *
+ * The HitchMonitor keeps a rolling window of recent events (log lines and
+ * asset loads, from any thread) and relies on the profiler's capture buffer
+ * for the timed scopes. When a frame takes longer than the budget, it writes
+ * a timestamped text report with:
+ * - the hitch frame's per-section times and the recent frame times,
+ * - every event from the window before the hitch,
+ * - the profiler samples of that window as CSV.
+ *
+ * A cooldown and a per-session cap stop a sustained stall from filling the
+ * disk, so the monitor can stay on in unattended kiosks.
+ *
+ * Usage:
+ *    HitchMonitor::getInstance().setBudgetMs(50.0f);
+ *    HitchMonitor::getInstance().noteEvent("asset", "Decoded " + path);
+ *
+ *    // Once per frame, after Profiler::endFrame():
+ *    HitchMonitor::getInstance().endFrame();
+ */
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class HitchMonitor {
+private:
+    struct Event {
+        uint64_t timestamp;     // Profiler::now() clock
+        const char* category;   // String literal: "log", "asset"...
+        std::string text;
+    };
+
+    static HitchMonitor instance;
+    static constexpr size_t EVENT_CAPACITY = 2048;
+
+    // Rolling event window (any thread)
+    std::mutex eventMutex;
+    std::vector<Event> events;
+    size_t eventHead;
+
+    bool enabled;
+    float budgetMs;
+    float windowMs;             // History written before the hitch frame
+    float cooldownMs;           // Minimum time between two reports
+    int maxReports;             // Per session
+    std::string reportDirectory;
+
+    uint64_t lastReportTime;
+    int reportsWritten;
+    int hitchesDetected;
+
+    HitchMonitor();
+
+    bool writeReport(float frameMs, uint64_t frameEnd);
+
+public:
+    HitchMonitor(const HitchMonitor&) = delete;
+    HitchMonitor& operator=(const HitchMonitor&) = delete;
+
+    static HitchMonitor& getInstance();
+
+    // Remember something that happened (thread-safe)
+    void noteEvent(const char* category, const std::string& text);
+    // Same, for something that happened earlier (e.g. a log line written later)
+    void noteEvent(const char* category, const std::string& text, std::chrono::steady_clock::time_point when);
+
+    // Check the frame the profiler just closed (main thread)
+    void endFrame();
+
+    // Settings
+    void setEnabled(bool enable) { enabled = enable; }
+    bool isEnabled() const { return enabled; }
+    void setBudgetMs(float milliseconds) { budgetMs = milliseconds; }
+    float getBudgetMs() const { return budgetMs; }
+    void setWindowMs(float milliseconds) { windowMs = milliseconds; }
+    void setCooldownMs(float milliseconds) { cooldownMs = milliseconds; }
+    void setMaxReports(int count) { maxReports = count; }
+    void setReportDirectory(const std::string& directory) { reportDirectory = directory; }
+
+    // Statistics
+    int getHitchesDetected() const { return hitchesDetected; }
+    int getReportsWritten() const { return reportsWritten; }
+};
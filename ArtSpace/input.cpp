@@ -1,9 +1,15 @@
 #include "input.h"
+#include "input_latency.h"
+#include "logger.h"
+#include "profiler.h"
 #include <cstring>
 
 // Initialize static member
 InputSystem* InputSystem::instance = nullptr;
 
+// A warp whose motion event has not arrived by then is taken as done
+static const uint64_t WARP_TIMEOUT_NS = 100000000ull;
+
 // Static callback functions for GLUT integration
 void keyboardCallback(unsigned char key, int x, int y) {
     InputSystem::getInstance()->handleKeyPress(key, x, y);
@@ -33,20 +39,42 @@ void passiveMotionCallback(int x, int y) {
     InputSystem::getInstance()->handlePassiveMouseMotion(x, y);
 }
 
+void entryCallback(int state) {
+    InputSystem::getInstance()->handleWindowEntry(state);
+}
+
 // Constructor
 InputSystem::InputSystem() {
     // Initialize mouse button states to false (not pressed)
     memset(mouseButtonStates, 0, sizeof(mouseButtonStates));
     memset(keyStates, 0, sizeof(keyStates));
     memset(specialKeyStates, 0, sizeof(specialKeyStates));
+    memset(keyTapped, 0, sizeof(keyTapped));
+    memset(specialKeyTapped, 0, sizeof(specialKeyTapped));
     
-    lastMouseX = 0.0f;
-    lastMouseY = 0.0f;
     currentMouseX = 0.0f;
     currentMouseY = 0.0f;
+    hasMousePosition = false;
+    mouseDeltaX = 0.0f;
+    mouseDeltaY = 0.0f;
     
     isDragging = false;
     isRotating = false;
+    
+    stepEvents.reserve(InputEventQueue::CAPACITY);
+    lastEventTime = 0;
+    
+    relativeMouse = false;
+    pointerInWindow = true;
+    pointerKnown = false;
+    pointerX = 0;
+    pointerY = 0;
+    warpPending = false;
+    warpX = 0;
+    warpY = 0;
+    warpTime = 0;
+    
+    liveInput = true;
 }
 
 // Get singleton instance
@@ -66,97 +94,266 @@ void InputSystem::registerCallbacks() {
     glutMouseFunc(mouseCallback);
     glutMotionFunc(motionCallback);
     glutPassiveMotionFunc(passiveMotionCallback);
+    glutEntryFunc(entryCallback);
+}
+
+void InputSystem::push(InputEvent::Type type, int code, int x, int y) {
+    if (!liveInput) return;
+    InputEvent event;
+    event.type = type;
+    event.code = code;
+    event.x = x;
+    event.y = y;
+    event.time = Profiler::now();
+    event.latched = false;
+    queue.push(event);
 }
 
 // Handle keyboard press events
 void InputSystem::handleKeyPress(unsigned char key, int x, int y) {
-    keyStates[key] = true;
+    push(InputEvent::KeyDown, key, x, y);
 }
 
 // Handle keyboard release events
 void InputSystem::handleKeyRelease(unsigned char key, int x, int y) {
-    keyStates[key] = false;
+    push(InputEvent::KeyUp, key, x, y);
 }
 
 // Handle special key press events
 void InputSystem::handleSpecialKeyPress(int key, int x, int y) {
     if (key >= 0 && key < 256) {
-        specialKeyStates[key] = true;
+        push(InputEvent::SpecialKeyDown, key, x, y);
     }
 }
 
 // Handle special key release events
 void InputSystem::handleSpecialKeyRelease(int key, int x, int y) {
     if (key >= 0 && key < 256) {
-        specialKeyStates[key] = false;
+        push(InputEvent::SpecialKeyUp, key, x, y);
     }
 }
 
 // Handle mouse button events
 void InputSystem::handleMouseButton(int button, int state, int x, int y) {
     if (button >= 0 && button < 3) {
-        // GLUT_DOWN = 0, GLUT_UP = 1, so we invert it for our boolean state
-        mouseButtonStates[button] = (state == GLUT_DOWN);
-        
-        // Update mouse position
-        currentMouseX = static_cast<float>(x);
-        currentMouseY = static_cast<float>(y);
-        
-        // If left button is pressed, we're starting a drag operation
-        if (button == GLUT_LEFT_BUTTON) {
-            isDragging = mouseButtonStates[button];
-        }
-        
-        // If right button is pressed, we're starting a rotation operation
-        if (button == GLUT_RIGHT_BUTTON) {
-            isRotating = mouseButtonStates[button];
-        }
+        pushPointer(state == GLUT_DOWN ? InputEvent::ButtonDown : InputEvent::ButtonUp, button, x, y);
     }
 }
 
 // Handle mouse motion events (when button is pressed)
 void InputSystem::handleMouseMotion(int x, int y) {
-    // Save last position before updating
-    lastMouseX = currentMouseX;
-    lastMouseY = currentMouseY;
-    
-    // Update current position
-    currentMouseX = static_cast<float>(x);
-    currentMouseY = static_cast<float>(y);
+    pushPointer(InputEvent::Motion, 0, x, y);
 }
 
 // Handle passive mouse motion events (when no button is pressed)
 void InputSystem::handlePassiveMouseMotion(int x, int y) {
-    // Save last position before updating
-    lastMouseX = currentMouseX;
-    lastMouseY = currentMouseY;
+    pushPointer(InputEvent::Motion, 0, x, y);
+}
+
+// Handle a key typed into a text field
+void InputSystem::handleTextInput(unsigned char key) {
+    push(InputEvent::Text, key, 0, 0);
+}
+
+// Handle the pointer entering or leaving the window; outside it the pointer is left alone
+void InputSystem::handleWindowEntry(int state) {
+    pointerInWindow = state == GLUT_ENTERED;
+}
+
+// Queue an event that carries the pointer position, recognizing the echo of our own warp
+void InputSystem::pushPointer(InputEvent::Type type, int code, int x, int y) {
+    if (warpPending) {
+        if (type == InputEvent::Motion && x == warpX && y == warpY) {
+            warpPending = false;
+            push(InputEvent::Warp, 0, x, y);
+            pointerKnown = true;
+            pointerX = x;
+            pointerY = y;
+            return;
+        }
+        // The echo never came; the pointer is at the warp target regardless
+        if (Profiler::now() - warpTime > WARP_TIMEOUT_NS) {
+            warpPending = false;
+            push(InputEvent::Warp, 0, warpX, warpY);
+        }
+    }
+    
+    push(type, code, x, y);
+    pointerKnown = true;
+    pointerX = x;
+    pointerY = y;
+}
+
+void InputSystem::setRelativeMouse(bool enable) {
+    if (relativeMouse == enable) return;
+    relativeMouse = enable;
+    glutSetCursor(enable ? GLUT_CURSOR_NONE : GLUT_CURSOR_INHERIT);
+    if (enable) {
+        centerPointer();
+    }
+}
+
+void InputSystem::warpPointer(int x, int y) {
+    glutWarpPointer(x, y);
+    warpPending = true;
+    warpX = x;
+    warpY = y;
+    warpTime = Profiler::now();
+}
+
+void InputSystem::centerPointer() {
+    warpPointer(glutGet(GLUT_WINDOW_WIDTH) / 2, glutGet(GLUT_WINDOW_HEIGHT) / 2);
+}
+
+// Warp only after real motion, so a still mouse costs no events
+void InputSystem::recenterPointer() {
+    if (!relativeMouse || !liveInput || !pointerInWindow || !pointerKnown || warpPending) return;
+    int centerX = glutGet(GLUT_WINDOW_WIDTH) / 2;
+    int centerY = glutGet(GLUT_WINDOW_HEIGHT) / 2;
+    if (pointerX != centerX || pointerY != centerY) {
+        warpPointer(centerX, centerY);
+    }
+}
+
+// Apply the events that arrived up to the given time, in order
+void InputSystem::update(uint64_t until) {
+    memset(keyTapped, 0, sizeof(keyTapped));
+    memset(specialKeyTapped, 0, sizeof(specialKeyTapped));
+    stepEvents.clear();
+    
+    while (const InputEvent* event = queue.peek()) {
+        if (event->time > until) break;
+        apply(*event);
+        if (liveInput && !event->latched && event->type != InputEvent::Warp) {
+            InputLatency::getInstance().noteConsumed(event->time, event->type == InputEvent::Motion);
+        }
+        stepEvents.push_back(*event);
+        lastEventTime = event->time;
+        queue.pop();
+    }
     
-    // Update current position
-    currentMouseX = static_cast<float>(x);
-    currentMouseY = static_cast<float>(y);
+    uint64_t dropped = queue.takeDropped();
+    if (dropped > 0) {
+        LOG_WARN("Input queue full, {} events dropped", dropped);
+    }
 }
 
-// Update method to be called each frame
-void InputSystem::update() {
-    // Any per-frame logic can go here
+// Take the motion of the events still queued, leaving the events themselves for update()
+bool InputSystem::latchMouseDelta(float& deltaX, float& deltaY) {
+    deltaX = 0.0f;
+    deltaY = 0.0f;
+    bool moved = false;
+    bool known = hasMousePosition;
+    float x = currentMouseX;
+    float y = currentMouseY;
     
-    // Mouse delta is now reset in getMouseDelta() method
+    for (size_t i = 0; InputEvent* event = queue.at(i); i++) {
+        bool mouseEvent = event->type == InputEvent::Motion || event->type == InputEvent::ButtonDown ||
+            event->type == InputEvent::ButtonUp;
+        if (!mouseEvent && event->type != InputEvent::Warp) continue;
+        
+        float eventX = static_cast<float>(event->x);
+        float eventY = static_cast<float>(event->y);
+        if (mouseEvent && !event->latched) {
+            if (known) {
+                deltaX += eventX - x;
+                deltaY += eventY - y;
+                moved = true;
+            }
+            event->latched = true;
+            InputLatency::getInstance().noteConsumed(event->time, event->type == InputEvent::Motion);
+        }
+        known = true;
+        x = eventX;
+        y = eventY;
+    }
+    return moved && (deltaX != 0.0f || deltaY != 0.0f);
+}
+
+void InputSystem::apply(const InputEvent& event) {
+    // Mouse events carry the pointer position; any change is motion (unless already latched)
+    bool mouseEvent = event.type == InputEvent::Motion || event.type == InputEvent::ButtonDown ||
+        event.type == InputEvent::ButtonUp;
+    if (mouseEvent) {
+        float x = static_cast<float>(event.x);
+        float y = static_cast<float>(event.y);
+        if (hasMousePosition && !event.latched) {
+            mouseDeltaX += x - currentMouseX;
+            mouseDeltaY += y - currentMouseY;
+        }
+        hasMousePosition = true;
+        currentMouseX = x;
+        currentMouseY = y;
+    }
+    
+    // A warp moves the point deltas are taken from, without any motion
+    if (event.type == InputEvent::Warp) {
+        hasMousePosition = true;
+        currentMouseX = static_cast<float>(event.x);
+        currentMouseY = static_cast<float>(event.y);
+    }
+    
+    switch (event.type) {
+    case InputEvent::KeyDown:
+        keyStates[event.code] = true;
+        keyTapped[event.code] = true;
+        break;
+    case InputEvent::KeyUp:
+        keyStates[event.code] = false;
+        break;
+    case InputEvent::SpecialKeyDown:
+        specialKeyStates[event.code] = true;
+        specialKeyTapped[event.code] = true;
+        break;
+    case InputEvent::SpecialKeyUp:
+        specialKeyStates[event.code] = false;
+        break;
+    case InputEvent::ButtonDown:
+    case InputEvent::ButtonUp:
+        mouseButtonStates[event.code] = event.type == InputEvent::ButtonDown;
+        
+        // If left button is pressed, we're starting a drag operation
+        if (event.code == GLUT_LEFT_BUTTON) {
+            isDragging = mouseButtonStates[event.code];
+        }
+        
+        // If right button is pressed, we're starting a rotation operation
+        if (event.code == GLUT_RIGHT_BUTTON) {
+            isRotating = mouseButtonStates[event.code];
+        }
+        break;
+    case InputEvent::Motion:
+    case InputEvent::Warp:
+    case InputEvent::Text:
+        break;
+    }
 }
 
 // Check if a key is currently pressed
 bool InputSystem::isKeyPressed(unsigned char key) {
-    return keyStates[key];
+    return keyStates[key] || keyTapped[key];
 }
 
 // Check if a special key is currently pressed
 bool InputSystem::isSpecialKeyPressed(int key) {
-    return (key >= 0 && key < 256) ? specialKeyStates[key] : false;
+    return (key >= 0 && key < 256) ? specialKeyStates[key] || specialKeyTapped[key] : false;
+}
+
+// Check if any key bound to an action is pressed
+bool InputSystem::isActionPressed(InputAction action) {
+    for (int code : ActionMap::getInstance().getKeys(action)) {
+        bool pressed = code < ActionMap::SPECIAL_KEY_BASE
+            ? isKeyPressed(static_cast<unsigned char>(code))
+            : isSpecialKeyPressed(code - ActionMap::SPECIAL_KEY_BASE);
+        if (pressed) return true;
+    }
+    return false;
 }
 
-// Check if any of the WASD keys are pressed
+// Check if any of the movement keys are pressed
 bool InputSystem::isMovementKeyPressed() {
-    return keyStates['w'] || keyStates['a'] || keyStates['s'] || keyStates['d'] ||
-           keyStates['W'] || keyStates['A'] || keyStates['S'] || keyStates['D'];
+    return isActionPressed(InputAction::MoveForward) || isActionPressed(InputAction::MoveBackward) ||
+           isActionPressed(InputAction::MoveLeft) || isActionPressed(InputAction::MoveRight);
 }
 
 // Check if a mouse button is currently pressed
@@ -170,15 +367,14 @@ void InputSystem::getMousePosition(float& x, float& y) {
     y = currentMouseY;
 }
 
-// Get the mouse movement delta since last update
+// Get the mouse movement since the last call (every motion event applied, not just the last)
 void InputSystem::getMouseDelta(float& deltaX, float& deltaY) {
-    // Calculate the delta
-    deltaX = currentMouseX - lastMouseX;
-    deltaY = currentMouseY - lastMouseY;
+    deltaX = mouseDeltaX;
+    deltaY = mouseDeltaY;
     
     // Reset immediately after reading to prevent continued camera movement
-    lastMouseX = currentMouseX;
-    lastMouseY = currentMouseY;
+    mouseDeltaX = 0.0f;
+    mouseDeltaY = 0.0f;
 }
 
 // Check if the mouse is being dragged
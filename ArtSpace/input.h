@@ -21,15 +21,120 @@
  * 
  * 4. Query input state:
  *    if (input->isKeyPressed('w')) { // handle 'w' key press  }
+ *    if (input->isActionPressed(InputAction::MoveForward)) { // any key bound to the action  }
  *    if (input->isMouseButtonPressed(GLUT_LEFT_BUTTON)) { // handle left mouse button }
  *    
  *    float mouseX, mouseY;
  *    input->getMousePosition(mouseX, mouseY);
  * 
+ * Events are not applied when GLUT reports them. Each one is stamped with
+ * Profiler::now() and pushed into a lock-free ring; update() (once per
+ * simulation step) drains the ring and applies every event in order:
+ * - Every motion event adds to the step's mouse delta, so several motion
+ *   callbacks between two steps all count, not just the last one.
+ * - A key pressed and released between two steps still reads as pressed
+ *   for that one step (and wasKeyPressed() reports it), so quick taps are
+ *   not lost.
+ * update(until) leaves later events for the next step, which lets the steps
+ * of one frame each take the input that arrived during the time they cover.
+ * The state queries report the state as of the last update().
+ *
+ * Late latching: latchMouseDelta() takes the pointer motion that is still
+ * queued (it arrived after the frame's steps ran) right before the camera
+ * is applied, so the view turns with input that would otherwise wait a
+ * whole frame. Those events stay queued for everything else (buttons,
+ * position) but their motion is not counted again by update().
+ *
+ * Every consumed event is reported to InputLatency, which measures its
+ * time to the screen.
+ *
+ * Relative mouse (pointer lock): with setRelativeMouse(true) the cursor is
+ * hidden and recenterPointer(), called once per frame, warps it back to the
+ * middle of the window whenever it has moved, so mouse look never stops at
+ * the window edge. The motion event a warp generates is recognized and
+ * replaced by a Warp event, which moves the position the deltas are taken
+ * from without counting as motion. Real motion that was still in flight
+ * when the warp happened is counted from where it started, as before.
+ *
+ * Replay (InputRecorder): setLiveInput(false) ignores the GLUT callbacks,
+ * and injectEvent() queues recorded events instead.
  */
 
 #pragma once
 #include <GL/glut.h>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "input_actions.h"
+
+// One GLUT input callback, as it arrived
+struct InputEvent {
+    enum Type : uint8_t {
+        KeyDown,
+        KeyUp,
+        SpecialKeyDown,
+        SpecialKeyUp,
+        ButtonDown,
+        ButtonUp,
+        Motion,
+        Warp,           // The pointer was moved by the program; not motion
+        Text            // Typed into a text field; not a key state
+    };
+
+    Type type;
+    int code;           // Key, special key or mouse button; 0 for motion
+    int x, y;           // Pointer in window pixels (GLUT's, origin top left)
+    uint64_t time;      // Profiler::now() when it arrived
+    bool latched;       // Motion already taken by latchMouseDelta()
+};
+
+// Bounded single-producer, single-consumer ring of input events
+class InputEventQueue {
+public:
+    static constexpr size_t CAPACITY = 1024;    // A power of two
+
+private:
+    InputEvent events[CAPACITY];
+    std::atomic<size_t> writePosition;
+    std::atomic<size_t> readPosition;
+    std::atomic<uint64_t> dropped;
+
+public:
+    InputEventQueue() : writePosition(0), readPosition(0), dropped(0) {}
+
+    // False (and counted) when the consumer has fallen a whole ring behind
+    bool push(const InputEvent& event) {
+        size_t write = writePosition.load(std::memory_order_relaxed);
+        if (write - readPosition.load(std::memory_order_acquire) >= CAPACITY) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        events[write & (CAPACITY - 1)] = event;
+        writePosition.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Oldest event, left in the queue
+    const InputEvent* peek() const {
+        size_t read = readPosition.load(std::memory_order_relaxed);
+        if (read == writePosition.load(std::memory_order_acquire)) return nullptr;
+        return &events[read & (CAPACITY - 1)];
+    }
+
+    // Consumer only: the queued event offset places after the oldest, or null
+    InputEvent* at(size_t offset) {
+        size_t read = readPosition.load(std::memory_order_relaxed);
+        if (offset >= writePosition.load(std::memory_order_acquire) - read) return nullptr;
+        return &events[(read + offset) & (CAPACITY - 1)];
+    }
+
+    void pop() {
+        readPosition.store(readPosition.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Events dropped since the last call
+    uint64_t takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+};
 
 class InputSystem {
 private:
@@ -37,13 +142,35 @@ private:
     bool mouseButtonStates[3];  // Left, Right, Middle
     bool keyStates[256];        // Regular keys
     bool specialKeyStates[256]; // Special keys (arrow keys, function keys)
+    bool keyTapped[256];        // Went down during the last update()
+    bool specialKeyTapped[256];
     
-    float lastMouseX, lastMouseY;
     float currentMouseX, currentMouseY;
+    bool hasMousePosition;              // Before the first event the position is unknown
+    float mouseDeltaX, mouseDeltaY;     // Motion applied since getMouseDelta() was last called
     bool isDragging;
     bool isRotating;
+    
+    InputEventQueue queue;
+    std::vector<InputEvent> stepEvents;  // Applied by the last update()
+    uint64_t lastEventTime;
+    
+    // Relative mouse; pointer kept as GLUT last reported it, before any queueing
+    bool relativeMouse;
+    bool pointerInWindow;
+    bool pointerKnown;
+    int pointerX, pointerY;
+    bool warpPending;                   // Waiting for the motion event of our own warp
+    int warpX, warpY;
+    uint64_t warpTime;
+    
+    bool liveInput;                     // False while a recording is replayed
 
     InputSystem();  // Private constructor for singleton
+    
+    void push(InputEvent::Type type, int code, int x, int y);
+    void apply(const InputEvent& event);
+    void pushPointer(InputEvent::Type type, int code, int x, int y);
 
 public:
     static InputSystem* getInstance();
@@ -59,19 +186,49 @@ public:
     void handleMouseButton(int button, int state, int x, int y);
     void handleMouseMotion(int x, int y);
     void handlePassiveMouseMotion(int x, int y);
+    void handleWindowEntry(int state);
+    // A key typed into a text field; applied in order with the rest, without a key state
+    void handleTextInput(unsigned char key);
+    
+    // Apply the queued events up to a Profiler::now() time, once per simulation step
+    void update(uint64_t until = UINT64_MAX);
+    
+    // Pointer motion still queued, taken now (just before rendering); false if there is none
+    bool latchMouseDelta(float& deltaX, float& deltaY);
     
-    // Update method to be called each frame
-    void update();
+    // Relative mouse: hidden cursor kept in the middle of the window
+    void setRelativeMouse(bool enable);
+    bool isRelativeMouse() const { return relativeMouse; }
+    // Once per frame: warp the pointer back to the middle if it moved
+    void recenterPointer();
+    // Move the pointer without the move counting as motion
+    void warpPointer(int x, int y);
+    void centerPointer();
     
-    // Query methods for input state
+    // Replay: ignore the GLUT callbacks and take injected events instead
+    void setLiveInput(bool enable) { liveInput = enable; }
+    bool isLiveInput() const { return liveInput; }
+    void injectEvent(const InputEvent& event) { queue.push(event); }
+    
+    // Query methods for input state (a key tapped during the last step counts as pressed)
     bool isKeyPressed(unsigned char key);
     bool isSpecialKeyPressed(int key);
+    bool wasKeyPressed(unsigned char key) const { return keyTapped[key]; }
+    bool wasSpecialKeyPressed(int key) const { return key >= 0 && key < 256 && specialKeyTapped[key]; }
+    // Any key bound to the action (see ActionMap)
+    bool isActionPressed(InputAction action);
     bool isMovementKeyPressed();
     bool isMouseButtonPressed(int button);
     
     // Mouse position and movement
     void getMousePosition(float& x, float& y);
+    // All motion applied since the last call
     void getMouseDelta(float& deltaX, float& deltaY);
     bool getIsDragging() const;
     bool getIsRotating() const;
+    
+    // Events applied by the last update(), oldest first
+    const std::vector<InputEvent>& getStepEvents() const { return stepEvents; }
+    // Arrival time of the newest applied event (0 before the first)
+    uint64_t getLastEventTime() const { return lastEventTime; }
 };
@@ -0,0 +1,234 @@
+#include "input_actions.h"
+#include "config.h"
+#include "logger.h"
+#include <GL/glut.h>
+#include <GL/freeglut_ext.h>
+#include <algorithm>
+#include <cstring>
+
+// Initialize static instance
+ActionMap ActionMap::instance;
+
+namespace {
+
+struct ActionInfo {
+    const char* name;
+    const char* defaultKeys;
+};
+
+// Indexed by InputAction
+const ActionInfo ACTION_INFO[ActionMap::ACTION_COUNT] = {
+    { "none", "" },
+    { "moveForward", "w,W" },
+    { "moveBackward", "s,S" },
+    { "moveLeft", "a,A" },
+    { "moveRight", "d,D" },
+    { "run", "Shift,RShift" },
+    { "rotateArtworkLeft", "k" },
+    { "rotateArtworkRight", "l" },
+    { "imageWider", "x" },
+    { "imageNarrower", "X" },
+    { "imageTaller", "y" },
+    { "imageShorter", "Y" },
+    { "frameWider", "f" },
+    { "frameNarrower", "F" },
+    { "frameTaller", "g" },
+    { "frameShorter", "G" },
+    { "resetImage", "r" },
+    { "resetFrame", "R" },
+    { "toggleProximityDebug", "p" },
+    { "toggleOcclusion", "o" },
+    { "openSearch", "/" },
+    { "toggleProfiler", "F3" },
+    { "dumpProfiler", "F4" },
+    { "toggleTrace", "F5" }
+};
+
+struct KeyName {
+    const char* name;
+    int code;
+};
+
+const KeyName KEY_NAMES[] = {
+    { "Space", ' ' },
+    { "Tab", '\t' },
+    { "Enter", '\r' },
+    { "Esc", 27 },
+    { "Backspace", 8 },
+    { "Delete", 127 },
+    { "Comma", ',' },
+    { "Left", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_LEFT },
+    { "Right", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_RIGHT },
+    { "Up", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_UP },
+    { "Down", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_DOWN },
+    { "PageUp", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_PAGE_UP },
+    { "PageDown", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_PAGE_DOWN },
+    { "Home", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_HOME },
+    { "End", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_END },
+    { "Insert", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_INSERT },
+    { "Shift", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_SHIFT_L },
+    { "RShift", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_SHIFT_R },
+    { "Ctrl", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_CTRL_L },
+    { "RCtrl", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_CTRL_R },
+    { "Alt", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_ALT_L },
+    { "RAlt", ActionMap::SPECIAL_KEY_BASE + GLUT_KEY_ALT_R }
+};
+
+} // namespace
+
+ActionMap::ActionMap() {
+    resetToDefaults();
+}
+
+ActionMap& ActionMap::getInstance() {
+    return instance;
+}
+
+const char* ActionMap::getActionName(InputAction action) {
+    int index = static_cast<int>(action);
+    return index >= 0 && index < ACTION_COUNT ? ACTION_INFO[index].name : "none";
+}
+
+InputAction ActionMap::findAction(const std::string& name) {
+    for (int i = 1; i < ACTION_COUNT; i++) {
+        if (name == ACTION_INFO[i].name) return static_cast<InputAction>(i);
+    }
+    return InputAction::None;
+}
+
+int ActionMap::parseKey(const std::string& name) {
+    if (name.size() == 1) {
+        return static_cast<unsigned char>(name[0]);
+    }
+    for (const KeyName& key : KEY_NAMES) {
+        if (name == key.name) return key.code;
+    }
+    // F1..F12
+    if (name.size() <= 3 && name[0] == 'F') {
+        int number = 0;
+        for (size_t i = 1; i < name.size(); i++) {
+            if (name[i] < '0' || name[i] > '9') return -1;
+            number = number * 10 + (name[i] - '0');
+        }
+        if (number >= 1 && number <= 12) return SPECIAL_KEY_BASE + GLUT_KEY_F1 + number - 1;
+    }
+    return -1;
+}
+
+std::string ActionMap::getKeyName(int code) {
+    for (const KeyName& key : KEY_NAMES) {
+        if (code == key.code) return key.name;
+    }
+    if (code >= SPECIAL_KEY_BASE + GLUT_KEY_F1 && code <= SPECIAL_KEY_BASE + GLUT_KEY_F12) {
+        return "F" + std::to_string(code - SPECIAL_KEY_BASE - GLUT_KEY_F1 + 1);
+    }
+    if (code > ' ' && code < 127) {
+        return std::string(1, static_cast<char>(code));
+    }
+    return "#" + std::to_string(code);
+}
+
+void ActionMap::resetToDefaults() {
+    for (int i = 0; i < 256; i++) {
+        keyActions[i] = InputAction::None;
+        specialKeyActions[i] = InputAction::None;
+    }
+    for (int i = 0; i < ACTION_COUNT; i++) {
+        actionKeys[i].clear();
+    }
+    for (int i = 1; i < ACTION_COUNT; i++) {
+        bind(static_cast<InputAction>(i), ACTION_INFO[i].defaultKeys);
+    }
+}
+
+// Take a key away from whichever action has it
+void ActionMap::unbindKey(int code) {
+    InputAction& owner = code < SPECIAL_KEY_BASE ? keyActions[code] : specialKeyActions[code - SPECIAL_KEY_BASE];
+    if (owner == InputAction::None) return;
+    std::vector<int>& keys = actionKeys[static_cast<int>(owner)];
+    keys.erase(std::remove(keys.begin(), keys.end(), code), keys.end());
+    owner = InputAction::None;
+}
+
+bool ActionMap::bind(InputAction action, const std::string& keys) {
+    int index = static_cast<int>(action);
+    if (action == InputAction::None || index >= ACTION_COUNT) return false;
+
+    // Parse the whole list first so a typo leaves the old binding in place
+    std::vector<int> codes;
+    size_t start = 0;
+    while (start <= keys.size()) {
+        size_t end = keys.find(',', start);
+        if (end == std::string::npos) end = keys.size();
+        std::string name = keys.substr(start, end - start);
+        name.erase(0, name.find_first_not_of(" \t"));
+        name.erase(name.find_last_not_of(" \t") + 1);
+        if (!name.empty()) {
+            int code = parseKey(name);
+            if (code < 0) {
+                LOG_WARN("Unknown key '{}' in binding for {}", name, getActionName(action));
+                return false;
+            }
+            codes.push_back(code);
+        }
+        start = end + 1;
+    }
+
+    for (int code : actionKeys[index]) {
+        if (code < SPECIAL_KEY_BASE) keyActions[code] = InputAction::None;
+        else specialKeyActions[code - SPECIAL_KEY_BASE] = InputAction::None;
+    }
+    actionKeys[index].clear();
+
+    for (int code : codes) {
+        InputAction owner = code < SPECIAL_KEY_BASE ? keyActions[code] : specialKeyActions[code - SPECIAL_KEY_BASE];
+        if (owner == action) continue;
+        if (owner != InputAction::None) {
+            LOG_WARN("Key {} moved from {} to {}", getKeyName(code), getActionName(owner), getActionName(action));
+            unbindKey(code);
+        }
+        if (code < SPECIAL_KEY_BASE) keyActions[code] = action;
+        else specialKeyActions[code - SPECIAL_KEY_BASE] = action;
+        actionKeys[index].push_back(code);
+    }
+
+    compile();
+    return true;
+}
+
+void ActionMap::loadFromConfig() {
+    for (const auto& binding : Config::getInstance().getKeyBindings()) {
+        InputAction action = findAction(binding.first);
+        if (action == InputAction::None) {
+            LOG_WARN("Unknown action '{}' in key bindings", binding.first);
+            continue;
+        }
+        bind(action, binding.second);
+    }
+}
+
+void ActionMap::setHandler(InputAction action, const std::function<void()>& handler) {
+    int index = static_cast<int>(action);
+    if (action == InputAction::None || index >= ACTION_COUNT) return;
+    handlers[index] = handler;
+    compile();
+}
+
+// Point every key straight at its action's handler
+void ActionMap::compile() {
+    for (int i = 0; i < 256; i++) {
+        const std::function<void()>& keyHandler = handlers[static_cast<int>(keyActions[i])];
+        keyDispatch[i] = keyHandler ? &keyHandler : nullptr;
+        const std::function<void()>& specialHandler = handlers[static_cast<int>(specialKeyActions[i])];
+        specialKeyDispatch[i] = specialHandler ? &specialHandler : nullptr;
+    }
+}
+
+std::string ActionMap::describe(InputAction action) const {
+    std::string text;
+    for (int code : getKeys(action)) {
+        if (!text.empty()) text += ", ";
+        text += getKeyName(code);
+    }
+    return text.empty() ? "(unbound)" : text;
+}
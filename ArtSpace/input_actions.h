@@ -0,0 +1,135 @@
+/**
+ * @file input_actions.h
+ * @brief Key bindings compiled into direct per-key dispatch tables
+ *
+ * Gameplay code asks for actions ("move forward", "rotate artwork") rather
+ * than keys. ActionMap holds which keys trigger each action and compiles the
+ * bindings into two 256-entry tables, one for character keys and one for
+ * GLUT special keys, each pointing straight at the bound action's handler.
+ * A key press is then one table lookup and at most one call, with no chain
+ * of comparisons.
+ *
+ * Two kinds of actions use the same bindings:
+ * - Held actions (movement, run) are read each simulation step with
+ *   InputSystem::isActionPressed(), which checks the action's keys.
+ * - One-shot actions have a handler, run once per key press through
+ *   dispatchKey()/dispatchSpecialKey().
+ *
+ * Bindings come from the defaults, overridden per action by Config
+ * ("bind.<action>=<keys>" lines). Keys are listed with commas: single
+ * characters stand for themselves, names for the rest ("Space", "Tab",
+ * "Comma", "F1".."F12", "Left", "Shift", ...). A key belongs to one action;
+ * binding it again moves it.
+ *
+ * Usage:
+ *    ActionMap& actions = ActionMap::getInstance();
+ *    actions.loadFromConfig();
+ *    actions.setHandler(InputAction::ToggleOcclusion, [this]() { toggleOcclusion(); });
+ *
+ *    // GLUT keyboard callback
+ *    actions.dispatchKey(key);
+ *
+ *    // Simulation step
+ *    if (input->isActionPressed(InputAction::MoveForward)) { ... }
+ */
+
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class InputAction : uint8_t {
+    None,
+    MoveForward,
+    MoveBackward,
+    MoveLeft,
+    MoveRight,
+    Run,
+    RotateArtworkLeft,
+    RotateArtworkRight,
+    ImageWider,
+    ImageNarrower,
+    ImageTaller,
+    ImageShorter,
+    FrameWider,
+    FrameNarrower,
+    FrameTaller,
+    FrameShorter,
+    ResetImage,
+    ResetFrame,
+    ToggleProximityDebug,
+    ToggleOcclusion,
+    OpenSearch,
+    ToggleProfiler,
+    DumpProfiler,
+    ToggleTrace,
+    Count
+};
+
+class ActionMap {
+public:
+    static constexpr int ACTION_COUNT = static_cast<int>(InputAction::Count);
+    // Special keys are stored after the character keys in key codes
+    static constexpr int SPECIAL_KEY_BASE = 256;
+
+private:
+    static ActionMap instance;
+
+    InputAction keyActions[256];
+    InputAction specialKeyActions[256];
+    std::vector<int> actionKeys[ACTION_COUNT];     // Key codes per action
+    std::function<void()> handlers[ACTION_COUNT];
+
+    // Compiled: the handler of the action bound to each key, or null
+    const std::function<void()>* keyDispatch[256];
+    const std::function<void()>* specialKeyDispatch[256];
+
+    ActionMap();
+
+    void compile();
+    void unbindKey(int code);
+
+public:
+    ActionMap(const ActionMap&) = delete;
+    ActionMap& operator=(const ActionMap&) = delete;
+
+    static ActionMap& getInstance();
+
+    // Names as used in the config file ("moveForward")
+    static const char* getActionName(InputAction action);
+    static InputAction findAction(const std::string& name);
+    // Key code (SPECIAL_KEY_BASE + GLUT key for special keys) from a key name; -1 if unknown
+    static int parseKey(const std::string& name);
+    static std::string getKeyName(int code);
+
+    void resetToDefaults();
+    // Replace an action's keys with a comma separated list; false if a key is not recognized
+    bool bind(InputAction action, const std::string& keys);
+    // Apply the bindings set in Config over the defaults
+    void loadFromConfig();
+
+    void setHandler(InputAction action, const std::function<void()>& handler);
+
+    InputAction getKeyAction(unsigned char key) const { return keyActions[key]; }
+    InputAction getSpecialKeyAction(int key) const {
+        return key >= 0 && key < 256 ? specialKeyActions[key] : InputAction::None;
+    }
+    const std::vector<int>& getKeys(InputAction action) const { return actionKeys[static_cast<int>(action)]; }
+    // "w, W" for help text
+    std::string describe(InputAction action) const;
+
+    // Run the handler bound to a key; false if the key has none
+    bool dispatchKey(unsigned char key) const {
+        const std::function<void()>* handler = keyDispatch[key];
+        if (!handler) return false;
+        (*handler)();
+        return true;
+    }
+    bool dispatchSpecialKey(int key) const {
+        const std::function<void()>* handler = key >= 0 && key < 256 ? specialKeyDispatch[key] : nullptr;
+        if (!handler) return false;
+        (*handler)();
+        return true;
+    }
+};
@@ -0,0 +1,93 @@
+#include "input_latency.h"
+#include <algorithm>
+#include <cstdio>
+
+// Initialize static instance
+InputLatency InputLatency::instance;
+
+InputLatency::InputLatency() {
+    pendingTimes.reserve(1024);
+    pendingMotion.reserve(1024);
+    sorted.reserve(SAMPLE_CAPACITY);
+    reset();
+}
+
+InputLatency& InputLatency::getInstance() {
+    return instance;
+}
+
+void InputLatency::reset() {
+    pendingTimes.clear();
+    pendingMotion.clear();
+    allEvents.samples.clear();
+    allEvents.next = 0;
+    allEvents.total = 0;
+    motionEvents.samples.clear();
+    motionEvents.next = 0;
+    motionEvents.total = 0;
+}
+
+void InputLatency::noteConsumed(uint64_t time, bool motion) {
+    pendingTimes.push_back(time);
+    pendingMotion.push_back(motion);
+}
+
+void InputLatency::notePresent(uint64_t presentTime) {
+    for (size_t i = 0; i < pendingTimes.size(); i++) {
+        if (pendingTimes[i] > presentTime) continue;
+        float milliseconds = static_cast<float>((presentTime - pendingTimes[i]) / 1.0e6);
+        addSample(allEvents, milliseconds);
+        if (pendingMotion[i]) {
+            addSample(motionEvents, milliseconds);
+        }
+    }
+    pendingTimes.clear();
+    pendingMotion.clear();
+}
+
+void InputLatency::addSample(SampleRing& ring, float milliseconds) {
+    if (ring.samples.size() < SAMPLE_CAPACITY) {
+        ring.samples.push_back(milliseconds);
+    }
+    else {
+        ring.samples[ring.next] = milliseconds;
+    }
+    ring.next = (ring.next + 1) % SAMPLE_CAPACITY;
+    ring.total++;
+}
+
+InputLatency::Stats InputLatency::getStats(bool motionOnly) const {
+    return computeStats(motionOnly ? motionEvents : allEvents);
+}
+
+InputLatency::Stats InputLatency::computeStats(const SampleRing& ring) const {
+    Stats stats = { 0, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+    if (ring.samples.empty()) return stats;
+
+    sorted.assign(ring.samples.begin(), ring.samples.end());
+    std::sort(sorted.begin(), sorted.end());
+
+    double sum = 0.0;
+    for (float sample : sorted) sum += sample;
+
+    auto percentile = [this](float fraction) {
+        size_t index = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5f);
+        return sorted[index];
+    };
+    stats.count = sorted.size();
+    stats.average = static_cast<float>(sum / sorted.size());
+    stats.p50 = percentile(0.50f);
+    stats.p95 = percentile(0.95f);
+    stats.p99 = percentile(0.99f);
+    stats.max = sorted.back();
+    return stats;
+}
+
+std::string InputLatency::describe() const {
+    Stats look = getStats(true);
+    Stats all = getStats(false);
+    char text[160];
+    snprintf(text, sizeof(text), "input to present: look p50 %.1f p95 %.1f  all p50 %.1f p95 %.1f p99 %.1f ms",
+        look.p50, look.p95, all.p50, all.p95, all.p99);
+    return text;
+}
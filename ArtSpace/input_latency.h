@@ -0,0 +1,85 @@
+/**
+ * @file input_latency.h
+ * @brief Input-to-present latency: how long each input event waited to reach the screen
+ *
+ * Every input event is stamped with Profiler::now() when GLUT reports it.
+ * When the InputSystem consumes it (in a simulation step, or latched just
+ * before rendering) the stamp is handed here; when the frame that used it
+ * is swapped, the time from stamp to swap is one latency sample.
+ *
+ * The samples are measured to the return of glutSwapBuffers. The display
+ * still has to scan the image out, which adds up to one refresh interval
+ * that no timer on this side can see; compare builds with it, not against
+ * a photodiode.
+ *
+ * The last SAMPLE_CAPACITY samples are kept for the percentiles, separately
+ * for pointer motion (what mouse look feels like) and for all events.
+ *
+ * Usage:
+ *    // InputSystem, per consumed event
+ *    InputLatency::getInstance().noteConsumed(event.time, event.type == InputEvent::Motion);
+ *
+ *    // Right after glutSwapBuffers()
+ *    InputLatency::getInstance().notePresent(Profiler::now());
+ *
+ *    InputLatency::Stats look = InputLatency::getInstance().getStats(true);
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class InputLatency {
+public:
+    static constexpr size_t SAMPLE_CAPACITY = 4096;
+
+    struct Stats {
+        size_t count;           // Samples in the window
+        float average;          // Milliseconds
+        float p50;
+        float p95;
+        float p99;
+        float max;
+    };
+
+private:
+    // Ring of the most recent samples, in milliseconds
+    struct SampleRing {
+        std::vector<float> samples;
+        size_t next;
+        uint64_t total;         // Every sample ever added
+    };
+
+    static InputLatency instance;
+
+    std::vector<uint64_t> pendingTimes;     // Consumed, not yet on screen
+    std::vector<bool> pendingMotion;
+    SampleRing allEvents;
+    SampleRing motionEvents;
+    mutable std::vector<float> sorted;      // Scratch for getStats()
+
+    InputLatency();
+
+    static void addSample(SampleRing& ring, float milliseconds);
+    Stats computeStats(const SampleRing& ring) const;
+
+public:
+    InputLatency(const InputLatency&) = delete;
+    InputLatency& operator=(const InputLatency&) = delete;
+
+    static InputLatency& getInstance();
+
+    // An event stamped at time is used by the frame being built
+    void noteConsumed(uint64_t time, bool motion);
+    // The frame was handed to the display; every consumed event becomes a sample
+    void notePresent(uint64_t presentTime);
+
+    // Pointer motion only, or every kind of event
+    Stats getStats(bool motionOnly) const;
+    uint64_t getSampleCount() const { return allEvents.total; }
+    // "look p50 12.1 p95 16.4 ms" for the HUD and the log
+    std::string describe() const;
+
+    void reset();
+};
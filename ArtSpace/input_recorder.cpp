@@ -0,0 +1,362 @@
+#include "input_recorder.h"
+#include "fixed_timestep.h"
+#include "logger.h"
+#include "profiler.h"
+#include <chrono>
+#include <cstring>
+#include <iterator>
+#include <thread>
+
+// Initialize static instance
+InputRecorder InputRecorder::instance;
+
+namespace {
+
+const char FILE_MAGIC[4] = { 'A', 'S', 'I', 'R' };
+const size_t FLUSH_BYTES = 64 * 1024;
+
+// Well beyond the simulation rates the config allows; other step lengths mean a corrupt header
+const float MIN_STEP_SECONDS = 1.0f / 1000.0f;
+const float MAX_STEP_SECONDS = 1.0f;
+
+// Record tags
+const uint8_t TAG_FRAME = 'F';
+const uint8_t TAG_STEP = 'S';
+const uint8_t TAG_LOOK = 'L';
+const uint8_t TAG_CHECKSUM = 'C';
+const uint8_t TAG_END = 'E';
+
+const uint8_t EVENT_LATCHED = 1;
+
+void putVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+void putSigned(std::vector<uint8_t>& out, int64_t value) {
+    putVarint(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+// Raw little-endian bytes; floats and fixed-size fields
+template <typename T>
+void putRaw(std::vector<uint8_t>& out, T value) {
+    uint8_t bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+// Bounds-checked reader over the loaded file
+struct Cursor {
+    const uint8_t* data;
+    size_t size;
+    size_t position;
+    bool failed;
+
+    bool atEnd() const { return position >= size; }
+
+    uint8_t byte() {
+        if (position >= size) { failed = true; return 0; }
+        return data[position++];
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t next = byte();
+            value |= static_cast<uint64_t>(next & 0x7F) << shift;
+            if (!(next & 0x80)) return value;
+        }
+        failed = true;
+        return 0;
+    }
+
+    int64_t signedVarint() {
+        uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    template <typename T>
+    T raw() {
+        T value;
+        memset(&value, 0, sizeof(T));
+        if (position + sizeof(T) > size) { failed = true; return value; }
+        memcpy(&value, data + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+};
+
+} // namespace
+
+InputRecorder::InputRecorder()
+    : mode(Mode::Off), seed(0), stepSeconds(0.0f), recordStart(0), lastEventTime(0), framesRecorded(0),
+      nextFrameIndex(0), maxSpeed(false), replayStart(0), mismatches(0), firstMismatch(-1) {
+}
+
+InputRecorder& InputRecorder::getInstance() {
+    return instance;
+}
+
+// Recording
+
+bool InputRecorder::startRecording(const std::string& filePath, uint32_t randomSeed, float step) {
+    stop();
+    output.open(filePath.c_str(), std::ios::binary | std::ios::trunc);
+    if (!output) {
+        LOG_ERROR("Could not open input recording {}", filePath);
+        return false;
+    }
+
+    path = filePath;
+    seed = randomSeed;
+    stepSeconds = step;
+    recordStart = Profiler::now();
+    lastEventTime = recordStart;
+    framesRecorded = 0;
+    mode = Mode::Recording;
+
+    buffer.clear();
+    buffer.insert(buffer.end(), FILE_MAGIC, FILE_MAGIC + sizeof(FILE_MAGIC));
+    putRaw(buffer, FILE_VERSION);
+    putRaw(buffer, seed);
+    putRaw(buffer, stepSeconds);
+    LOG_INFO("Recording input to {} (seed {})", path, seed);
+    return true;
+}
+
+void InputRecorder::recordFrame(int steps, float alpha, float frameSeconds) {
+    if (mode != Mode::Recording) return;
+    uint64_t now = Profiler::now();
+    buffer.push_back(TAG_FRAME);
+    putVarint(buffer, static_cast<uint64_t>(steps));
+    putRaw(buffer, alpha);
+    putRaw(buffer, frameSeconds);
+    putVarint(buffer, now > recordStart ? now - recordStart : 0);
+    framesRecorded++;
+}
+
+void InputRecorder::recordStep(const std::vector<InputEvent>& events) {
+    if (mode != Mode::Recording) return;
+    buffer.push_back(TAG_STEP);
+    putVarint(buffer, events.size());
+    for (const InputEvent& event : events) {
+        buffer.push_back(static_cast<uint8_t>(event.type));
+        buffer.push_back(event.latched ? EVENT_LATCHED : 0);
+        putVarint(buffer, static_cast<uint64_t>(event.code));
+        putSigned(buffer, event.x);
+        putSigned(buffer, event.y);
+        putSigned(buffer, static_cast<int64_t>(event.time - lastEventTime));
+        lastEventTime = event.time;
+    }
+}
+
+void InputRecorder::recordLook(float yaw, float pitch) {
+    if (mode != Mode::Recording) return;
+    buffer.push_back(TAG_LOOK);
+    putRaw(buffer, yaw);
+    putRaw(buffer, pitch);
+}
+
+void InputRecorder::recordChecksum(uint64_t checksum) {
+    if (mode != Mode::Recording) return;
+    buffer.push_back(TAG_CHECKSUM);
+    putRaw(buffer, checksum);
+    flushBuffer(false);
+}
+
+void InputRecorder::flushBuffer(bool force) {
+    if (buffer.empty() || (!force && buffer.size() < FLUSH_BYTES)) return;
+    output.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+    buffer.clear();
+    if (!output) {
+        LOG_ERROR("Writing input recording {} failed; recording stopped", path);
+        output.close();
+        mode = Mode::Off;
+    }
+}
+
+// Replay
+
+bool InputRecorder::startReplay(const std::string& filePath, bool asFastAsPossible) {
+    stop();
+    std::ifstream input(filePath.c_str(), std::ios::binary);
+    if (!input) {
+        LOG_ERROR("Could not open input recording {}", filePath);
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    if (!parse(data)) {
+        LOG_ERROR("{} is not a supported input recording", filePath);
+        frames.clear();
+        return false;
+    }
+
+    path = filePath;
+    maxSpeed = asFastAsPossible;
+    nextFrameIndex = 0;
+    mismatches = 0;
+    firstMismatch = -1;
+    frameMs.clear();
+    checksums.clear();
+    frameMs.reserve(frames.size());
+    checksums.reserve(frames.size());
+    replayStart = 0;
+    mode = Mode::Replaying;
+    LOG_INFO("Replaying {} frames from {} (seed {}, {} speed)", frames.size(), path, seed,
+        maxSpeed ? "max" : "recorded");
+    return true;
+}
+
+bool InputRecorder::parse(const std::vector<uint8_t>& data) {
+    frames.clear();
+    Cursor cursor = { data.data(), data.size(), 0, false };
+    if (data.size() < sizeof(FILE_MAGIC) || memcmp(data.data(), FILE_MAGIC, sizeof(FILE_MAGIC)) != 0) {
+        return false;
+    }
+    cursor.position = sizeof(FILE_MAGIC);
+    if (cursor.raw<uint32_t>() != FILE_VERSION) return false;
+    seed = cursor.raw<uint32_t>();
+    stepSeconds = cursor.raw<float>();
+    if (cursor.failed || !(stepSeconds >= MIN_STEP_SECONDS) || !(stepSeconds <= MAX_STEP_SECONDS)) {
+        return false;
+    }
+    // The most steps one frame can run before FixedTimestep clamps it (plus the
+    // leftover accumulator step and a step of rounding slack)
+    uint64_t maxFrameSteps = static_cast<uint64_t>(FixedTimestep::DEFAULT_MAX_FRAME_SECONDS / stepSeconds) + 2;
+
+    // A recording cut short (crash, kill) keeps its complete frames
+    uint64_t eventTime = 0;
+    while (!cursor.atEnd() && !cursor.failed) {
+        uint8_t tag = cursor.byte();
+        if (tag == TAG_END) break;
+
+        if (tag == TAG_FRAME) {
+            Frame frame;
+            uint64_t steps = cursor.varint();
+            if (steps > maxFrameSteps) return false;
+            frame.steps = static_cast<int>(steps);
+            frame.alpha = cursor.raw<float>();
+            frame.frameSeconds = cursor.raw<float>();
+            frame.startNs = cursor.varint();
+            frame.hasLook = false;
+            frame.lookYaw = frame.lookPitch = 0.0f;
+            frame.hasChecksum = false;
+            frame.checksum = 0;
+            frame.stepEvents.reserve(frame.steps);
+            frames.push_back(frame);
+            continue;
+        }
+        if (frames.empty()) return false;
+        Frame& frame = frames.back();
+
+        if (tag == TAG_STEP) {
+            frame.stepEvents.emplace_back();
+            std::vector<InputEvent>& events = frame.stepEvents.back();
+            uint64_t count = cursor.varint();
+            for (uint64_t i = 0; i < count && !cursor.failed; i++) {
+                InputEvent event;
+                event.type = static_cast<InputEvent::Type>(cursor.byte());
+                event.latched = (cursor.byte() & EVENT_LATCHED) != 0;
+                event.code = static_cast<int>(cursor.varint());
+                event.x = static_cast<int>(cursor.signedVarint());
+                event.y = static_cast<int>(cursor.signedVarint());
+                eventTime += static_cast<uint64_t>(cursor.signedVarint());
+                event.time = eventTime;
+                if (event.type > InputEvent::Text || event.code < 0 || event.code > 255) return false;
+                events.push_back(event);
+            }
+        }
+        else if (tag == TAG_LOOK) {
+            frame.hasLook = true;
+            frame.lookYaw = cursor.raw<float>();
+            frame.lookPitch = cursor.raw<float>();
+        }
+        else if (tag == TAG_CHECKSUM) {
+            frame.hasChecksum = true;
+            frame.checksum = cursor.raw<uint64_t>();
+        }
+        else {
+            return false;
+        }
+    }
+
+    // Drop a last frame that was still being written
+    if (!frames.empty() && (cursor.failed || !frames.back().hasChecksum ||
+        static_cast<int>(frames.back().stepEvents.size()) != frames.back().steps)) {
+        frames.pop_back();
+    }
+    return !frames.empty();
+}
+
+bool InputRecorder::nextFrame(Frame& frame) {
+    if (mode != Mode::Replaying || nextFrameIndex >= frames.size()) return false;
+    frame = frames[nextFrameIndex++];
+    return true;
+}
+
+void InputRecorder::waitForFrame(const Frame& frame) {
+    if (maxSpeed) return;
+    uint64_t now = Profiler::now();
+    if (replayStart == 0) {
+        replayStart = now - frame.startNs;
+        return;
+    }
+    uint64_t due = replayStart + frame.startNs;
+    if (due > now) {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+    }
+}
+
+void InputRecorder::noteReplayedFrame(const Frame& frame, uint64_t checksum, float milliseconds) {
+    if (mode != Mode::Replaying) return;
+    size_t index = frameMs.size();
+    frameMs.push_back(milliseconds);
+    checksums.push_back(checksum);
+    if (frame.hasChecksum && frame.checksum != checksum) {
+        if (firstMismatch < 0) {
+            firstMismatch = static_cast<long long>(index);
+            LOG_WARN("Replay diverged from the recording at frame {}", index);
+        }
+        mismatches++;
+    }
+}
+
+void InputRecorder::writeReport() {
+    std::string reportPath = path + ".csv";
+    std::ofstream file(reportPath);
+    if (!file.is_open()) {
+        LOG_ERROR("Could not write replay report {}", reportPath);
+        return;
+    }
+
+    file << "frame,frame_ms,checksum,recorded_checksum,match\n";
+    char line[96];
+    for (size_t i = 0; i < frameMs.size(); i++) {
+        uint64_t recorded = frames[i].checksum;
+        snprintf(line, sizeof(line), "%zu,%.3f,%016llx,%016llx,%d\n", i, frameMs[i],
+            static_cast<unsigned long long>(checksums[i]), static_cast<unsigned long long>(recorded),
+            !frames[i].hasChecksum || recorded == checksums[i] ? 1 : 0);
+        file << line;
+    }
+    LOG_INFO("Replay report written to {}", reportPath);
+}
+
+void InputRecorder::stop() {
+    if (mode == Mode::Recording) {
+        buffer.push_back(TAG_END);
+        flushBuffer(true);
+        output.close();
+        LOG_INFO("Input recording {} closed ({} frames)", path, framesRecorded);
+    }
+    else if (mode == Mode::Replaying) {
+        double total = 0.0;
+        for (float milliseconds : frameMs) total += milliseconds;
+        LOG_INFO("Replayed {} of {} frames, avg {:.2f} ms, {} mismatched", frameMs.size(), frames.size(),
+            frameMs.empty() ? 0.0 : total / frameMs.size(), mismatches);
+        writeReport();
+    }
+    mode = Mode::Off;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file input_recorder.h
+ * @brief Records a session's input to a compact binary file and plays it back deterministically
+ *
+ * The simulation only changes through fixed steps, and each step only
+ * through the input events InputSystem::update() applied to it (plus the
+ * random seed the gallery was laid out with). Recording those, frame by
+ * frame, is therefore enough to run the same session again:
+ *
+ * - Frame: how many steps ran, the render interpolation alpha, the real
+ *   frame time (for the UI) and when the frame started.
+ * - Step: the events the step applied, in order.
+ * - Look: the camera turn late latching applied before rendering.
+ * - Checksum: a hash of the simulation state when the frame was shown.
+ *
+ * A replay feeds the events back step by step with live input switched
+ * off, either at the recorded pace or as fast as the machine renders. It
+ * still runs the full update and render loop, writes one CSV row per frame
+ * (frame time, checksum, recorded checksum) and reports the first frame
+ * whose state differs from the recording: the behaviour drifted.
+ *
+ * Render quality is picked by timing (quality benchmark, governor), which
+ * does not change the simulation; fix qualityTier in the config to compare
+ * frame times between builds.
+ *
+ * File layout (little endian): "ASIR", version, seed, step seconds, then
+ * tagged records. Integers are LEB128 varints, signed ones zigzag encoded;
+ * event times are deltas from the previous event.
+ *
+ * Usage:
+ *    // ArtSpace --record session.asir
+ *    recorder.startRecording(path, seed, stepSeconds);
+ *    recorder.recordFrame(steps, alpha, frameSeconds);
+ *    recorder.recordStep(input->getStepEvents());      // Per step
+ *    recorder.recordChecksum(checksum);                // After the frame is shown
+ *
+ *    // ArtSpace --replay session.asir [--replay-speed max]
+ *    recorder.startReplay(path, maxSpeed);
+ *    srand(recorder.getSeed());
+ *    while (recorder.nextFrame(frame)) { ... recorder.noteReplayedFrame(checksum, frameMs); }
+ */
+
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "input.h"
+
+class InputRecorder {
+public:
+    static constexpr uint32_t FILE_VERSION = 1;
+
+    // One recorded frame
+    struct Frame {
+        int steps;
+        float alpha;
+        float frameSeconds;
+        uint64_t startNs;                               // Since the recording started
+        std::vector<std::vector<InputEvent>> stepEvents;
+        bool hasLook;
+        float lookYaw, lookPitch;
+        bool hasChecksum;
+        uint64_t checksum;
+    };
+
+    enum class Mode { Off, Recording, Replaying };
+
+private:
+    static InputRecorder instance;
+
+    Mode mode;
+    std::string path;
+    uint32_t seed;
+    float stepSeconds;
+
+    // Recording
+    std::ofstream output;
+    std::vector<uint8_t> buffer;            // Written out in chunks
+    uint64_t recordStart;
+    uint64_t lastEventTime;
+    size_t framesRecorded;
+
+    // Replay
+    std::vector<Frame> frames;
+    size_t nextFrameIndex;
+    bool maxSpeed;
+    uint64_t replayStart;
+    size_t mismatches;
+    long long firstMismatch;                // Frame index, -1 while the replay matches
+    std::vector<float> frameMs;
+    std::vector<uint64_t> checksums;
+
+    InputRecorder();
+
+    void flushBuffer(bool force);
+    bool parse(const std::vector<uint8_t>& data);
+    void writeReport();
+
+public:
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    static InputRecorder& getInstance();
+
+    Mode getMode() const { return mode; }
+    bool isRecording() const { return mode == Mode::Recording; }
+    bool isReplaying() const { return mode == Mode::Replaying; }
+
+    // Recording
+    bool startRecording(const std::string& filePath, uint32_t randomSeed, float stepSeconds);
+    void recordFrame(int steps, float alpha, float frameSeconds);
+    void recordStep(const std::vector<InputEvent>& events);
+    void recordLook(float yaw, float pitch);
+    void recordChecksum(uint64_t checksum);
+
+    // Replay; the seed and step come from the file
+    bool startReplay(const std::string& filePath, bool asFastAsPossible);
+    uint32_t getSeed() const { return seed; }
+    float getStepSeconds() const { return stepSeconds; }
+    bool isMaxSpeed() const { return maxSpeed; }
+    // The next frame to replay; false when the recording is used up
+    bool nextFrame(Frame& frame);
+    // At the recorded pace: sleep until the frame is due (no-op at max speed)
+    void waitForFrame(const Frame& frame);
+    // The replayed frame was shown with this state and took this long
+    void noteReplayedFrame(const Frame& frame, uint64_t checksum, float milliseconds);
+    bool isFinished() const { return isReplaying() && nextFrameIndex >= frames.size(); }
+    size_t getMismatches() const { return mismatches; }
+
+    // Finish the file, or write the replay report (path + ".csv") and log the summary
+    void stop();
+};
@@ -0,0 +1,523 @@
+#include "logger.h"
+#include "trace.h"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+// Initialize static instance for Logger
+Logger Logger::instance;
+
+// Longest the writer sleeps before draining on its own
+static const std::chrono::milliseconds WRITER_INTERVAL(20);
+
+Logger::Logger()
+    : consoleLogging(false)
+    , fileLogging(false)
+    , logFilePath("artspace.log")
+    , binaryFormatsWritten(1)
+    , minLevel(static_cast<LogLevel>(ARTSPACE_LOG_LEVEL))
+    , formats{}
+    , formatCount(1)
+    , records(new Record[QUEUE_CAPACITY])
+    , enqueuePosition(0)
+    , dequeuePosition(0)
+    , droppedMessages(0)
+    , totalDropped(0)
+    , writerStarted(false)
+    , stopping(false)
+    , flushRequested(0)
+    , flushCompleted(0)
+    , steadyOrigin(Clock::now())
+    , wallOrigin(std::chrono::system_clock::now())
+    , stampSecond(0)
+    , stamp{} {
+    for (size_t i = 0; i < QUEUE_CAPACITY; i++) {
+        records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+Logger::~Logger() {
+    shutdown();
+    if (logFile.is_open()) {
+        logFile.close();
+    }
+    if (binaryFile.is_open()) {
+        binaryFile.close();
+    }
+}
+
+Logger& Logger::getInstance() {
+    return instance;
+}
+
+void Logger::enableConsoleLogging(bool enable) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    consoleLogging = enable;
+}
+
+void Logger::enableFileLogging(bool enable, const std::string& filePath) {
+    bool failed = false;
+    {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        fileLogging = enable;
+        logFilePath = filePath;
+
+        if (fileLogging && !logFile.is_open()) {
+            logFile.open(logFilePath, std::ios::out | std::ios::app);
+            if (!logFile.is_open()) {
+                // Failed to open log file
+                consoleLogging = true; // Fallback to console logging
+                failed = true;
+            }
+        }
+        else if (!fileLogging && logFile.is_open()) {
+            logFile.close();
+        }
+    }
+    if (failed) {
+        logError("Failed to open log file: " + filePath);
+    }
+}
+
+void Logger::setMinimumLogLevel(LogLevel level) {
+    minLevel.store(level, std::memory_order_relaxed);
+}
+
+void Logger::setLineObserver(LineObserver callback) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    observer = callback;
+}
+
+void Logger::logInfo(const std::string& message) {
+    log(INFO, message);
+}
+
+void Logger::logWarning(const std::string& message) {
+    log(WARNING, message);
+}
+
+void Logger::logError(const std::string& message) {
+    log(ERROR_, message);
+}
+
+void Logger::logDebug(const std::string& message) {
+    log(DEBUG, message);
+}
+
+void Logger::log(LogLevel level, const std::string& message) {
+    if (!isLevelEnabled(level)) {
+        return; // Skip messages below minimum level
+    }
+
+    if (!writerStarted.load(std::memory_order_acquire)) {
+        startWriter();
+    }
+
+    size_t position;
+    Record* record = claimSlot(position);
+    if (!record) return;
+
+    size_t length = message.size();
+    record->formatId = 0;
+    record->length = static_cast<uint32_t>(length < MAX_MESSAGE_LENGTH ? length : MAX_MESSAGE_LENGTH);
+    memcpy(record->text, message.data(), record->length);
+    if (length > MAX_MESSAGE_LENGTH) {
+        memcpy(record->text + MAX_MESSAGE_LENGTH - 3, "...", 3);
+    }
+    publishSlot(record, position, level);
+}
+
+// Bounded MPMC ring (D. Vyukov): each slot's sequence says whose turn it is.
+// sequence == position: free for the producer claiming that position.
+// sequence == position + 1: filled, ready for the consumer.
+Logger::Record* Logger::claimSlot(size_t& position) {
+    position = enqueuePosition.load(std::memory_order_relaxed);
+    for (;;) {
+        Record* record = &records[position & (QUEUE_CAPACITY - 1)];
+        size_t sequence = record->sequence.load(std::memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (difference == 0) {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                record->time = Clock::now();
+                return record;
+            }
+        }
+        else if (difference < 0) {
+            // Full: the writer hasn't freed this slot yet
+            droppedMessages.fetch_add(1, std::memory_order_relaxed);
+            totalDropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void Logger::publishSlot(Record* record, size_t position, LogLevel level) {
+    record->level = level;
+    record->sequence.store(position + 1, std::memory_order_release);
+
+    // The writer wakes on its own every few milliseconds; only hurry it for
+    // errors (which may precede a crash) and a filling queue
+    size_t queued = enqueuePosition.load(std::memory_order_relaxed) - dequeuePosition.load(std::memory_order_relaxed);
+    if (level == ERROR_ || queued > QUEUE_CAPACITY / 2) {
+        wakeWriter.notify_one();
+    }
+
+    // After shutdown (static destructors...) there is no writer: write it here
+    if (stopping.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        drain();
+    }
+}
+
+bool Logger::hasPending() const {
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    const Record& record = records[position & (QUEUE_CAPACITY - 1)];
+    return record.sequence.load(std::memory_order_acquire) == position + 1;
+}
+
+const char* Logger::stampFor(TimePoint time) {
+    std::time_t second = std::chrono::system_clock::to_time_t(wallOrigin +
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(time - steadyOrigin));
+    if (second != stampSecond) {
+        stampSecond = second;
+        struct tm timeInfo;
+#ifdef _WIN32
+        localtime_s(&timeInfo, &second);
+#else
+        localtime_r(&second, &timeInfo);
+#endif
+        snprintf(stamp, sizeof(stamp), "[%02d:%02d:%02d] ", timeInfo.tm_hour, timeInfo.tm_min, timeInfo.tm_sec);
+    }
+    return stamp;
+}
+
+void Logger::drain() {
+    static const char* PREFIXES[] = { "[DEBUG] ", "[INFO] ", "[WARN] ", "[ERROR] " };
+
+    std::string batch;
+    std::string binaryBatch;
+    std::string line;
+    bool binary = binaryFile.is_open();
+    while (hasPending()) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Record& record = records[position & (QUEUE_CAPACITY - 1)];
+        line.assign(stampFor(record.time));
+        line.append(PREFIXES[record.level]);
+        if (record.formatId == 0) {
+            line.append(record.text, record.length);
+        }
+        else {
+            formatMessage(formats[record.formatId].format, record.text, record.length, line);
+        }
+        if (binary) {
+            writeBinary(binaryBatch, record);
+        }
+        TimePoint time = record.time;
+
+        // Hand the slot back to the producers
+        record.sequence.store(position + QUEUE_CAPACITY, std::memory_order_release);
+        dequeuePosition.store(position + 1, std::memory_order_relaxed);
+
+        if (observer) {
+            observer(line, time);
+        }
+        batch.append(line);
+        batch.push_back('\n');
+    }
+
+    uint64_t dropped = droppedMessages.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+        batch.append(stampFor(Clock::now()));
+        batch.append("[WARN] " + std::to_string(dropped) + " log messages dropped (queue full)\n");
+    }
+
+    if (!binaryBatch.empty()) {
+        binaryFile.write(binaryBatch.data(), binaryBatch.size());
+        binaryFile.flush();
+    }
+    if (batch.empty()) return;
+
+    TRACE_SCOPE("Logger flush");
+    if (consoleLogging) {
+        std::cout.write(batch.data(), batch.size());
+        std::cout.flush();
+    }
+    if (fileLogging && logFile.is_open()) {
+        logFile.write(batch.data(), batch.size());
+        logFile.flush();
+    }
+}
+
+template <typename T>
+static void appendRaw(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Binary log entries (native byte order):
+//   file header   "ASLOG" 0x02 (0x01 numbered the levels INFO, WARN, DEBUG, ERROR)
+//   'F' format    u16 id, u8 level, i32 line, u16 length + file, u16 length + format
+//   'M' message   u16 format id (0: plain text), u8 level, i64 wall-clock us, u16 length + payload
+void Logger::writeBinary(std::string& batch, const Record& record) {
+    // Formats first appear in the file before the first message that uses them
+    size_t registered = formatCount.load(std::memory_order_acquire);
+    for (; binaryFormatsWritten < registered; binaryFormatsWritten++) {
+        const LogFormat& format = formats[binaryFormatsWritten];
+        size_t fileLength = strlen(format.file);
+        size_t formatLength = strlen(format.format);
+        batch.push_back('F');
+        appendRaw(batch, static_cast<uint16_t>(binaryFormatsWritten));
+        appendRaw(batch, static_cast<uint8_t>(format.level));
+        appendRaw(batch, static_cast<int32_t>(format.line));
+        appendRaw(batch, static_cast<uint16_t>(fileLength));
+        batch.append(format.file, fileLength);
+        appendRaw(batch, static_cast<uint16_t>(formatLength));
+        batch.append(format.format, formatLength);
+    }
+
+    int64_t wallMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(
+        (wallOrigin + std::chrono::duration_cast<std::chrono::system_clock::duration>(record.time - steadyOrigin))
+        .time_since_epoch()).count();
+    batch.push_back('M');
+    appendRaw(batch, record.formatId);
+    appendRaw(batch, static_cast<uint8_t>(record.level));
+    appendRaw(batch, wallMicroseconds);
+    appendRaw(batch, static_cast<uint16_t>(record.length));
+    batch.append(record.text, record.length);
+}
+
+bool Logger::enableBinaryLogging(bool enable, const std::string& filePath) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    if (binaryFile.is_open()) {
+        binaryFile.close();
+    }
+    if (!enable) return true;
+
+    binaryFile.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!binaryFile.is_open()) return false;
+    binaryFile.write("ASLOG\x02", 6);
+    binaryFormatsWritten = 1;
+    return true;
+}
+
+uint16_t Logger::registerFormat(LogLevel level, const char* format, const char* file, int line) {
+    std::lock_guard<std::mutex> lock(instance.formatMutex);
+    size_t id = instance.formatCount.load(std::memory_order_relaxed);
+    if (id >= MAX_FORMATS) return 0;
+    instance.formats[id] = LogFormat{ format, file, line, level };
+    instance.formatCount.store(id + 1, std::memory_order_release);
+    return static_cast<uint16_t>(id);
+}
+
+// printf conversion for a {:spec} placeholder; empty if the spec is not a plain numeric one
+static std::string conversionFor(const std::string& spec, const char* lengthModifier, char defaultConversion,
+                                 const char* allowedConversions) {
+    std::string conversion = "%";
+    size_t flagsEnd = spec.find_first_not_of("0123456789.-+ #");
+    if (flagsEnd == std::string::npos) {
+        return conversion + spec + lengthModifier + defaultConversion;
+    }
+    if (flagsEnd != spec.size() - 1 || !strchr(allowedConversions, spec[flagsEnd])) {
+        return std::string();
+    }
+    return conversion + spec.substr(0, flagsEnd) + lengthModifier + spec[flagsEnd];
+}
+
+void Logger::formatMessage(const char* format, const char* arguments, size_t length, std::string& out) {
+    size_t offset = 0;
+    char buffer[64];
+    for (const char* c = format; *c; c++) {
+        if (*c == '}' && c[1] == '}') {
+            out.push_back('}');
+            c++;
+            continue;
+        }
+        if (*c != '{') {
+            out.push_back(*c);
+            continue;
+        }
+        if (c[1] == '{') {
+            out.push_back('{');
+            c++;
+            continue;
+        }
+
+        const char* close = strchr(c, '}');
+        if (!close) {
+            out.append(c);
+            return;
+        }
+        std::string spec = c[1] == ':' ? std::string(c + 2, close) : std::string();
+        c = close;
+
+        // Out of arguments (or cut off by the slot size)
+        if (offset >= length) {
+            out.append("?");
+            continue;
+        }
+
+        uint8_t type = static_cast<uint8_t>(arguments[offset++]);
+        std::string conversion;
+        switch (type) {
+        case LogArgumentWriter::SIGNED: {
+            int64_t value;
+            if (offset + sizeof(value) > length) { offset = length; out.append("?"); break; }
+            memcpy(&value, arguments + offset, sizeof(value));
+            offset += sizeof(value);
+            conversion = conversionFor(spec, "ll", 'd', "dioxXuc");
+            snprintf(buffer, sizeof(buffer), conversion.empty() ? "%lld" : conversion.c_str(), static_cast<long long>(value));
+            out.append(buffer);
+            break;
+        }
+        case LogArgumentWriter::UNSIGNED: {
+            uint64_t value;
+            if (offset + sizeof(value) > length) { offset = length; out.append("?"); break; }
+            memcpy(&value, arguments + offset, sizeof(value));
+            offset += sizeof(value);
+            conversion = conversionFor(spec, "ll", 'u', "uoxX");
+            snprintf(buffer, sizeof(buffer), conversion.empty() ? "%llu" : conversion.c_str(), static_cast<unsigned long long>(value));
+            out.append(buffer);
+            break;
+        }
+        case LogArgumentWriter::FLOAT: {
+            double value;
+            if (offset + sizeof(value) > length) { offset = length; out.append("?"); break; }
+            memcpy(&value, arguments + offset, sizeof(value));
+            offset += sizeof(value);
+            conversion = conversionFor(spec, "", 'f', "fFeEgG");
+            snprintf(buffer, sizeof(buffer), conversion.empty() ? "%g" : conversion.c_str(), value);
+            out.append(buffer);
+            break;
+        }
+        case LogArgumentWriter::STRING: {
+            uint16_t size;
+            if (offset + sizeof(size) > length) { offset = length; out.append("?"); break; }
+            memcpy(&size, arguments + offset, sizeof(size));
+            offset += sizeof(size);
+            size = static_cast<uint16_t>(std::min<size_t>(size, length - offset));
+            out.append(arguments + offset, size);
+            offset += size;
+            break;
+        }
+        case LogArgumentWriter::BOOL:
+            if (offset >= length) { out.append("?"); break; }
+            out.append(arguments[offset++] ? "true" : "false");
+            break;
+        default:
+            // Corrupt record: stop decoding arguments
+            offset = length;
+            out.append("?");
+            break;
+        }
+    }
+}
+
+void Logger::startWriter() {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (writerStarted.load(std::memory_order_relaxed) || stopping.load(std::memory_order_relaxed)) return;
+    installCrashHandlers();
+    writer = std::thread(&Logger::writerLoop, this);
+    writerStarted.store(true, std::memory_order_release);
+}
+
+void Logger::writerLoop() {
+#if ARTSPACE_TRACING
+    Tracer::getInstance().setThreadName("Logger writer");
+#endif
+    for (;;) {
+        uint64_t ticket;
+        bool stop;
+        {
+            std::unique_lock<std::mutex> lock(writerMutex);
+            wakeWriter.wait_for(lock, WRITER_INTERVAL, [this]() {
+                return stopping.load(std::memory_order_relaxed) || flushRequested != flushCompleted;
+            });
+            ticket = flushRequested;
+            stop = stopping.load(std::memory_order_relaxed);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(outputMutex);
+            drain();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(writerMutex);
+            flushCompleted = ticket;
+        }
+        writerDone.notify_all();
+
+        if (stop) return;
+    }
+}
+
+void Logger::flush() {
+    if (!writerStarted.load(std::memory_order_acquire)) return;
+
+    std::unique_lock<std::mutex> lock(writerMutex);
+    if (stopping.load(std::memory_order_relaxed)) return;
+    uint64_t ticket = ++flushRequested;
+    wakeWriter.notify_one();
+    writerDone.wait(lock, [this, ticket]() {
+        return flushCompleted >= ticket || stopping.load(std::memory_order_relaxed);
+    });
+}
+
+void Logger::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        if (stopping.load(std::memory_order_relaxed)) return;
+        stopping.store(true, std::memory_order_relaxed);
+    }
+    wakeWriter.notify_one();
+    if (writer.joinable()) {
+        writer.join();
+    }
+
+    // Anything logged while the writer was stopping
+    std::lock_guard<std::mutex> lock(outputMutex);
+    drain();
+}
+
+void Logger::flushFromCrash() {
+    // The writer may be mid-batch; wait briefly for it rather than risk a deadlock
+    for (int attempt = 0; attempt < 100; attempt++) {
+        if (outputMutex.try_lock()) {
+            drain();
+            outputMutex.unlock();
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+uint64_t Logger::getDroppedCount() const {
+    return totalDropped.load(std::memory_order_relaxed);
+}
+
+void Logger::installCrashHandlers() {
+    std::set_terminate(&Logger::onTerminate);
+    std::signal(SIGSEGV, &Logger::onFatalSignal);
+    std::signal(SIGABRT, &Logger::onFatalSignal);
+    std::signal(SIGFPE, &Logger::onFatalSignal);
+    std::signal(SIGILL, &Logger::onFatalSignal);
+}
+
+void Logger::onFatalSignal(int signal) {
+    // Best effort: the process is already broken, but the last lines matter most
+    std::signal(signal, SIG_DFL);
+    instance.log(ERROR_, "Fatal signal " + std::to_string(signal));
+    instance.flushFromCrash();
+    std::raise(signal);
+}
+
+void Logger::onTerminate() {
+    instance.log(ERROR_, "Terminating: unhandled exception");
+    instance.flushFromCrash();
+    std::signal(SIGABRT, SIG_DFL);
+    std::abort();
+}
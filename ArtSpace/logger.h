@@ -0,0 +1,325 @@
+/**
+ * @file logger.h
+ * @brief Application log with a lock-free queue and a background writer thread
+ *
+ * Logging calls only copy the level, a timestamp and the message into a
+ * fixed-size slot of a bounded multi-producer ring buffer. A writer thread
+ * drains the ring in batches: it formats each line (the clock prefix is
+ * rebuilt once per second), writes the batch to the console and/or the log
+ * file, and flushes once per batch. The frame loop never waits on disk I/O.
+ *
+ * Memory is bounded: when the ring is full, new messages are dropped and
+ * counted, and the writer logs how many were lost. Messages longer than a
+ * slot are truncated.
+ *
+ * flush() blocks until everything logged so far is written. shutdown() (and
+ * the destructor) drain and stop the writer. On a crash (fatal signal or
+ * std::terminate) the ring is written out from the crashing thread before the
+ * process dies.
+ *
+ * The LOG_* macros are the cheap way in. A level below ARTSPACE_LOG_LEVEL
+ * compiles to nothing; a level disabled at run time skips evaluating the
+ * arguments. Otherwise the call copies a format id and the raw argument
+ * values (integers, floats, strings) into the slot, with no heap allocation.
+ * The text is only produced by the writer. Placeholders are {} or a printf
+ * spec such as {:.2f} or {:08x}.
+ *
+ * With enableBinaryLogging() the writer also stores the records unformatted;
+ * tools/log_decode.cpp turns such a file back into text.
+ *
+ * Usage:
+ *    Logger& logger = Logger::getInstance();
+ *    logger.enableFileLogging(true, "artspace.log");
+ *    logger.logInfo("Application started");
+ *    LOG_INFO("Loaded image {} ({}x{}) in {:.1f} ms", path, width, height, milliseconds);
+ *
+ *    // Every line also goes to an observer, on the writer thread
+ *    logger.setLineObserver([](const std::string& line, Logger::TimePoint when) { ... });
+ *
+ *    logger.shutdown();  // At exit
+ */
+
+#pragma once
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+// Compile-time floor for the LOG_* macros: 0 debug, 1 info, 2 warning, 3 error
+#ifndef ARTSPACE_LOG_LEVEL
+#ifdef NDEBUG
+#define ARTSPACE_LOG_LEVEL 1
+#else
+#define ARTSPACE_LOG_LEVEL 0
+#endif
+#endif
+
+// Typed argument values packed into a log record
+class LogArgumentWriter {
+public:
+    enum Type : uint8_t {
+        SIGNED = 1,
+        UNSIGNED,
+        FLOAT,
+        STRING,
+        BOOL
+    };
+
+private:
+    char* data;
+    size_t capacity;
+    size_t used;
+    bool full;
+
+    bool reserve(size_t bytes) {
+        if (full || used + bytes > capacity) {
+            full = true;
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T>
+    void putValue(Type type, T value) {
+        if (!reserve(1 + sizeof(T))) return;
+        data[used++] = static_cast<char>(type);
+        memcpy(data + used, &value, sizeof(T));
+        used += sizeof(T);
+    }
+
+    void putString(const char* text, size_t length) {
+        if (!reserve(3)) return;
+        length = std::min(length, std::min(capacity - used - 3, static_cast<size_t>(UINT16_MAX)));
+        uint16_t stored = static_cast<uint16_t>(length);
+        data[used++] = static_cast<char>(STRING);
+        memcpy(data + used, &stored, sizeof(stored));
+        memcpy(data + used + sizeof(stored), text, length);
+        used += sizeof(stored) + length;
+    }
+
+public:
+    LogArgumentWriter(char* buffer, size_t size) : data(buffer), capacity(size), used(0), full(false) {}
+
+    size_t size() const { return used; }
+
+    void put(bool value) { putValue(BOOL, static_cast<uint8_t>(value)); }
+    void put(char value) { putString(&value, 1); }
+    void put(const char* text) { putString(text ? text : "(null)", text ? strlen(text) : 6); }
+    void put(const std::string& text) { putString(text.data(), text.size()); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type put(T value) {
+        putValue(SIGNED, static_cast<int64_t>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type put(T value) {
+        putValue(UNSIGNED, static_cast<uint64_t>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type put(T value) {
+        putValue(FLOAT, static_cast<double>(value));
+    }
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value>::type put(T value) {
+        putValue(SIGNED, static_cast<int64_t>(value));
+    }
+};
+
+class Logger {
+public:
+    // Ordered by severity; the values match ARTSPACE_LOG_LEVEL
+    enum LogLevel {
+        DEBUG,
+        INFO,
+        WARNING,
+        ERROR_
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    typedef Clock::time_point TimePoint;
+    typedef std::function<void(const std::string& line, TimePoint when)> LineObserver;
+
+    // Ring size (a power of two) and the longest message kept in full
+    static constexpr size_t QUEUE_CAPACITY = 2048;
+    static constexpr size_t MAX_MESSAGE_LENGTH = 480;
+    // Distinct LOG_* call sites
+    static constexpr size_t MAX_FORMATS = 1024;
+
+    // A LOG_* call site; format id 0 means a plain text message
+    struct LogFormat {
+        const char* format;
+        const char* file;
+        int line;
+        LogLevel level;
+    };
+
+private:
+    struct Record {
+        std::atomic<size_t> sequence;   // Slot state for the ring (see claimSlot)
+        LogLevel level;
+        uint16_t formatId;
+        TimePoint time;
+        uint32_t length;
+        char text[MAX_MESSAGE_LENGTH];  // Message text, or packed arguments
+    };
+
+    static Logger instance;
+
+    // Sinks (guarded by outputMutex once the writer runs)
+    bool consoleLogging;
+    bool fileLogging;
+    std::string logFilePath;
+    std::ofstream logFile;
+    std::ofstream binaryFile;
+    size_t binaryFormatsWritten;
+    std::atomic<int> minLevel;
+    LineObserver observer;
+
+    // Call sites registered by the LOG_* macros (slot 0 unused)
+    LogFormat formats[MAX_FORMATS];
+    std::atomic<size_t> formatCount;
+    std::mutex formatMutex;
+
+    // Bounded multi-producer, single-consumer ring
+    std::unique_ptr<Record[]> records;
+    std::atomic<size_t> enqueuePosition;
+    std::atomic<size_t> dequeuePosition;    // Advanced by the writer only
+    std::atomic<uint64_t> droppedMessages;  // Not yet reported by the writer
+    std::atomic<uint64_t> totalDropped;
+
+    // Writer thread
+    std::thread writer;
+    std::mutex writerMutex;
+    std::condition_variable wakeWriter;
+    std::condition_variable writerDone;
+    std::mutex outputMutex;             // Held while draining and while sinks change
+    std::atomic<bool> writerStarted;
+    std::atomic<bool> stopping;
+    uint64_t flushRequested;
+    uint64_t flushCompleted;
+
+    // Clock prefix, rebuilt when the second changes
+    TimePoint steadyOrigin;
+    std::chrono::system_clock::time_point wallOrigin;
+    std::time_t stampSecond;
+    char stamp[16];
+
+    // Private constructor (singleton)
+    Logger();
+
+    // Reserve the next free slot; null (and counted as dropped) when full
+    Record* claimSlot(size_t& position);
+    void publishSlot(Record* record, size_t position, LogLevel level);
+    bool hasPending() const;
+    void writeBinary(std::string& batch, const Record& record);
+    // Format and write everything queued; caller holds outputMutex
+    void drain();
+    void writerLoop();
+    void startWriter();
+    const char* stampFor(TimePoint time);
+
+    static void installCrashHandlers();
+    static void onFatalSignal(int signal);
+    static void onTerminate();
+
+public:
+    // Delete copy constructor and assignment operator
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Destructor
+    ~Logger();
+
+    // Get singleton instance
+    static Logger& getInstance();
+
+    // Configuration
+    void enableConsoleLogging(bool enable);
+    void enableFileLogging(bool enable, const std::string& filePath = "artspace.log");
+    void setMinimumLogLevel(LogLevel level);
+    bool isLevelEnabled(LogLevel level) const { return level >= minLevel.load(std::memory_order_relaxed); }
+    void setLineObserver(LineObserver callback);
+
+    // Logging methods
+    void logInfo(const std::string& message);
+    void logWarning(const std::string& message);
+    void logError(const std::string& message);
+    void logDebug(const std::string& message);
+
+    // Log with custom level
+    void log(LogLevel level, const std::string& message);
+
+    // Deferred formatting (use the LOG_* macros)
+    static uint16_t registerFormat(LogLevel level, const char* format, const char* file, int line);
+    template <typename... Args>
+    void logFormat(LogLevel level, uint16_t formatId, const Args&... args);
+
+    // Expand a format with packed arguments (writer thread and log_decode)
+    static void formatMessage(const char* format, const char* arguments, size_t length, std::string& out);
+
+    // Also keep the unformatted records in a binary file
+    bool enableBinaryLogging(bool enable, const std::string& filePath = "artspace.binlog");
+
+    // Block until everything logged so far has been written
+    void flush();
+    // Drain the queue and stop the writer thread (safe to call more than once)
+    void shutdown();
+    // Write out the queue from the calling thread; for crash handlers
+    void flushFromCrash();
+
+    // Messages lost to a full queue since startup
+    uint64_t getDroppedCount() const;
+};
+
+template <typename... Args>
+void Logger::logFormat(LogLevel level, uint16_t formatId, const Args&... args) {
+    if (formatId == 0) return;  // Format table full
+    if (!writerStarted.load(std::memory_order_acquire)) {
+        startWriter();
+    }
+
+    size_t position;
+    Record* record = claimSlot(position);
+    if (!record) return;
+
+    LogArgumentWriter writer(record->text, MAX_MESSAGE_LENGTH);
+    (writer.put(args), ...);
+    record->formatId = formatId;
+    record->length = static_cast<uint32_t>(writer.size());
+    publishSlot(record, position, level);
+}
+
+#define ARTSPACE_LOG(level, format, ...) \
+    do { \
+        if (Logger::getInstance().isLevelEnabled(level)) { \
+            static const uint16_t artspaceLogFormat = Logger::registerFormat(level, format, __FILE__, __LINE__); \
+            Logger::getInstance().logFormat(level, artspaceLogFormat, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
+#if ARTSPACE_LOG_LEVEL <= 0
+#define LOG_DEBUG(format, ...) ARTSPACE_LOG(Logger::DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(format, ...) ((void)0)
+#endif
+#if ARTSPACE_LOG_LEVEL <= 1
+#define LOG_INFO(format, ...) ARTSPACE_LOG(Logger::INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_INFO(format, ...) ((void)0)
+#endif
+#if ARTSPACE_LOG_LEVEL <= 2
+#define LOG_WARN(format, ...) ARTSPACE_LOG(Logger::WARNING, format, ##__VA_ARGS__)
+#else
+#define LOG_WARN(format, ...) ((void)0)
+#endif
+#define LOG_ERROR(format, ...) ARTSPACE_LOG(Logger::ERROR_, format, ##__VA_ARGS__)
@@ -3,6 +3,12 @@
 #include <iostream>
 #include "game_manager.h"
 #include "config.h"
+#include "profiler.h"
+#include "hitch_monitor.h"
+#include "input_latency.h"
+#include "input_recorder.h"
+#include "frame_scheduler.h"
+#include "trace.h"
 
 void display();
 void reshape(int width, int height);
@@ -12,6 +18,7 @@ void specialKeyboard(int key, int x, int y);
 void specialKeyboardUp(int key, int x, int y);
 void mouseMotion(int x, int y);
 void mouseButton(int button, int state, int x, int y);
+void windowEntry(int state);
 void idle();
 void cleanup();
 
@@ -20,6 +27,13 @@ void display() {
 
     GameManager::getInstance()->render();
     glutSwapBuffers();
+    InputLatency::getInstance().notePresent(Profiler::now());
+    
+    // Frame boundary for the profiler statistics
+    Profiler::getInstance().endFrame();
+    TRACE_COUNTER("Frame ms", Profiler::getInstance().getLastFrameMs());
+    HitchMonitor::getInstance().endFrame();
+    GameManager::getInstance()->endFrame();
 }
 
 
@@ -32,59 +46,80 @@ void reshape(int width, int height) {
 
     Config::getInstance().setScreenWidth(width);
     Config::getInstance().setScreenHeight(height);
+    FrameScheduler::getInstance().requestRedraw();
 }
 
 
 void idle() {
+    // A finished replay exits; the status tells a regression run whether the state drifted
+    if (GameManager::getInstance()->isReplayFinished()) {
+        int status = InputRecorder::getInstance().getMismatches() > 0 ? 1 : 0;
+        cleanup();
+        exit(status);
+    }
+    
+    // Paces frames, and draws nothing while the scene is still
+    if (!FrameScheduler::getInstance().waitForFrame()) return;
 
-    float deltaTime = GameManager::getInstance()->getDeltaTime();
-    GameManager::getInstance()->update(deltaTime);
+    GameManager::getInstance()->advanceFrame();
     glutPostRedisplay();
 }
 
 
 void keyboard(unsigned char key, int x, int y) {
-    if (key == 27) { // ESC key
-        cleanup();
+    FrameScheduler::getInstance().requestRedraw();
+    
+    // ESC exits, unless it is closing the search box
+    if (key == 27 && !GameManager::getInstance()->isSearchOpen()) {
         cleanup();
         exit(0);
     }
     
-    // Forward to game manager
-    GameManager::getInstance()->handleKeyPress(key, x, y);
-    
-    // Forward to game manager
+    // Forward to game manager (once, so typed text is not doubled)
     GameManager::getInstance()->handleKeyPress(key, x, y);
 }
 
 // Keyboard up callback function - called when a key is released
 void keyboardUp(unsigned char key, int x, int y) {
+    FrameScheduler::getInstance().requestRedraw();
     GameManager::getInstance()->handleKeyRelease(key, x, y);
 }
 
 
 void specialKeyboard(int key, int x, int y) {
-
+    FrameScheduler::getInstance().requestRedraw();
+    GameManager::getInstance()->handleSpecialKeyPress(key, x, y);
 }
 
 
 void specialKeyboardUp(int key, int x, int y) {
-
+    FrameScheduler::getInstance().requestRedraw();
+    GameManager::getInstance()->handleSpecialKeyRelease(key, x, y);
 }
 
 
 void mouseMotion(int x, int y) {
+    FrameScheduler::getInstance().requestRedraw();
     GameManager::getInstance()->handleMouseMotion(x, y);
 }
 
 void mouseButton(int button, int state, int x, int y) {
+    FrameScheduler::getInstance().requestRedraw();
     GameManager::getInstance()->handleMouseButton(button, state, x, y);
 }
 
+void windowEntry(int state) {
+    GameManager::getInstance()->handleWindowEntry(state);
+}
+
 
 void cleanup() {
 
+    FrameScheduler::getInstance().shutdown();
     delete GameManager::getInstance();
+    
+    // Write out whatever is still queued
+    Logger::getInstance().shutdown();
 }
 
 
@@ -95,6 +130,33 @@ int main(int argc, char** argv) {
 
     
     Config& config = Config::getInstance();
+
+    // Optional exhibition catalog: ArtSpace --catalog <file>
+    // Startup trace: ArtSpace --trace <file.json>
+    // Input recording: ArtSpace --record <file>, replayed with --replay <file> [--replay-speed max]
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string(argv[i]) == "--catalog") {
+            config.setCatalogPath(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--trace") {
+            config.setTracePath(argv[i + 1]);
+            config.setTraceAtStartup(true);
+        }
+        else if (std::string(argv[i]) == "--record") {
+            config.setInputRecordPath(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--replay") {
+            config.setInputReplayPath(argv[i + 1]);
+        }
+        else if (std::string(argv[i]) == "--replay-speed") {
+            config.setReplayMaxSpeed(std::string(argv[i + 1]) == "max");
+        }
+    }
+    
+    Tracer::getInstance().setThreadName("Main");
+    if (config.isTraceAtStartup()) {
+        Tracer::getInstance().start();
+    }
     int width = config.getScreenWidth();
     int height = config.getScreenHeight();
 
@@ -108,19 +170,18 @@ int main(int argc, char** argv) {
     glutIdleFunc(idle);
     glutKeyboardFunc(keyboard);
     glutKeyboardUpFunc(keyboardUp);
+    glutSpecialFunc(specialKeyboard);
+    glutSpecialUpFunc(specialKeyboardUp);
     glutMotionFunc(mouseMotion);
     glutPassiveMotionFunc(mouseMotion);
     glutMouseFunc(mouseButton);
-    glutMotionFunc(mouseMotion);
-    glutPassiveMotionFunc(mouseMotion);
-    glutMouseFunc(mouseButton);
+    glutEntryFunc(windowEntry);
 
     // Enable depth testing
     glEnable(GL_DEPTH_TEST);
 
     GameManager::getInstance()->init();
-
-    glutWarpPointer(width / 2, height / 2);
+    FrameScheduler::getInstance().init();
 
     glutMainLoop();
     
@@ -1,5 +1,6 @@
 #include "navigator.h"
 #include "utility.h"
+#include "trace.h"
 
 
 
@@ -16,6 +17,9 @@ Navigator::~Navigator() {
 }
 
 void Navigator::navigateTo(Screen screen) {
+    TRACE_SCOPE("Navigator::navigateTo");
+    TRACE_INSTANT_DETAIL("Screen change", std::to_string(static_cast<int>(screen)));
+    
     // Store the previous screen for the callback
     Screen previousScreen = currentScreen;
     
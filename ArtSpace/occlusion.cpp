@@ -0,0 +1,299 @@
+#include "occlusion.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+// Largest polygon produced by clipping a quad against the near plane
+static const int MAX_CLIPPED_VERTICES = 8;
+
+// Hi-Z texels inspected per axis before moving up a level
+static const int MAX_TEST_TEXELS = 4;
+
+static double elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+OcclusionBuffer::OcclusionBuffer(int bufferWidth, int bufferHeight)
+    : width(0), height(0), hiZReady(false) {
+    memset(viewProjection, 0, sizeof(viewProjection));
+    resize(bufferWidth, bufferHeight);
+}
+
+void OcclusionBuffer::resize(int bufferWidth, int bufferHeight) {
+    width = std::max(4, (bufferWidth + 3) & ~3);
+    height = std::max(1, bufferHeight);
+
+    levels.clear();
+    levelWidths.clear();
+    levelHeights.clear();
+
+    // Halve each level (rounding up) down to a single texel
+    int w = width, h = height;
+    while (true) {
+        levels.push_back(std::vector<float>(static_cast<size_t>(w) * h, 1.0f));
+        levelWidths.push_back(w);
+        levelHeights.push_back(h);
+        if (w == 1 && h == 1) break;
+        w = (w + 1) / 2;
+        h = (h + 1) / 2;
+    }
+    hiZReady = false;
+}
+
+void OcclusionBuffer::beginFrame(const ViewFrustum& frustum) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    stats.reset();
+    memcpy(viewProjection, frustum.getViewProjection(), sizeof(viewProjection));
+    std::fill(levels[0].begin(), levels[0].end(), 1.0f);
+    hiZReady = false;
+
+    stats.rasterMs += elapsedMs(start);
+}
+
+void OcclusionBuffer::addOccluders(const std::vector<float>& quads) {
+    for (size_t i = 0; i + 12 <= quads.size(); i += 12) {
+        addOccluder(&quads[i]);
+    }
+}
+
+void OcclusionBuffer::addOccluder(const float corners[12]) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    stats.occluders++;
+
+    // Transform to clip space
+    float input[4][4];
+    const float* m = viewProjection;
+    for (int i = 0; i < 4; i++) {
+        const float* p = corners + i * 3;
+        for (int row = 0; row < 4; row++) {
+            input[i][row] = m[row] * p[0] + m[4 + row] * p[1] + m[8 + row] * p[2] + m[12 + row];
+        }
+    }
+
+    // Clip against the near plane (z + w >= 0)
+    float clipped[MAX_CLIPPED_VERTICES][4];
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        const float* current = input[i];
+        const float* next = input[(i + 1) % 4];
+        float dCurrent = current[2] + current[3];
+        float dNext = next[2] + next[3];
+
+        if (dCurrent >= 0.0f) {
+            memcpy(clipped[count++], current, sizeof(float) * 4);
+        }
+        if ((dCurrent >= 0.0f) != (dNext >= 0.0f)) {
+            float t = dCurrent / (dCurrent - dNext);
+            for (int j = 0; j < 4; j++) {
+                clipped[count][j] = current[j] + (next[j] - current[j]) * t;
+            }
+            count++;
+        }
+    }
+
+    if (count >= 3) {
+        // Project to buffer pixels and [0, 1] depth
+        float screen[MAX_CLIPPED_VERTICES][3];
+        bool valid = true;
+        for (int i = 0; i < count && valid; i++) {
+            float w = clipped[i][3];
+            if (w <= 1e-6f) {
+                valid = false;
+                break;
+            }
+            screen[i][0] = (clipped[i][0] / w * 0.5f + 0.5f) * width;
+            screen[i][1] = (clipped[i][1] / w * 0.5f + 0.5f) * height;
+            screen[i][2] = std::min(1.0f, std::max(0.0f, clipped[i][2] / w * 0.5f + 0.5f));
+        }
+
+        // Fan triangulation of the convex polygon
+        if (valid) {
+            for (int i = 1; i + 1 < count; i++) {
+                rasterizeTriangle(screen[0], screen[i], screen[i + 1]);
+            }
+        }
+    }
+
+    hiZReady = false;
+    stats.rasterMs += elapsedMs(start);
+}
+
+void OcclusionBuffer::rasterizeTriangle(const float* v0, const float* v1, const float* v2) {
+    // Twice the signed area; make the winding counter-clockwise
+    float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) - (v1[1] - v0[1]) * (v2[0] - v0[0]);
+    if (std::fabs(area) < 1e-6f) return;
+    if (area < 0.0f) {
+        std::swap(v1, v2);
+        area = -area;
+    }
+
+    // Pixel bounds, snapped to whole SIMD groups horizontally
+    int minX = std::max(0, static_cast<int>(std::floor(std::min(v0[0], std::min(v1[0], v2[0])))));
+    int maxX = std::min(width - 1, static_cast<int>(std::ceil(std::max(v0[0], std::max(v1[0], v2[0])))));
+    int minY = std::max(0, static_cast<int>(std::floor(std::min(v0[1], std::min(v1[1], v2[1])))));
+    int maxY = std::min(height - 1, static_cast<int>(std::ceil(std::max(v0[1], std::max(v1[1], v2[1])))));
+    if (minX > maxX || minY > maxY) return;
+    minX &= ~3;
+
+    stats.trianglesRasterized++;
+
+    // Edge functions E(p) = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x), inside when all >= 0
+    const float* a[3] = { v0, v1, v2 };
+    const float* b[3] = { v1, v2, v0 };
+    float stepX[3], stepY[3], rowStart[3];
+    float startX = minX + 0.5f;
+    float startY = minY + 0.5f;
+    for (int e = 0; e < 3; e++) {
+        stepX[e] = -(b[e][1] - a[e][1]);
+        stepY[e] = b[e][0] - a[e][0];
+        rowStart[e] = stepY[e] * (startY - a[e][1]) + stepX[e] * (startX - a[e][0]);
+    }
+
+    // Depth plane
+    float dzdx = ((v1[2] - v0[2]) * (v2[1] - v0[1]) - (v2[2] - v0[2]) * (v1[1] - v0[1])) / area;
+    float dzdy = ((v2[2] - v0[2]) * (v1[0] - v0[0]) - (v1[2] - v0[2]) * (v2[0] - v0[0])) / area;
+    float zRowStart = v0[2] + dzdx * (startX - v0[0]) + dzdy * (startY - v0[1]);
+
+    float* depth = levels[0].data();
+
+#ifdef OCCLUSION_USE_SSE2
+    const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 zero = _mm_setzero_ps();
+    __m128 edgeStep4[3], edgeLane[3];
+    for (int e = 0; e < 3; e++) {
+        edgeStep4[e] = _mm_set1_ps(stepX[e] * 4.0f);
+        edgeLane[e] = _mm_mul_ps(lane, _mm_set1_ps(stepX[e]));
+    }
+    const __m128 zStep4 = _mm_set1_ps(dzdx * 4.0f);
+    const __m128 zLane = _mm_mul_ps(lane, _mm_set1_ps(dzdx));
+
+    for (int y = minY; y <= maxY; y++) {
+        __m128 e0 = _mm_add_ps(_mm_set1_ps(rowStart[0]), edgeLane[0]);
+        __m128 e1 = _mm_add_ps(_mm_set1_ps(rowStart[1]), edgeLane[1]);
+        __m128 e2 = _mm_add_ps(_mm_set1_ps(rowStart[2]), edgeLane[2]);
+        __m128 z = _mm_add_ps(_mm_set1_ps(zRowStart), zLane);
+        float* row = depth + static_cast<size_t>(y) * width;
+
+        for (int x = minX; x <= maxX; x += 4) {
+            __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                _mm_cmpge_ps(e2, zero));
+            if (_mm_movemask_ps(inside)) {
+                __m128 current = _mm_loadu_ps(row + x);
+                __m128 nearest = _mm_min_ps(current, z);
+                _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+            }
+            e0 = _mm_add_ps(e0, edgeStep4[0]);
+            e1 = _mm_add_ps(e1, edgeStep4[1]);
+            e2 = _mm_add_ps(e2, edgeStep4[2]);
+            z = _mm_add_ps(z, zStep4);
+        }
+
+        for (int e = 0; e < 3; e++) rowStart[e] += stepY[e];
+        zRowStart += dzdy;
+    }
+#else
+    for (int y = minY; y <= maxY; y++) {
+        float e0 = rowStart[0], e1 = rowStart[1], e2 = rowStart[2];
+        float z = zRowStart;
+        float* row = depth + static_cast<size_t>(y) * width;
+
+        for (int x = minX; x <= maxX; x++) {
+            if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && z < row[x]) {
+                row[x] = z;
+            }
+            e0 += stepX[0];
+            e1 += stepX[1];
+            e2 += stepX[2];
+            z += dzdx;
+        }
+
+        for (int e = 0; e < 3; e++) rowStart[e] += stepY[e];
+        zRowStart += dzdy;
+    }
+#endif
+}
+
+void OcclusionBuffer::buildHiZ() {
+    for (size_t level = 1; level < levels.size(); level++) {
+        const std::vector<float>& below = levels[level - 1];
+        std::vector<float>& current = levels[level];
+        int belowWidth = levelWidths[level - 1];
+        int belowHeight = levelHeights[level - 1];
+
+        for (int y = 0; y < levelHeights[level]; y++) {
+            int y0 = y * 2;
+            int y1 = std::min(y0 + 1, belowHeight - 1);
+            for (int x = 0; x < levelWidths[level]; x++) {
+                int x0 = x * 2;
+                int x1 = std::min(x0 + 1, belowWidth - 1);
+                float farthest = std::max(
+                    std::max(below[y0 * belowWidth + x0], below[y0 * belowWidth + x1]),
+                    std::max(below[y1 * belowWidth + x0], below[y1 * belowWidth + x1]));
+                current[y * levelWidths[level] + x] = farthest;
+            }
+        }
+    }
+    hiZReady = true;
+}
+
+void OcclusionBuffer::finishOccluders() {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    buildHiZ();
+    stats.rasterMs += elapsedMs(start);
+}
+
+bool OcclusionBuffer::isOccluded(const ScreenRect& rect, float minDepth) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    stats.objectsTested++;
+
+    if (!hiZReady) {
+        buildHiZ();
+    }
+
+    // Nearest depth of the object in buffer space; anything at the near plane is visible
+    float objectDepth = minDepth * 0.5f + 0.5f;
+    bool occluded = false;
+
+    int x0 = static_cast<int>(std::floor((rect.minX * 0.5f + 0.5f) * width));
+    int x1 = static_cast<int>(std::ceil((rect.maxX * 0.5f + 0.5f) * width)) - 1;
+    int y0 = static_cast<int>(std::floor((rect.minY * 0.5f + 0.5f) * height));
+    int y1 = static_cast<int>(std::ceil((rect.maxY * 0.5f + 0.5f) * height)) - 1;
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(width - 1, x1);
+    y1 = std::min(height - 1, y1);
+
+    if (objectDepth > 0.0f && x0 <= x1 && y0 <= y1) {
+        // Coarsest detail that still keeps the footprint to a few texels
+        size_t level = 0;
+        while (level + 1 < levels.size() &&
+            ((x1 >> level) - (x0 >> level) >= MAX_TEST_TEXELS || (y1 >> level) - (y0 >> level) >= MAX_TEST_TEXELS)) {
+            level++;
+        }
+
+        const std::vector<float>& texels = levels[level];
+        int levelWidth = levelWidths[level];
+        occluded = true;
+        for (int y = y0 >> level; y <= (y1 >> level) && occluded; y++) {
+            for (int x = x0 >> level; x <= (x1 >> level); x++) {
+                if (texels[y * levelWidth + x] >= objectDepth) {
+                    occluded = false;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (occluded) {
+        stats.objectsOccluded++;
+    }
+    stats.testMs += elapsedMs(start);
+    return occluded;
+}
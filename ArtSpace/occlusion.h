@@ -0,0 +1,97 @@
+/**
+ * @file occlusion.h
+ * @brief Low-resolution CPU depth buffer for software occlusion culling
+ *
+ * Large, simple occluders (wall sections, partitions, big exhibits) are
+ * rasterized into a small depth buffer on the CPU, four pixels at a time with
+ * SSE2 where available. A hierarchical max-depth pyramid (Hi-Z) is then built
+ * from it so an object's screen rectangle can be tested against a handful of
+ * texels: the object is hidden if its nearest depth lies behind the farthest
+ * occluder depth in every texel it covers.
+ *
+ * Depths are NDC depths remapped to [0, 1] (0 = near plane, 1 = far plane).
+ * Only pixel centers covered by an occluder are written, so thin slivers around
+ * occluder silhouettes are approximated at buffer resolution.
+ *
+ * Usage:
+ *    OcclusionBuffer occlusion(256, 128);
+ *    occlusion.beginFrame(frustum);
+ *    occlusion.addOccluders(quads);      // 12 floats per world-space quad
+ *    occlusion.finishOccluders();        // builds the Hi-Z pyramid
+ *
+ *    if (!occlusion.isOccluded(rect, nearestDepth)) {
+ *        artwork->render();
+ *    }
+ *    const OcclusionStats& stats = occlusion.getStats();
+ */
+
+#pragma once
+#include <vector>
+#include "frustum.h"
+
+// Statistics for the occlusion pass of one frame
+struct OcclusionStats {
+    int occluders;            // Quads submitted
+    int trianglesRasterized;  // Triangles that reached the rasterizer
+    int objectsTested;
+    int objectsOccluded;
+    double rasterMs;          // Clearing, rasterizing and building Hi-Z
+    double testMs;            // Time spent in visibility queries
+
+    OcclusionStats() { reset(); }
+    void reset() {
+        occluders = 0;
+        trianglesRasterized = 0;
+        objectsTested = 0;
+        objectsOccluded = 0;
+        rasterMs = 0.0;
+        testMs = 0.0;
+    }
+    double totalMs() const { return rasterMs + testMs; }
+};
+
+class OcclusionBuffer {
+private:
+    int width;   // Multiple of 4 so SIMD rows never run past the end
+    int height;
+
+    // Level 0 is the full-resolution depth buffer, each level above holds the
+    // maximum depth of a 2x2 block of the level below
+    std::vector<std::vector<float>> levels;
+    std::vector<int> levelWidths;
+    std::vector<int> levelHeights;
+
+    float viewProjection[16];
+    bool hiZReady;
+    OcclusionStats stats;
+
+    void buildHiZ();
+    void rasterizeTriangle(const float* v0, const float* v1, const float* v2);
+
+public:
+    static const int DEFAULT_WIDTH = 256;
+    static const int DEFAULT_HEIGHT = 128;
+
+    OcclusionBuffer(int bufferWidth = DEFAULT_WIDTH, int bufferHeight = DEFAULT_HEIGHT);
+
+    void resize(int bufferWidth, int bufferHeight);
+
+    // Clear the buffer and take the view for this frame
+    void beginFrame(const ViewFrustum& frustum);
+
+    // Rasterize a convex world-space quad (4 points, xyz packed)
+    void addOccluder(const float corners[12]);
+    void addOccluders(const std::vector<float>& quads);
+
+    // Build the Hi-Z pyramid once all occluders are in
+    void finishOccluders();
+
+    // True if an object covering rect (NDC) whose nearest NDC depth is minDepth
+    // is hidden behind the occluders
+    bool isOccluded(const ScreenRect& rect, float minDepth);
+
+    const OcclusionStats& getStats() const { return stats; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    const float* getDepth() const { return levels.empty() ? nullptr : levels[0].data(); }
+};
@@ -0,0 +1,349 @@
+#include "profiler.h"
+#include "trace.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// Nesting depth of the open scopes on this thread
+static thread_local int scopeDepth = 0;
+
+Profiler Profiler::instance;
+
+Profiler::Profiler()
+    : enabled(true)
+    , frameIndex(0)
+    , historyHead(0)
+    , historyCount(0)
+    , lastFrameEnd(0)
+    , samplesLost(0)
+    , capturedHead(0) {
+    std::fill(frameTotals, frameTotals + MAX_SECTIONS, 0.0f);
+    std::fill(&sectionHistory[0][0], &sectionHistory[0][0] + MAX_SECTIONS * HISTORY_FRAMES, 0.0f);
+    std::fill(frameHistory, frameHistory + HISTORY_FRAMES, 0.0f);
+}
+
+Profiler& Profiler::getInstance() {
+    return instance;
+}
+
+uint64_t Profiler::now() {
+    // steady_clock is backed by QueryPerformanceCounter on Windows
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin).count());
+}
+
+int Profiler::registerSection(const char* name) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = 0; i < sectionNames.size(); i++) {
+        if (strcmp(sectionNames[i], name) == 0) return static_cast<int>(i);
+    }
+    if (sectionNames.size() >= MAX_SECTIONS) {
+        return -1;
+    }
+    sectionNames.push_back(name);
+    return static_cast<int>(sectionNames.size() - 1);
+}
+
+Profiler::ThreadBuffer* Profiler::getThreadBuffer() {
+    static thread_local ThreadBuffer* threadBuffer = nullptr;
+    if (!threadBuffer) {
+        // Buffers outlive their threads so late samples can still be drained
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+        threadBuffer = buffers.back().get();
+        threadBuffer->threadIndex = static_cast<int>(buffers.size() - 1);
+        threadBuffer->name = "Thread " + std::to_string(threadBuffer->threadIndex);
+    }
+    return threadBuffer;
+}
+
+void Profiler::record(int section, uint64_t start, uint64_t end, int depth) {
+    if (section < 0) return;
+
+    ThreadBuffer* buffer = getThreadBuffer();
+    uint64_t index = buffer->writeIndex.load(std::memory_order_relaxed);
+    if (index - buffer->readIndex.load(std::memory_order_acquire) >= ThreadBuffer::CAPACITY) {
+        buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ProfileSample& sample = buffer->samples[index & (ThreadBuffer::CAPACITY - 1)];
+    sample.start = start;
+    sample.end = end;
+    sample.frame = frameIndex.load(std::memory_order_relaxed);
+    sample.section = static_cast<uint16_t>(section);
+    sample.depth = static_cast<uint16_t>(depth);
+    buffer->writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer* buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->name = name;
+}
+
+void Profiler::drainBuffers() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    samplesLost = 0;
+    for (std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        uint64_t read = buffer->readIndex.load(std::memory_order_relaxed);
+        uint64_t write = buffer->writeIndex.load(std::memory_order_acquire);
+
+        for (; read < write; read++) {
+            const ProfileSample& sample = buffer->samples[read & (ThreadBuffer::CAPACITY - 1)];
+            frameTotals[sample.section] += (sample.end - sample.start) / 1000000.0f;
+
+            CapturedSample capture = { sample, buffer->threadIndex };
+            if (captured.size() < CAPTURE_CAPACITY) {
+                captured.push_back(capture);
+            }
+            else {
+                captured[capturedHead] = capture;
+                capturedHead = (capturedHead + 1) % CAPTURE_CAPACITY;
+            }
+        }
+
+        // Hand the slots back to the producer
+        buffer->readIndex.store(read, std::memory_order_release);
+        samplesLost += buffer->dropped.load(std::memory_order_relaxed);
+    }
+}
+
+void Profiler::endFrame() {
+    uint64_t frameEnd = now();
+    if (lastFrameEnd == 0) {
+        lastFrameEnd = frameEnd;
+    }
+    float frameMs = (frameEnd - lastFrameEnd) / 1000000.0f;
+    lastFrameEnd = frameEnd;
+
+    drainBuffers();
+
+    frameHistory[historyHead] = frameMs;
+    for (int i = 0; i < MAX_SECTIONS; i++) {
+        sectionHistory[i][historyHead] = frameTotals[i];
+        frameTotals[i] = 0.0f;
+    }
+    historyHead = (historyHead + 1) % HISTORY_FRAMES;
+    historyCount = std::min(historyCount + 1, HISTORY_FRAMES);
+
+    frameIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Profiler::computePercentiles(const float* values, int count, float& average, float& p95, float& p99) {
+    average = p95 = p99 = 0.0f;
+    if (count == 0) return;
+
+    std::vector<float> sorted(values, values + count);
+    std::sort(sorted.begin(), sorted.end());
+
+    float sum = 0.0f;
+    for (float value : sorted) sum += value;
+    average = sum / count;
+    p95 = sorted[std::min(count - 1, static_cast<int>(count * 0.95f))];
+    p99 = sorted[std::min(count - 1, static_cast<int>(count * 0.99f))];
+}
+
+void Profiler::getSectionStats(std::vector<SectionStats>& out) const {
+    out.clear();
+    int lastSlot = (historyHead + HISTORY_FRAMES - 1) % HISTORY_FRAMES;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = 0; i < sectionNames.size(); i++) {
+        SectionStats stats;
+        stats.name = sectionNames[i];
+        stats.last = historyCount > 0 ? sectionHistory[i][lastSlot] : 0.0f;
+        // The window is a ring, but order does not matter for the statistics
+        computePercentiles(sectionHistory[i], historyCount, stats.average, stats.p95, stats.p99);
+        out.push_back(stats);
+    }
+}
+
+void Profiler::getFrameStats(float& last, float& average, float& p95, float& p99) const {
+    last = getLastFrameMs();
+    computePercentiles(frameHistory, historyCount, average, p95, p99);
+}
+
+float Profiler::getLastFrameMs() const {
+    return historyCount > 0 ? frameHistory[(historyHead + HISTORY_FRAMES - 1) % HISTORY_FRAMES] : 0.0f;
+}
+
+void Profiler::getFrameHistory(std::vector<float>& out) const {
+    out.clear();
+    int first = (historyHead + HISTORY_FRAMES - historyCount) % HISTORY_FRAMES;
+    for (int i = 0; i < historyCount; i++) {
+        out.push_back(frameHistory[(first + i) % HISTORY_FRAMES]);
+    }
+}
+
+bool Profiler::dumpCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        Logger::getInstance().logError("Profiler::dumpCsv - cannot open " + path);
+        return false;
+    }
+
+    size_t written = writeSamples(file, 0);
+    Logger::getInstance().logInfo("Profiler: wrote " + std::to_string(written) + " samples to " + path);
+    return true;
+}
+
+size_t Profiler::writeSamples(std::ostream& out, uint64_t since) const {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    out << "frame,thread,section,depth,start_us,duration_us\n";
+    char line[256];
+    size_t written = 0;
+    for (size_t i = 0; i < captured.size(); i++) {
+        const CapturedSample& capture = captured[(capturedHead + i) % captured.size()];
+        const ProfileSample& sample = capture.sample;
+        if (sample.end < since) continue;
+
+        snprintf(line, sizeof(line), "%u,%s,%s,%u,%.3f,%.3f\n",
+            sample.frame,
+            buffers[capture.threadIndex]->name.c_str(),
+            sectionNames[sample.section],
+            static_cast<unsigned>(sample.depth),
+            sample.start / 1000.0,
+            (sample.end - sample.start) / 1000.0);
+        out << line;
+        written++;
+    }
+    return written;
+}
+
+// ProfileScope implementation
+ProfileScope::ProfileScope(int sectionId, const char* sectionName)
+    : start(0)
+    , name(sectionName)
+    , section(sectionId)
+    , depth(0)
+    , profiling(sectionId >= 0 && Profiler::getInstance().isEnabled())
+    , tracing(Tracer::isActive()) {
+    if (profiling) {
+        depth = scopeDepth++;
+    }
+    if (profiling || tracing) {
+        start = Profiler::now();
+    }
+}
+
+ProfileScope::~ProfileScope() {
+    if (!profiling && !tracing) return;
+
+    uint64_t end = Profiler::now();
+    if (profiling) {
+        scopeDepth--;
+        Profiler::getInstance().record(section, start, end, depth);
+    }
+    if (tracing) {
+        Tracer::getInstance().complete(name, start, end, std::string());
+    }
+}
+
+// ProfilerHud implementation
+static const float HUD_LINE_HEIGHT = 14.0f;
+static const float HUD_GRAPH_HEIGHT = 60.0f;
+static const float HUD_PADDING = 6.0f;
+
+ProfilerHud::ProfilerHud()
+    : budgetMs(1000.0f / 60.0f) {
+    size[0] = 380.0f;
+    size[1] = 0.0f;
+}
+
+void ProfilerHud::update(float deltaTime) {
+    Profiler& profiler = Profiler::getInstance();
+    profiler.getSectionStats(stats);
+    profiler.getFrameHistory(history);
+
+    // Header, column titles and one line per section above the graph
+    size[1] = HUD_PADDING * 3 + HUD_GRAPH_HEIGHT + HUD_LINE_HEIGHT * (stats.size() + statusLines.size() + 2);
+    markDirty();
+}
+
+void ProfilerHud::setStatusLine(const std::string& text) {
+    statusLines.clear();
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        statusLines.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+void ProfilerHud::render() {
+    if (!isVisible) return;
+
+    float left = position[0];
+    float bottom = position[1];
+    float top = position[1] + size[1];
+    float right = position[0] + size[0];
+
+    // Background
+    glColor4f(0.0f, 0.0f, 0.0f, 0.65f * alpha);
+    glBegin(GL_QUADS);
+    glVertex2f(left, bottom);
+    glVertex2f(right, bottom);
+    glVertex2f(right, top);
+    glVertex2f(left, top);
+    glEnd();
+
+    float white[4] = { 1.0f, 1.0f, 1.0f, alpha };
+    float grey[4] = { 0.7f, 0.7f, 0.7f, alpha };
+    char line[128];
+
+    float last, average, p95, p99;
+    Profiler::getInstance().getFrameStats(last, average, p95, p99);
+    float y = top - HUD_PADDING - HUD_LINE_HEIGHT + 3.0f;
+    snprintf(line, sizeof(line), "Frame %.2f ms  avg %.2f  p95 %.2f  p99 %.2f  (%.0f fps)",
+        last, average, p95, p99, average > 0.0f ? 1000.0f / average : 0.0f);
+    renderText(left + HUD_PADDING, y, line, white);
+
+    for (const std::string& status : statusLines) {
+        y -= HUD_LINE_HEIGHT;
+        renderText(left + HUD_PADDING, y, status, grey);
+    }
+
+    y -= HUD_LINE_HEIGHT;
+    snprintf(line, sizeof(line), "%-16s %7s %7s %7s %7s", "section (ms)", "last", "avg", "p95", "p99");
+    renderText(left + HUD_PADDING, y, line, grey);
+
+    for (const Profiler::SectionStats& section : stats) {
+        y -= HUD_LINE_HEIGHT;
+        snprintf(line, sizeof(line), "%-16.16s %7.2f %7.2f %7.2f %7.2f",
+            section.name.c_str(), section.last, section.average, section.p95, section.p99);
+        renderText(left + HUD_PADDING, y, line, white);
+    }
+
+    // Frame time graph; the scale shows at least twice the budget
+    float graphLeft = left + HUD_PADDING;
+    float graphRight = right - HUD_PADDING;
+    float graphBottom = bottom + HUD_PADDING;
+    float scaleMs = budgetMs * 2.0f;
+    for (float value : history) {
+        scaleMs = std::max(scaleMs, value);
+    }
+    float pixelsPerMs = HUD_GRAPH_HEIGHT / scaleMs;
+
+    glColor4f(0.3f, 0.8f, 0.3f, 0.6f * alpha);
+    glBegin(GL_LINES);
+    glVertex2f(graphLeft, graphBottom + budgetMs * pixelsPerMs);
+    glVertex2f(graphRight, graphBottom + budgetMs * pixelsPerMs);
+    glEnd();
+
+    if (history.size() > 1) {
+        float step = (graphRight - graphLeft) / (Profiler::HISTORY_FRAMES - 1);
+        float x = graphRight - step * (history.size() - 1);
+        glColor4f(1.0f, 0.8f, 0.2f, alpha);
+        glBegin(GL_LINE_STRIP);
+        for (float value : history) {
+            glVertex2f(x, graphBottom + value * pixelsPerMs);
+            x += step;
+        }
+        glEnd();
+    }
+}
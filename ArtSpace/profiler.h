@@ -0,0 +1,200 @@
+/**
+ * @file profiler.h
+ * @brief Scoped CPU frame profiler with per-thread sample rings, on-screen HUD and CSV export
+ *
+ * PROFILE_SCOPE("Name") times the enclosing block with a high-resolution
+ * clock. Scopes nest: each sample records its depth, and a section's time is
+ * inclusive of the scopes inside it. Every thread records into its own
+ * single-producer ring buffer, so recording takes no lock. Once per frame the
+ * main thread calls endFrame(), which drains the rings into per-section
+ * per-frame totals (rolling averages, p95 and p99) and into a capture buffer
+ * that dumpCsv() writes out for offline analysis. While the tracer is
+ * running (trace.h) every scope is also recorded as a timeline event.
+ *
+ * Usage:
+ *    void GameManager::update(float deltaTime) {
+ *        PROFILE_SCOPE("Update");
+ *        {
+ *            PROFILE_SCOPE("Camera");
+ *            camera->update(deltaTime);
+ *        }
+ *    }
+ *
+ *    // After the frame has been presented:
+ *    Profiler::getInstance().endFrame();
+ *
+ *    // HUD (UI component, drawn in screen space):
+ *    ProfilerHud* hud = new ProfilerHud();
+ *    hud->render();
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "utility.h"
+
+// One timed scope
+struct ProfileSample {
+    uint64_t start;     // Nanoseconds since the profiler started
+    uint64_t end;
+    uint32_t frame;
+    uint16_t section;
+    uint16_t depth;     // Nesting level, 0 for outermost scopes
+};
+
+class Profiler {
+public:
+    static constexpr int MAX_SECTIONS = 64;
+    static constexpr int HISTORY_FRAMES = 240;
+
+    struct SectionStats {
+        std::string name;
+        float last;     // Milliseconds in the last frame
+        float average;  // Over the history window
+        float p95;
+        float p99;
+    };
+
+private:
+    // Single-producer ring owned by one thread; drained by the main thread.
+    // A full ring drops new samples rather than overwrite unread ones.
+    struct ThreadBuffer {
+        static constexpr uint32_t CAPACITY = 8192;  // Power of two
+        ProfileSample samples[CAPACITY];
+        std::atomic<uint64_t> writeIndex;
+        std::atomic<uint64_t> readIndex;
+        std::atomic<uint64_t> dropped;
+        int threadIndex;
+        std::string name;
+
+        ThreadBuffer() : writeIndex(0), readIndex(0), dropped(0), threadIndex(0) {}
+    };
+
+    // Drained sample kept for CSV export
+    struct CapturedSample {
+        ProfileSample sample;
+        int threadIndex;
+    };
+
+    static Profiler instance;
+
+    std::atomic<bool> enabled;
+    std::atomic<uint32_t> frameIndex;
+
+    // Registered sections and thread buffers (guarded by registryMutex)
+    mutable std::mutex registryMutex;
+    std::vector<const char*> sectionNames;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    // Rolling per-frame statistics (main thread)
+    float frameTotals[MAX_SECTIONS];
+    float sectionHistory[MAX_SECTIONS][HISTORY_FRAMES];
+    float frameHistory[HISTORY_FRAMES];
+    int historyHead;
+    int historyCount;
+    uint64_t lastFrameEnd;
+    uint64_t samplesLost;
+
+    // Most recent drained samples for CSV export
+    std::vector<CapturedSample> captured;
+    size_t capturedHead;
+    static constexpr size_t CAPTURE_CAPACITY = 1 << 16;
+
+    Profiler();
+
+    ThreadBuffer* getThreadBuffer();
+    void drainBuffers();
+    static void computePercentiles(const float* values, int count, float& average, float& p95, float& p99);
+
+public:
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& getInstance();
+
+    // High-resolution clock in nanoseconds since the profiler started
+    static uint64_t now();
+
+    // Section ids are stable; PROFILE_SCOPE registers each name once.
+    // The name must outlive the profiler (a string literal).
+    int registerSection(const char* name);
+
+    // Record a finished scope on the calling thread (lock-free)
+    void record(int section, uint64_t start, uint64_t end, int depth);
+
+    // Name the calling thread in exports ("Main", "Catalog loader"...)
+    void setThreadName(const std::string& name);
+
+    // Close the current frame: drain the thread rings and update the statistics
+    void endFrame();
+    // Time the next frame from now (after an idle wait that isn't frame time)
+    void restartFrame() { lastFrameEnd = now(); }
+
+    void setEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+    uint32_t getFrameIndex() const { return frameIndex.load(std::memory_order_relaxed); }
+
+    // Statistics over the last HISTORY_FRAMES frames
+    void getSectionStats(std::vector<SectionStats>& out) const;
+    void getFrameStats(float& last, float& average, float& p95, float& p99) const;
+    float getLastFrameMs() const;
+    // Frame times in milliseconds, oldest first
+    void getFrameHistory(std::vector<float>& out) const;
+    // Samples dropped so far because a thread filled its ring between two endFrame() calls
+    uint64_t getSamplesLost() const { return samplesLost; }
+
+    // Write the captured samples as CSV (frame, thread, section, depth, start and duration in microseconds)
+    bool dumpCsv(const std::string& path) const;
+    // Same CSV for the samples that ended at or after since (see now()); returns the row count
+    size_t writeSamples(std::ostream& out, uint64_t since) const;
+};
+
+// Times its lifetime into a profiler section
+class ProfileScope {
+private:
+    uint64_t start;
+    const char* name;
+    int section;
+    int depth;
+    bool profiling;
+    bool tracing;
+
+public:
+    ProfileScope(int sectionId, const char* sectionName);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_CONCAT(profileSection_, __LINE__) = Profiler::getInstance().registerSection(name); \
+    ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(PROFILE_CONCAT(profileSection_, __LINE__), name)
+
+// Frame time graph and per-section table
+class ProfilerHud : public UIComponent {
+private:
+    float budgetMs;     // Reference line on the graph
+    std::vector<Profiler::SectionStats> stats;
+    std::vector<float> history;
+    std::vector<std::string> statusLines;
+
+public:
+    ProfilerHud();
+    ~ProfilerHud() override = default;
+
+    // Refresh the statistics and the HUD height
+    void update(float deltaTime) override;
+    void render() override;
+    void setBudget(float milliseconds) { budgetMs = milliseconds; }
+    // Extra lines under the frame summary (CPU usage, pacing mode...), split at '\n'
+    void setStatusLine(const std::string& text);
+};
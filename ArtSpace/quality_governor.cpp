@@ -0,0 +1,151 @@
+#include "quality_governor.h"
+#include "utility.h"
+#include <algorithm>
+#include <cstdio>
+
+QualityGovernor QualityGovernor::instance;
+
+const QualityTier QualityGovernor::tiers[QualityGovernor::TIER_COUNT] = {
+    //  name      scale  bias  texture  distance  portals
+    { "Low",      0.50f, 1.0f,  512,    20.0f,    2 },
+    { "Medium",   0.75f, 0.5f,  1024,   35.0f,    4 },
+    { "High",     1.00f, 0.0f,  2048,   60.0f,    6 },
+    { "Ultra",    1.00f, 0.0f,  0,      0.0f,     8 },
+};
+
+// Samples per evaluation window
+const size_t SAMPLE_WINDOW = 30;
+// Step down when the window's 90th percentile exceeds this share of the budget
+const float DOWNGRADE_RATIO = 0.95f;
+// Step up when it stays below this share (a tier up costs up to ~1.8x)
+const float UPGRADE_RATIO = 0.55f;
+// The startup benchmark leaves this much of the budget unused
+const float BENCHMARK_RATIO = 0.8f;
+// Seconds between steps down, and of sustained headroom before a step up
+const double DOWNGRADE_INTERVAL = 1.0;
+const double UPGRADE_DELAY = 5.0;
+// A step up undone within this many seconds blocks step-ups for the lockout
+const double FAILED_UPGRADE_WINDOW = 10.0;
+const double UPGRADE_LOCKOUT = 60.0;
+
+QualityGovernor::QualityGovernor()
+    : tier(TIER_COUNT - 1)
+    , adaptive(true)
+    , budgetMs(1000.0f / 60.0f)
+    , windowSize(SAMPLE_WINDOW)
+    , hasHeadroom(false)
+    , lastChangeWasUpgrade(false) {
+    samples.reserve(windowSize);
+}
+
+QualityGovernor& QualityGovernor::getInstance() {
+    return instance;
+}
+
+const QualityTier& QualityGovernor::getTier(int index) {
+    return tiers[std::max(0, std::min(index, TIER_COUNT - 1))];
+}
+
+void QualityGovernor::setTier(int index) {
+    tier = std::max(0, std::min(index, TIER_COUNT - 1));
+    samples.clear();
+    hasHeadroom = false;
+    lastChangeWasUpgrade = false;
+    lastChange = Clock::now();
+    if (onChange) {
+        onChange(tiers[tier]);
+    }
+}
+
+void QualityGovernor::setTargetFrameRate(float fps) {
+    budgetMs = 1000.0f / (fps > 0.0f ? fps : 60.0f);
+}
+
+void QualityGovernor::setAdaptive(bool enable) {
+    adaptive = enable;
+    samples.clear();
+    hasHeadroom = false;
+}
+
+int QualityGovernor::runBenchmark(const std::function<float()>& measure) {
+    int chosen = 0;
+    for (int index = TIER_COUNT - 1; index >= 0; index--) {
+        setTier(index);
+        float frameMs = measure();
+
+        char line[128];
+        snprintf(line, sizeof(line), "Quality benchmark - %s: %.2f ms (budget %.2f ms)",
+            tiers[index].name, frameMs, budgetMs);
+        Logger::getInstance().logInfo(line);
+
+        if (frameMs <= budgetMs * BENCHMARK_RATIO) {
+            chosen = index;
+            break;
+        }
+    }
+
+    if (chosen != tier) {
+        setTier(chosen);
+    }
+    Logger::getInstance().logInfo(std::string("Quality tier: ") + tiers[chosen].name);
+    return chosen;
+}
+
+void QualityGovernor::addFrameSample(float workMs) {
+    if (!adaptive) return;
+
+    samples.push_back(workMs);
+    if (samples.size() >= windowSize) {
+        evaluateWindow();
+        samples.clear();
+    }
+}
+
+void QualityGovernor::evaluateWindow() {
+    // 90th percentile: a few slow frames (loading, OS hiccups) do not count
+    size_t index = samples.size() * 9 / 10;
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    float p90 = samples[index];
+
+    Clock::time_point now = Clock::now();
+    double sinceChange = std::chrono::duration<double>(now - lastChange).count();
+
+    if (p90 > budgetMs * DOWNGRADE_RATIO) {
+        hasHeadroom = false;
+        if (tier == 0 || sinceChange < DOWNGRADE_INTERVAL) return;
+
+        // The last step up did not hold: stay at this level for a while
+        if (lastChangeWasUpgrade && sinceChange < FAILED_UPGRADE_WINDOW) {
+            upgradeBlockedUntil = now + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(UPGRADE_LOCKOUT));
+        }
+        changeTier(tier - 1, "over budget");
+        lastChangeWasUpgrade = false;
+    }
+    else if (p90 < budgetMs * UPGRADE_RATIO) {
+        if (!hasHeadroom) {
+            hasHeadroom = true;
+            headroomSince = now;
+        }
+        double headroomFor = std::chrono::duration<double>(now - headroomSince).count();
+        if (tier == TIER_COUNT - 1 || now < upgradeBlockedUntil ||
+            headroomFor < UPGRADE_DELAY || sinceChange < UPGRADE_DELAY) {
+            return;
+        }
+        changeTier(tier + 1, "headroom");
+        lastChangeWasUpgrade = true;
+        hasHeadroom = false;
+    }
+    else {
+        hasHeadroom = false;
+    }
+}
+
+void QualityGovernor::changeTier(int newTier, const char* reason) {
+    tier = newTier;
+    lastChange = Clock::now();
+    LOG_INFO("Quality tier: {} ({})", tiers[tier].name, reason);
+    if (onChange) {
+        onChange(tiers[tier]);
+    }
+}
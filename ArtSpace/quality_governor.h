@@ -0,0 +1,102 @@
+/**
+ * @file quality_governor.h
+ * @brief Render quality tiers, chosen by a startup benchmark and adjusted at run time
+ *
+ * A quality tier bundles the settings that trade image quality for frame
+ * time: the resolution of the 3D layer, the texture mip bias and largest
+ * sampled texture level, and how aggressively distant artworks and rooms
+ * are culled.
+ *
+ * At startup runBenchmark() draws the gallery at each tier, from the highest
+ * down, and keeps the first one that fits comfortably in the frame budget.
+ * While running, addFrameSample() collects the work time of frames that
+ * redrew the 3D layer. Each window of samples is reduced to its 90th
+ * percentile:
+ * - Over budget: step down a tier (at most once a second).
+ * - Well under budget for several seconds: step up a tier.
+ * A step up that has to be undone soon after blocks further step-ups for a
+ * minute, so the governor does not oscillate between two tiers.
+ *
+ * Usage:
+ *    QualityGovernor& governor = QualityGovernor::getInstance();
+ *    governor.setOnChange([](const QualityTier& tier) { applyTier(tier); });
+ *    governor.setTargetFrameRate(60.0f);
+ *    governor.runBenchmark([]() { return drawBenchmarkFrames(); });
+ *
+ *    // After each frame that redrew the scene:
+ *    governor.addFrameSample(workMs);
+ */
+
+#pragma once
+#include <chrono>
+#include <functional>
+#include <vector>
+
+struct QualityTier {
+    const char* name;
+    float renderScale;      // Fraction of the window resolution the 3D layer is drawn at
+    float mipBias;          // Positive values sample smaller, cheaper mip levels
+    int maxTextureSize;     // Largest texture level sampled (0 = full size)
+    float drawDistance;     // Artworks further away are culled (0 = unlimited)
+    int portalDepth;        // Rooms visited through doorways
+};
+
+class QualityGovernor {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static QualityGovernor instance;
+    static const QualityTier tiers[];
+
+    int tier;
+    bool adaptive;
+    float budgetMs;
+
+    // Work times of the current evaluation window
+    std::vector<float> samples;
+    size_t windowSize;
+
+    Clock::time_point lastChange;
+    Clock::time_point headroomSince;    // Start of the current run of fast windows
+    bool hasHeadroom;
+    bool lastChangeWasUpgrade;
+    Clock::time_point upgradeBlockedUntil;
+
+    std::function<void(const QualityTier&)> onChange;
+
+    QualityGovernor();
+
+    void changeTier(int newTier, const char* reason);
+    void evaluateWindow();
+
+public:
+    static const int TIER_COUNT = 4;
+
+    QualityGovernor(const QualityGovernor&) = delete;
+    QualityGovernor& operator=(const QualityGovernor&) = delete;
+
+    static QualityGovernor& getInstance();
+    static const QualityTier& getTier(int index);
+
+    // Called with the new tier whenever it changes (including setTier)
+    void setOnChange(std::function<void(const QualityTier&)> callback) { onChange = callback; }
+
+    // Select a tier directly (clamped); resets the adaptive history
+    void setTier(int index);
+    int getTierIndex() const { return tier; }
+    const QualityTier& getCurrentTier() const { return tiers[tier]; }
+
+    // Frame budget; 0 (uncapped) budgets for 60 fps
+    void setTargetFrameRate(float fps);
+    float getBudgetMs() const { return budgetMs; }
+
+    void setAdaptive(bool enable);
+    bool isAdaptive() const { return adaptive; }
+
+    // Try each tier from the top; measure returns the average frame time in ms
+    // at the tier just applied. Returns the chosen tier, which stays applied.
+    int runBenchmark(const std::function<float()>& measure);
+
+    // Work time of a frame that redrew the 3D layer
+    void addFrameSample(float workMs);
+};
@@ -0,0 +1,137 @@
+#include "render_target.h"
+#include "gl_extensions.h"
+#include "utility.h"
+
+RenderTarget::RenderTarget()
+    : framebuffer(0)
+    , colorTexture(0)
+    , depthBuffer(0)
+    , width(0)
+    , height(0) {
+}
+
+RenderTarget::~RenderTarget() {
+    destroy();
+}
+
+bool RenderTarget::create(int targetWidth, int targetHeight) {
+    destroy();
+    if (!glext.framebufferObjects || targetWidth <= 0 || targetHeight <= 0) {
+        return false;
+    }
+
+    width = targetWidth;
+    height = targetHeight;
+
+    glGenTextures(1, &colorTexture);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glext.genRenderbuffers(1, &depthBuffer);
+    glext.bindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glext.renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glext.bindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glext.genFramebuffers(1, &framebuffer);
+    glext.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glext.framebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    glext.framebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    GLenum status = glext.checkFramebufferStatus(GL_FRAMEBUFFER);
+    glext.bindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        LOG_WARN("RenderTarget - framebuffer incomplete (status {:#x})", status);
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void RenderTarget::destroy() {
+    if (framebuffer) {
+        glext.deleteFramebuffers(1, &framebuffer);
+        framebuffer = 0;
+    }
+    if (depthBuffer) {
+        glext.deleteRenderbuffers(1, &depthBuffer);
+        depthBuffer = 0;
+    }
+    if (colorTexture) {
+        glDeleteTextures(1, &colorTexture);
+        colorTexture = 0;
+    }
+    width = 0;
+    height = 0;
+}
+
+bool RenderTarget::ensureSize(int targetWidth, int targetHeight) {
+    if (isValid() && width == targetWidth && height == targetHeight) {
+        return true;
+    }
+    return create(targetWidth, targetHeight);
+}
+
+void RenderTarget::bind() {
+    bind(width, height);
+}
+
+void RenderTarget::bind(int sourceWidth, int sourceHeight) {
+    glext.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, sourceWidth, sourceHeight);
+}
+
+void RenderTarget::unbind() {
+    if (glext.framebufferObjects) {
+        glext.bindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+}
+
+void RenderTarget::present(int viewportWidth, int viewportHeight) {
+    present(viewportWidth, viewportHeight, width, height);
+}
+
+void RenderTarget::present(int viewportWidth, int viewportHeight, int sourceWidth, int sourceHeight) {
+    if (width <= 0 || height <= 0) return;
+    // Inside a partial region, stay half a texel in from its far edges so
+    // filtering never blends in texels outside it (clamp-to-edge only guards
+    // the texture's own edges)
+    float maxU = (sourceWidth < width ? sourceWidth - 0.5f : sourceWidth) / static_cast<float>(width);
+    float maxV = (sourceHeight < height ? sourceHeight - 0.5f : sourceHeight) / static_cast<float>(height);
+    glViewport(0, 0, viewportWidth, viewportHeight);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_BLEND);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    // Clip space covers the viewport exactly
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(-1.0f, -1.0f);
+    glTexCoord2f(maxU, 0.0f); glVertex2f(1.0f, -1.0f);
+    glTexCoord2f(maxU, maxV); glVertex2f(1.0f, 1.0f);
+    glTexCoord2f(0.0f, maxV); glVertex2f(-1.0f, 1.0f);
+    glEnd();
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopAttrib();
+}
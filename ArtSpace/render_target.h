@@ -0,0 +1,69 @@
+/**
+ * @file render_target.h
+ * @brief Offscreen colour + depth framebuffer that can be drawn back to the screen
+ *
+ * A RenderTarget wraps a framebuffer object with a colour texture and a depth
+ * renderbuffer. Render into it between bind() and unbind(), then present()
+ * draws the colour texture over the whole viewport. The contents persist
+ * between frames, unlike the back buffer after a swap, so a finished frame
+ * can be shown again without redrawing it.
+ *
+ * Drawing into a smaller region than the allocation (bind(w, h), then
+ * present() with the same source size) changes the effective resolution
+ * without reallocating, which is how dynamic resolution scales each frame.
+ *
+ * Needs framebuffer objects (gl_extensions.h); create() fails without them
+ * and callers fall back to rendering straight to the window.
+ *
+ * Usage:
+ *    RenderTarget target;
+ *    if (target.ensureSize(width, height)) {
+ *        target.bind();
+ *        drawScene();
+ *        RenderTarget::unbind();
+ *        target.present(width, height);
+ *    }
+ */
+
+#pragma once
+#include <GL/glut.h>
+
+class RenderTarget {
+private:
+    GLuint framebuffer;
+    GLuint colorTexture;
+    GLuint depthBuffer;
+    int width;
+    int height;
+
+public:
+    RenderTarget();
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // (Re)create the buffers; false if framebuffer objects are unavailable or incomplete
+    bool create(int targetWidth, int targetHeight);
+    void destroy();
+
+    // Create or resize only when the size changed
+    bool ensureSize(int targetWidth, int targetHeight);
+
+    bool isValid() const { return framebuffer != 0; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    GLuint getColorTexture() const { return colorTexture; }
+
+    // Redirect rendering into this target (sets the viewport to its size)
+    void bind();
+    // Same, with the viewport limited to the lower-left sourceWidth x sourceHeight
+    void bind(int sourceWidth, int sourceHeight);
+    // Back to the window's framebuffer
+    static void unbind();
+
+    // Draw the colour texture over a viewport of the given size
+    void present(int viewportWidth, int viewportHeight);
+    // Stretch only the lower-left region drawn by bind(sourceWidth, sourceHeight)
+    void present(int viewportWidth, int viewportHeight, int sourceWidth, int sourceHeight);
+};
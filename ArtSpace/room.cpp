@@ -5,6 +5,13 @@
 #include <fstream>
 #include <cstdlib>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
+#include "trace.h"
+#include "hitch_monitor.h"
+
+// Width of the wooden trim drawn around door openings
+const float DOOR_TRIM_WIDTH = 0.25f;
 
 // BMP file header structure
 #pragma pack(push, 1)
@@ -32,6 +39,11 @@ Room::Room(float width, float height, float depth) {
     ROOM_HEIGHT = height;
     ROOM_DEPTH = depth;
 
+    // Rooms start centered at the origin
+    position[0] = 0.0f;
+    position[1] = 0.0f;
+    position[2] = 0.0f;
+
     // Initialize texture IDs to 0
     wallTextureID = 0;
     floorTextureID = 0;
@@ -71,58 +83,42 @@ void Room::render() {
     float floorRepeat = 4.0f; // Repeat texture 4 times on floor 
     float ceilingRepeat = 1.0f; // Repeat texture 4 times on  ceiling
 
-    // Draw back wall
-    drawTexturedQuad(
-        -ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        wallTextureID, wallRepeat
-    );
+    // Draw the four walls, leaving openings for doors
+    drawWall(WALL_BACK, wallTextureID, wallRepeat);
+    drawWall(WALL_LEFT, wallTextureID, wallRepeat);
+    drawWall(WALL_RIGHT, wallTextureID, wallRepeat);
+    drawWall(WALL_FRONT, wallTextureID, wallRepeat);
 
-    // Draw left wall
-    drawTexturedQuad(
-        -ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        wallTextureID, wallRepeat
-    );
-
-    // Draw right wall
-    drawTexturedQuad(
-        ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        wallTextureID, wallRepeat
-    );
+    // Frame each door opening with the door texture
+    for (const RoomDoor& door : doors) {
+        drawDoorTrim(door);
+    }
 
-    // Draw front wall (complete wall without door opening)
-    drawTexturedQuad(
-        -ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        wallTextureID, wallRepeat
-    );
+    // Free-standing partitions
+    for (size_t i = 0; i < partitions.size(); i++) {
+        drawPartition(static_cast<int>(i));
+    }
 
+    // Room extents in world space
+    float minX = position[0] - ROOM_WIDTH / 2, maxX = position[0] + ROOM_WIDTH / 2;
+    float minY = position[1] - ROOM_HEIGHT / 2, maxY = position[1] + ROOM_HEIGHT / 2;
+    float minZ = position[2] - ROOM_DEPTH / 2, maxZ = position[2] + ROOM_DEPTH / 2;
 
     // Draw floor
     drawTexturedQuad(
-        -ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, -ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
+        minX, minY, minZ,
+        minX, minY, maxZ,
+        maxX, minY, maxZ,
+        maxX, minY, minZ,
         floorTextureID, floorRepeat
     );
 
     // Draw ceiling/roof
     drawTexturedQuad(
-        -ROOM_WIDTH / 2, ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, ROOM_HEIGHT / 2, -ROOM_DEPTH / 2,
-        ROOM_WIDTH / 2, ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
-        -ROOM_WIDTH / 2, ROOM_HEIGHT / 2, ROOM_DEPTH / 2,
+        minX, maxY, minZ,
+        maxX, maxY, minZ,
+        maxX, maxY, maxZ,
+        minX, maxY, maxZ,
         roofTextureID, ceilingRepeat
     );
 
@@ -137,6 +133,253 @@ const float* Room::getDimensions() const {
     return dimensions;
 }
 
+void Room::setPosition(float x, float y, float z) {
+    position[0] = x;
+    position[1] = y;
+    position[2] = z;
+}
+
+int Room::addDoor(RoomWall wall, float offset, float width, float height) {
+    // Keep the opening inside the wall
+    float halfLength = getWallLength(wall) / 2;
+    if (width > 2 * halfLength) width = 2 * halfLength;
+    if (height > ROOM_HEIGHT) height = ROOM_HEIGHT;
+    if (offset - width / 2 < -halfLength) offset = -halfLength + width / 2;
+    if (offset + width / 2 > halfLength) offset = halfLength - width / 2;
+
+    doors.push_back(RoomDoor{ wall, offset, width, height });
+    return static_cast<int>(doors.size()) - 1;
+}
+
+void Room::getDoorCorners(int doorIndex, float corners[12]) const {
+    const RoomDoor& door = doors[doorIndex];
+    float t0 = door.offset - door.width / 2;
+    float t1 = door.offset + door.width / 2;
+    float y0 = -ROOM_HEIGHT / 2;
+    float y1 = -ROOM_HEIGHT / 2 + door.height;
+
+    getWallPoint(door.wall, t0, y0, 0.0f, corners);
+    getWallPoint(door.wall, t1, y0, 0.0f, corners + 3);
+    getWallPoint(door.wall, t1, y1, 0.0f, corners + 6);
+    getWallPoint(door.wall, t0, y1, 0.0f, corners + 9);
+}
+
+bool Room::contains(float x, float y, float z, float margin) const {
+    return std::fabs(x - position[0]) <= ROOM_WIDTH / 2 - margin &&
+        std::fabs(y - position[1]) <= ROOM_HEIGHT / 2 - margin &&
+        std::fabs(z - position[2]) <= ROOM_DEPTH / 2 - margin;
+}
+
+void Room::getWallPoint(RoomWall wall, float t, float y, float inset, float out[3]) const {
+    switch (wall) {
+    case WALL_BACK:
+        out[0] = t;
+        out[2] = -ROOM_DEPTH / 2 + inset;
+        break;
+    case WALL_FRONT:
+        out[0] = t;
+        out[2] = ROOM_DEPTH / 2 - inset;
+        break;
+    case WALL_LEFT:
+        out[0] = -ROOM_WIDTH / 2 + inset;
+        out[2] = t;
+        break;
+    case WALL_RIGHT:
+        out[0] = ROOM_WIDTH / 2 - inset;
+        out[2] = t;
+        break;
+    }
+    out[1] = y;
+
+    out[0] += position[0];
+    out[1] += position[1];
+    out[2] += position[2];
+}
+
+float Room::getWallLength(RoomWall wall) const {
+    return (wall == WALL_BACK || wall == WALL_FRONT) ? ROOM_WIDTH : ROOM_DEPTH;
+}
+
+void Room::getWallSections(RoomWall wall, std::vector<WallSection>& sections) const {
+    float halfLength = getWallLength(wall) / 2;
+    float bottom = -ROOM_HEIGHT / 2;
+    float top = ROOM_HEIGHT / 2;
+
+    // Doors on this wall, ordered along it
+    std::vector<const RoomDoor*> wallDoors;
+    for (const RoomDoor& door : doors) {
+        if (door.wall == wall) {
+            wallDoors.push_back(&door);
+        }
+    }
+    std::sort(wallDoors.begin(), wallDoors.end(),
+        [](const RoomDoor* a, const RoomDoor* b) { return a->offset < b->offset; });
+
+    // Complete wall when there is no door opening
+    float cursor = -halfLength;
+    for (const RoomDoor* door : wallDoors) {
+        float doorStart = door->offset - door->width / 2;
+        float doorEnd = door->offset + door->width / 2;
+
+        // Solid section up to the door, then the lintel above it
+        if (doorStart > cursor) {
+            sections.push_back(WallSection{ cursor, doorStart, bottom, top });
+        }
+        if (bottom + door->height < top) {
+            sections.push_back(WallSection{ doorStart, doorEnd, bottom + door->height, top });
+        }
+        cursor = doorEnd;
+    }
+    if (cursor < halfLength) {
+        sections.push_back(WallSection{ cursor, halfLength, bottom, top });
+    }
+}
+
+void Room::drawWall(RoomWall wall, GLuint textureID, float textureRepeat) {
+    std::vector<WallSection> sections;
+    getWallSections(wall, sections);
+    for (const WallSection& section : sections) {
+        drawWallSection(wall, section.t0, section.t1, section.y0, section.y1, 0.0f, textureID, textureRepeat);
+    }
+}
+
+void Room::drawWallSection(RoomWall wall, float t0, float t1, float y0, float y1, float inset,
+    GLuint textureID, float textureRepeat) {
+    float length = getWallLength(wall);
+    float p[4][3];
+    getWallPoint(wall, t0, y0, inset, p[0]);
+    getWallPoint(wall, t1, y0, inset, p[1]);
+    getWallPoint(wall, t1, y1, inset, p[2]);
+    getWallPoint(wall, t0, y1, inset, p[3]);
+
+    // Texture coordinates are taken from the full wall so sections line up
+    float u0 = (t0 / length + 0.5f) * textureRepeat;
+    float u1 = (t1 / length + 0.5f) * textureRepeat;
+    float v0 = (y0 / ROOM_HEIGHT + 0.5f) * textureRepeat;
+    float v1 = (y1 / ROOM_HEIGHT + 0.5f) * textureRepeat;
+
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glBegin(GL_QUADS);
+    glTexCoord2f(u0, v0); glVertex3fv(p[0]);
+    glTexCoord2f(u1, v0); glVertex3fv(p[1]);
+    glTexCoord2f(u1, v1); glVertex3fv(p[2]);
+    glTexCoord2f(u0, v1); glVertex3fv(p[3]);
+    glEnd();
+}
+
+void Room::drawDoorTrim(const RoomDoor& door) {
+    float t0 = door.offset - door.width / 2;
+    float t1 = door.offset + door.width / 2;
+    float bottom = -ROOM_HEIGHT / 2;
+    float top = bottom + door.height;
+    float inset = 0.01f; // Just in front of the wall to avoid z-fighting
+
+    // Left jamb, right jamb and header
+    drawWallSection(door.wall, t0 - DOOR_TRIM_WIDTH, t0, bottom, top, inset, doorTextureID, 1.0f);
+    drawWallSection(door.wall, t1, t1 + DOOR_TRIM_WIDTH, bottom, top, inset, doorTextureID, 1.0f);
+    drawWallSection(door.wall, t0 - DOOR_TRIM_WIDTH, t1 + DOOR_TRIM_WIDTH, top, top + DOOR_TRIM_WIDTH, inset,
+        doorTextureID, 1.0f);
+}
+
+int Room::addPartition(float x, float z, float length, float height, float thickness, bool alongX) {
+    if (height > ROOM_HEIGHT) height = ROOM_HEIGHT;
+    partitions.push_back(RoomPartition{ x, z, length, height, thickness, alongX });
+    return static_cast<int>(partitions.size()) - 1;
+}
+
+void Room::getPartitionBounds(int partitionIndex, float minCorner[3], float maxCorner[3]) const {
+    const RoomPartition& partition = partitions[partitionIndex];
+    float halfX = (partition.alongX ? partition.length : partition.thickness) / 2;
+    float halfZ = (partition.alongX ? partition.thickness : partition.length) / 2;
+
+    minCorner[0] = position[0] + partition.x - halfX;
+    minCorner[1] = position[1] - ROOM_HEIGHT / 2;
+    minCorner[2] = position[2] + partition.z - halfZ;
+    maxCorner[0] = position[0] + partition.x + halfX;
+    maxCorner[1] = minCorner[1] + partition.height;
+    maxCorner[2] = position[2] + partition.z + halfZ;
+}
+
+void Room::pushOutOfPartitions(float pos[3], float radius) const {
+    for (size_t i = 0; i < partitions.size(); i++) {
+        float minCorner[3], maxCorner[3];
+        getPartitionBounds(static_cast<int>(i), minCorner, maxCorner);
+
+        // Overlap on each side of the inflated box
+        float left = pos[0] - (minCorner[0] - radius);
+        float right = (maxCorner[0] + radius) - pos[0];
+        float back = pos[2] - (minCorner[2] - radius);
+        float front = (maxCorner[2] + radius) - pos[2];
+        if (left <= 0.0f || right <= 0.0f || back <= 0.0f || front <= 0.0f) {
+            continue;
+        }
+
+        // Leave through the closest side
+        float smallest = std::min(std::min(left, right), std::min(back, front));
+        if (smallest == left) pos[0] -= left;
+        else if (smallest == right) pos[0] += right;
+        else if (smallest == back) pos[2] -= back;
+        else pos[2] += front;
+    }
+}
+
+void Room::getOccluderQuads(std::vector<float>& quads) const {
+    // Solid parts of the walls (door openings stay open)
+    const RoomWall walls[] = { WALL_BACK, WALL_FRONT, WALL_LEFT, WALL_RIGHT };
+    std::vector<WallSection> sections;
+    for (RoomWall wall : walls) {
+        sections.clear();
+        getWallSections(wall, sections);
+        for (const WallSection& section : sections) {
+            float quad[12];
+            getWallPoint(wall, section.t0, section.y0, 0.0f, quad);
+            getWallPoint(wall, section.t1, section.y0, 0.0f, quad + 3);
+            getWallPoint(wall, section.t1, section.y1, 0.0f, quad + 6);
+            getWallPoint(wall, section.t0, section.y1, 0.0f, quad + 9);
+            quads.insert(quads.end(), quad, quad + 12);
+        }
+    }
+
+    // The two broad faces of each partition
+    for (size_t i = 0; i < partitions.size(); i++) {
+        float minCorner[3], maxCorner[3];
+        getPartitionBounds(static_cast<int>(i), minCorner, maxCorner);
+
+        for (int side = 0; side < 2; side++) {
+            float quad[12];
+            if (partitions[i].alongX) {
+                float z = side ? maxCorner[2] : minCorner[2];
+                float face[12] = {
+                    minCorner[0], minCorner[1], z,  maxCorner[0], minCorner[1], z,
+                    maxCorner[0], maxCorner[1], z,  minCorner[0], maxCorner[1], z
+                };
+                std::copy(face, face + 12, quad);
+            }
+            else {
+                float x = side ? maxCorner[0] : minCorner[0];
+                float face[12] = {
+                    x, minCorner[1], minCorner[2],  x, minCorner[1], maxCorner[2],
+                    x, maxCorner[1], maxCorner[2],  x, maxCorner[1], minCorner[2]
+                };
+                std::copy(face, face + 12, quad);
+            }
+            quads.insert(quads.end(), quad, quad + 12);
+        }
+    }
+}
+
+void Room::drawPartition(int partitionIndex) {
+    float lo[3], hi[3];
+    getPartitionBounds(partitionIndex, lo, hi);
+
+    // Closed box: four sides and the top (it stands on the floor)
+    drawTexturedQuad(lo[0], lo[1], lo[2], hi[0], lo[1], lo[2], hi[0], hi[1], lo[2], lo[0], hi[1], lo[2], wallTextureID);
+    drawTexturedQuad(hi[0], lo[1], hi[2], lo[0], lo[1], hi[2], lo[0], hi[1], hi[2], hi[0], hi[1], hi[2], wallTextureID);
+    drawTexturedQuad(lo[0], lo[1], hi[2], lo[0], lo[1], lo[2], lo[0], hi[1], lo[2], lo[0], hi[1], hi[2], wallTextureID);
+    drawTexturedQuad(hi[0], lo[1], lo[2], hi[0], lo[1], hi[2], hi[0], hi[1], hi[2], hi[0], hi[1], lo[2], wallTextureID);
+    drawTexturedQuad(lo[0], hi[1], lo[2], hi[0], hi[1], lo[2], hi[0], hi[1], hi[2], lo[0], hi[1], hi[2], doorTextureID);
+}
+
 void Room::setWallTexture(const std::string& texturePath) {
     // TODO: Load and apply wall texture
 
@@ -260,6 +503,9 @@ void Room::setRoofTexture(const std::string& texturePath) {
 
 
 GLuint Room::loadTexture(const std::string& filename) {
+    TRACE_SCOPE_DETAIL("Texture load", filename);
+    HitchMonitor::getInstance().noteEvent("asset", "Loading texture " + filename);
+
     // Open the BMP file
     std::ifstream file(filename.c_str(), std::ios::binary);
     if (!file) {
@@ -6,6 +6,37 @@
 #include <string>
 #include <vector>
 
+// Walls of a room, named as in Room::render
+enum RoomWall {
+    WALL_BACK,   // -Z
+    WALL_FRONT,  // +Z
+    WALL_LEFT,   // -X
+    WALL_RIGHT   // +X
+};
+
+// Door opening cut into a wall, standing on the floor
+struct RoomDoor {
+    RoomWall wall;
+    float offset;   // Door center along the wall, relative to the room center
+    float width;
+    float height;
+};
+
+// Free-standing partition panel inside a room, standing on the floor
+struct RoomPartition {
+    float x, z;       // Panel center relative to the room center
+    float length;
+    float height;
+    float thickness;
+    bool alongX;      // Panel runs along the X axis (otherwise along Z)
+};
+
+// Rectangular piece of a wall, in wall coordinates (t along the wall, y from room center)
+struct WallSection {
+    float t0, t1;
+    float y0, y1;
+};
+
 class Room {
 public:
     Room(float width, float height, float depth);
@@ -14,6 +45,34 @@ public:
     void render();
     const float* getDimensions() const;
     
+    // Placement in the world (room center)
+    void setPosition(float x, float y, float z);
+    const float* getPosition() const { return position; }
+    
+    // Door openings
+    int addDoor(RoomWall wall, float offset, float width, float height);
+    const std::vector<RoomDoor>& getDoors() const { return doors; }
+    void getDoorCorners(int doorIndex, float corners[12]) const;
+    
+    // Partition panels
+    int addPartition(float x, float z, float length, float height, float thickness, bool alongX);
+    const std::vector<RoomPartition>& getPartitions() const { return partitions; }
+    void getPartitionBounds(int partitionIndex, float minCorner[3], float maxCorner[3]) const;
+    
+    // Push a point of the given radius out of any partition it overlaps (XZ plane)
+    void pushOutOfPartitions(float pos[3], float radius) const;
+    
+    // Append world-space occluder quads (12 floats each): solid wall sections and partition faces
+    void getOccluderQuads(std::vector<float>& quads) const;
+    
+    // Containment test in world space, shrunk by margin on every side
+    bool contains(float x, float y, float z, float margin = 0.0f) const;
+    
+    // World-space point on a wall: t along the wall, y height from room center,
+    // inset pushes the point into the room
+    void getWallPoint(RoomWall wall, float t, float y, float inset, float out[3]) const;
+    float getWallLength(RoomWall wall) const;
+    
     // Room customization
     void setWallTexture(const std::string& texturePath);
 
@@ -26,6 +85,13 @@ private:
     float ROOM_WIDTH;
     float ROOM_HEIGHT;
     float ROOM_DEPTH;
+    float position[3];
+
+    // Door openings cut into the walls
+    std::vector<RoomDoor> doors;
+
+    // Free-standing panels
+    std::vector<RoomPartition> partitions;
 
     // Texture IDs
     GLuint wallTextureID;
@@ -45,6 +111,12 @@ private:
         float x3, float y3, float z3,
         float x4, float y4, float z4,
         GLuint textureID, float textureRepeat = 1.0f);
+    void getWallSections(RoomWall wall, std::vector<WallSection>& sections) const;
+    void drawWall(RoomWall wall, GLuint textureID, float textureRepeat);
+    void drawWallSection(RoomWall wall, float t0, float t1, float y0, float y1, float inset,
+        GLuint textureID, float textureRepeat);
+    void drawDoorTrim(const RoomDoor& door);
+    void drawPartition(int partitionIndex);
 };
 
 #endif // ROOM_H
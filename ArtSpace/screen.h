@@ -26,7 +26,6 @@ public:
         // Add a welcome message
         TextBox* welcomeText = new TextBox("Welcome to Artspace", "");
         welcomeText->setEditable(false);
-        welcomeText->setPosition(windowWidth / 2 - 150, windowHeight / 2 + 50); // Centered-ish
         welcomeText->setSize(300, 50);
         welcomeText->setTextColor(0.9f, 0.9f, 0.9f); // Light text
         welcomeText->setBackgroundColor(0.1f, 0.1f, 0.1f, 0.0f); // Transparent background
@@ -34,7 +33,6 @@ public:
 
         // Add a Start button
         Button* startButton = new Button("Start");
-        startButton->setPosition(windowWidth / 2 - 75, windowHeight / 2 - 25); // Below welcome
         startButton->setSize(150, 50);
         startButton->setOnClick([nav]() {
             if (nav) {
@@ -45,7 +43,6 @@ public:
 
         // Add an Exit button
         Button* exitButton = new Button("Exit");
-        exitButton->setPosition(windowWidth / 2 - 75, windowHeight / 2 - 100); // Below start
         exitButton->setSize(150, 50);
         exitButton->setBackgroundColor(0.7f, 0.3f, 0.3f); // Reddish color
         exitButton->setOnClick([]() {
@@ -54,27 +51,21 @@ public:
             exit(0); // Standard C exit function - works everywhere
         });
         addComponent(exitButton);
+
+        // Welcome text with the buttons below it, centered in the window
+        UILayout::NodeId menu = layout.addContainer(UILayout::ROOT, UILayout::Direction::Column);
+        layout.setSpacing(menu, 25.0f);
+        layout.addWidget(menu, welcomeText);
+        layout.addWidget(menu, startButton);
+        layout.addWidget(menu, exitButton);
+        layout.setBounds(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
     }
 
     void resizeScreen(int width, int height) override {
         // Update window dimensions
         windowWidth = width;
         windowHeight = height;
-
-        // Recalculate positions of components if they exist
-        if (getComponents().size() >= 3) { // Ensure all components are added
-            // Welcome Text
-            getComponents()[0]->setPosition(width / 2 - 150, height / 2 + 50);
-            getComponents()[0]->setSize(300, 50);
-
-            // Start Button
-            getComponents()[1]->setPosition(width / 2 - 75, height / 2 - 25);
-            getComponents()[1]->setSize(150, 50);
-
-            // Exit Button
-            getComponents()[2]->setPosition(width / 2 - 75, height / 2 - 100);
-            getComponents()[2]->setSize(150, 50);
-        }
+        ScreenManager::resizeScreen(width, height);
     }
 };
 
@@ -99,11 +90,16 @@ public:
     void setupScreen(Navigator* nav) {
         // Create a timer for the game
         
-        gameTimer->setPosition(10, windowHeight - 40);
         gameTimer->setSize(150, 30);
         gameTimer->setTextColor(0.8f, 0.8f, 0.8f, 1.0f);
         addComponent(gameTimer);
 
+        // Top left corner
+        layout.setPadding(UILayout::ROOT, 10.0f);
+        UILayout::NodeId timerNode = layout.addWidget(UILayout::ROOT, gameTimer);
+        layout.setAlign(timerNode, UILayout::Align::Start, UILayout::Align::End);
+        layout.setBounds(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
+
         // Initialize room and camera (will be done in showScreen)
         initialized = false;
     }
@@ -127,7 +123,7 @@ public:
             camera->setPosition(0.0f, 0.0f, 3.0f);
 
             // Center the mouse cursor
-            glutWarpPointer(windowWidth / 2, windowHeight / 2);
+            InputSystem::getInstance()->centerPointer();
             
             // Start the timer
             if (gameTimer) {
@@ -194,12 +190,6 @@ public:
         }
     }
 
-    void resizeScreen(int width, int height) override {
-        // Update the timer position
-        if (gameTimer) {
-            gameTimer->setPosition(10, height - 40);
-        }
-    }
 };
 
 // EndScreenManager class
@@ -211,7 +201,6 @@ public:
         // Create a title
         TextBox* title = new TextBox("GAME OVER", "");
         title->setEditable(false);
-        title->setPosition(windowWidth / 2 - 100, windowHeight - 100);
         title->setSize(200, 40);
         title->setTextColor(1.0f, 0.3f, 0.3f);
         title->setBackgroundColor(0.2f, 0.2f, 0.2f);
@@ -220,7 +209,6 @@ public:
         // Create a score display
         TextBox* scoreBox = new TextBox("Final Score: 150", "");
         scoreBox->setEditable(false);
-        scoreBox->setPosition(windowWidth / 2 - 100, windowHeight / 2 + 20);
         scoreBox->setSize(200, 40);
         scoreBox->setTextColor(1.0f, 1.0f, 1.0f);
         scoreBox->setBackgroundColor(0.2f, 0.2f, 0.2f);
@@ -228,7 +216,6 @@ public:
 
         // Create a play again button
         Button* playAgainButton = new Button("Play Again");
-        playAgainButton->setPosition(windowWidth / 2 - 75, windowHeight / 2 - 50);
         playAgainButton->setSize(150, 50);
         playAgainButton->setOnClick([nav]() {
             nav->navigateTo(Screen::Level1Screen);
@@ -237,28 +224,23 @@ public:
 
         // Create a main menu button
         Button* menuButton = new Button("Main Menu");
-        menuButton->setPosition(windowWidth / 2 - 75, windowHeight / 2 - 120);
         menuButton->setSize(150, 50);
         menuButton->setBackgroundColor(0.5f, 0.5f, 0.7f);
         menuButton->setOnClick([nav]() {
             nav->navigateTo(Screen::StartScreen);
             });
         addComponent(menuButton);
-    }
-
-    void resizeScreen(int width, int height) override {
-        if (!getComponents().empty()) {
-            // Update title position
-            getComponents()[0]->setPosition(width / 2 - 100, height - 100);
-
-            // Update score box position
-            getComponents()[1]->setPosition(width / 2 - 100, height / 2 + 20);
 
-            // Update play again button position
-            getComponents()[2]->setPosition(width / 2 - 75, height / 2 - 50);
-
-            // Update menu button position
-            getComponents()[3]->setPosition(width / 2 - 75, height / 2 - 120);
-        }
+        // Title at the top, score and buttons centered below it
+        layout.setPadding(UILayout::ROOT, 60.0f);
+        UILayout::NodeId titleNode = layout.addWidget(UILayout::ROOT, title);
+        layout.setAlign(titleNode, UILayout::Align::Center, UILayout::Align::End);
+
+        UILayout::NodeId results = layout.addContainer(UILayout::ROOT, UILayout::Direction::Column);
+        layout.setSpacing(results, 20.0f);
+        layout.addWidget(results, scoreBox);
+        layout.addWidget(results, playAgainButton);
+        layout.addWidget(results, menuButton);
+        layout.setBounds(static_cast<float>(windowWidth), static_cast<float>(windowHeight));
     }
 };
\ No newline at end of file
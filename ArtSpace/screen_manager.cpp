@@ -1,4 +1,5 @@
 #include "screen_manager.h"
+#include "text_renderer.h"
 
 ScreenManager::~ScreenManager() {
     // Doesn't own components, just references them
@@ -7,6 +8,8 @@ ScreenManager::~ScreenManager() {
 void ScreenManager::addComponent(UIComponent* component) {
     if (component) {
         components.push_back(component);
+        batchValid = false;
+        hitGridValid = false;
     }
 }
 
@@ -14,6 +17,10 @@ void ScreenManager::removeComponent(UIComponent* component) {
     auto it = std::find(components.begin(), components.end(), component);
     if (it != components.end()) {
         components.erase(it);
+        batchValid = false;
+        hitGridValid = false;
+        if (hovered == component) hovered = nullptr;
+        if (captured == component) captured = nullptr;
     }
 }
 
@@ -42,50 +49,55 @@ void ScreenManager::updateScreen(float deltaTime) {
 }
 
 void ScreenManager::renderScreen() {
+    layout.update();
     for (auto* component : components) {
-        if (component && component->getVisible()) {
-            component->render();
+        if (component && component->isDirty()) {
+            batchValid = false;
         }
     }
-}
 
-bool ScreenManager::handleMouseEvent(int button, int state, int x, int y) {
-    bool handled = false;
-    
-    // Process in reverse order to give top-most components priority
-    for (auto it = components.rbegin(); it != components.rend(); ++it) {
-        UIComponent* component = *it;
-        
-        if (!component->getVisible()) continue;
-        
-        // Check if component can handle mouse events
-        Button* buttonComponent = dynamic_cast<Button*>(component);
-        if (buttonComponent) {
-            if (buttonComponent->handleMouseEvent(button, state, x, y)) {
-                handled = true;
-                break; // Stop after first component handles it
+    if (!batchValid) {
+        batch.clear();
+        for (auto* component : components) {
+            if (component && component->getVisible()) {
+                component->appendGeometry(batch);
             }
-        }
-        
-        TextBox* textboxComponent = dynamic_cast<TextBox*>(component);
-        if (textboxComponent) {
-            if (textboxComponent->handleMouseEvent(button, state, x, y)) {
-                handled = true;
-                break; // Stop after first component handles it
+            if (component) {
+                component->clearDirty();
             }
         }
-        
-        // Check for BorderBox components
-        BorderBox* borderboxComponent = dynamic_cast<BorderBox*>(component);
-        if (borderboxComponent) {
-            if (borderboxComponent->handleMouseEvent(button, state, x, y)) {
-                handled = true;
-                break; // Stop after first component handles it
-            }
+        batchValid = true;
+    }
+    batch.draw();
+
+    // Text queued by components that draw themselves
+    TextRenderer::getInstance().flush();
+}
+
+// Topmost component under the pointer first; the one holding the last press
+// also gets the event, so buttons and text boxes notice clicks elsewhere
+bool ScreenManager::handleMouseEvent(int button, int state, int x, int y) {
+    float screenX = static_cast<float>(x);
+    float screenY = static_cast<float>(glutGet(GLUT_WINDOW_HEIGHT) - y);
+    updateHitGrid();
+    hitGrid.query(screenX, screenY, hits);
+    
+    UIComponent* target = nullptr;
+    for (UIComponent* component : hits) {
+        if (component->handleMouseEvent(button, state, screenX, screenY)) {
+            target = component;
+            break;
         }
     }
     
-    return handled;
+    if (captured && captured != target) {
+        captured->handleMouseEvent(button, state, screenX, screenY);
+    }
+    if (state == GLUT_DOWN) {
+        captured = target;
+    }
+    
+    return target != nullptr;
 }
 
 bool ScreenManager::handleKeyEvent(unsigned char key) {
@@ -103,29 +115,43 @@ bool ScreenManager::handleKeyEvent(unsigned char key) {
     return handled;
 }
 
+// Only the topmost component under the pointer is hovered
 bool ScreenManager::handleMouseMove(int x, int y) {
-    bool handled = false;
+    float screenX = static_cast<float>(x);
+    float screenY = static_cast<float>(glutGet(GLUT_WINDOW_HEIGHT) - y);
+    updateHitGrid();
+    hitGrid.query(screenX, screenY, hits);
     
-    for (auto* component : components) {
-        if (!component->getVisible()) continue;
-        
-        Button* buttonComponent = dynamic_cast<Button*>(component);
-        if (buttonComponent) {
-            if (buttonComponent->handleMouseMove(x, y)) {
-                handled = true;
-                // Don't break here, as mouse move should update all components
-            }
-        }
-        
-        // Try BorderBox components
-        BorderBox* borderboxComponent = dynamic_cast<BorderBox*>(component);
-        if (borderboxComponent) {
-            if (borderboxComponent->handleMouseMove(x, y)) {
-                handled = true;
-                // Don't break, should update all components
-            }
+    UIComponent* target = nullptr;
+    for (UIComponent* component : hits) {
+        if (component->handleMouseMove(screenX, screenY)) {
+            target = component;
+            break;
         }
     }
     
-    return handled;
-} 
\ No newline at end of file
+    if (hovered && hovered != target) {
+        hovered->handleMouseLeave();
+    }
+    hovered = target;
+    
+    return target != nullptr;
+}
+
+void ScreenManager::updateHitGrid() {
+    layout.update();
+    if (hitGridValid && hitGridLayoutVersion == UIComponent::getLayoutVersion()) return;
+    
+    hitGrid.rebuild(components);
+    hitGridValid = true;
+    hitGridLayoutVersion = UIComponent::getLayoutVersion();
+    
+    // Hidden components drop out of the routing
+    if (hovered && !hovered->getVisible()) {
+        hovered->handleMouseLeave();
+        hovered = nullptr;
+    }
+    if (captured && !captured->getVisible()) {
+        captured = nullptr;
+    }
+}
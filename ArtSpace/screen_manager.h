@@ -2,6 +2,9 @@
 #include <vector>
 #include <algorithm>
 #include "utility.h"
+#include "ui_batch.h"
+#include "ui_hit_grid.h"
+#include "ui_layout.h"
 #include "screens.h"
 
 // Screen class to manage a collection of components for a specific screen
@@ -9,9 +12,29 @@ class ScreenManager {
 private:
     std::vector<UIComponent*> components;
     Screen screenType;
+    // Geometry of all visible components, rebuilt when one of them changes
+    UIBatch batch;
+    bool batchValid;
+    
+    // Mouse routing: the grid finds the components under the pointer without
+    // testing all of them, and is rebuilt when the layout changes
+    UIHitGrid hitGrid;
+    bool hitGridValid;
+    uint32_t hitGridLayoutVersion;
+    std::vector<UIComponent*> hits;
+    UIComponent* hovered;       // Last component that took a mouse move
+    UIComponent* captured;      // Took the last press; hears about the release wherever it happens
+    
+    void updateHitGrid();
+    
+protected:
+    // Places the components; screens build it in setupScreen()
+    UILayout layout;
     
 public:
-    ScreenManager(Screen type) : screenType(type) {}
+    ScreenManager(Screen type)
+        : screenType(type), batchValid(false), hitGridValid(false), hitGridLayoutVersion(0),
+          hovered(nullptr), captured(nullptr) {}
     virtual ~ScreenManager();
     
     Screen getType() const { return screenType; }
@@ -23,12 +46,14 @@ public:
     void updateScreen(float deltaTime);
     void renderScreen();
     
+    // Mouse coordinates as GLUT reports them (origin at the top left)
     bool handleMouseEvent(int button, int state, int x, int y);
     bool handleKeyEvent(unsigned char key);
     bool handleMouseMove(int x, int y);
     
+    // The layout places the components again at the next render or mouse event
     virtual void resizeScreen(int width, int height) {
-        // Derived classes should override this to reposition components
+        layout.setBounds(static_cast<float>(width), static_cast<float>(height));
     }
     
     const std::vector<UIComponent*>& getComponents() const {
@@ -0,0 +1,155 @@
+/**
+ * @file slot_map.h
+ * @brief Generational slot map with stable handles and O(1) lookup
+ *
+ * A SlotMap stores values in a densely packed array for fast iteration while
+ * handing out SlotHandles that stay valid until the value they refer to is
+ * removed. Removal swaps the last element into the hole, so it is O(1) and
+ * never shifts other values; the slot's generation is bumped so any handle
+ * still pointing at the removed value is detected as stale instead of
+ * silently aliasing whatever reuses the slot.
+ *
+ * Usage:
+ *    SlotMap<Artwork*> artworks;
+ *    SlotHandle h = artworks.insert(painting);
+ *    if (Artwork** art = artworks.get(h)) { (*art)->render(); }
+ *    artworks.remove(h);   // h is now stale, get(h) returns nullptr
+ *
+ *    for (size_t i = 0; i < artworks.size(); i++) {
+ *        artworks.valueAt(i);  // dense iteration
+ *        artworks.handleAt(i); // handle of the i-th dense value
+ *    }
+ */
+
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Handle to a value stored in a SlotMap
+struct SlotHandle {
+    uint32_t index;       // Slot index
+    uint32_t generation;  // Generation the slot had when the handle was issued
+
+    SlotHandle() : index(INVALID_INDEX), generation(0) {}
+    SlotHandle(uint32_t idx, uint32_t gen) : index(idx), generation(gen) {}
+
+    bool isValid() const { return index != INVALID_INDEX; }
+
+    bool operator==(const SlotHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+
+    // Pack into a single integer (useful as a map key or for logging)
+    uint64_t toKey() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+
+    static const uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+};
+
+template <typename T>
+class SlotMap {
+private:
+    struct Slot {
+        uint32_t denseIndex;  // Position of the value in the dense array
+        uint32_t generation;  // Incremented every time the slot is freed
+    };
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+
+    // Dense storage, kept packed by swap-remove
+    std::vector<T> values;
+    std::vector<uint32_t> denseToSlot;
+
+public:
+    // Insert a value and return its handle
+    SlotHandle insert(const T& value) {
+        uint32_t slotIndex;
+        if (!freeSlots.empty()) {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slotIndex = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{ 0, 0 });
+        }
+
+        slots[slotIndex].denseIndex = static_cast<uint32_t>(values.size());
+        values.push_back(value);
+        denseToSlot.push_back(slotIndex);
+
+        return SlotHandle(slotIndex, slots[slotIndex].generation);
+    }
+
+    // Remove the value referred to by the handle (swap-remove). Returns false if stale.
+    bool remove(SlotHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        uint32_t denseIndex = slots[handle.index].denseIndex;
+        uint32_t lastIndex = static_cast<uint32_t>(values.size() - 1);
+
+        // Move the last value into the hole and fix up its slot
+        if (denseIndex != lastIndex) {
+            values[denseIndex] = values[lastIndex];
+            denseToSlot[denseIndex] = denseToSlot[lastIndex];
+            slots[denseToSlot[denseIndex]].denseIndex = denseIndex;
+        }
+        values.pop_back();
+        denseToSlot.pop_back();
+
+        // Invalidate outstanding handles and recycle the slot
+        slots[handle.index].generation++;
+        freeSlots.push_back(handle.index);
+        return true;
+    }
+
+    // Check whether a handle still refers to a live value
+    bool contains(SlotHandle handle) const {
+        return handle.index < slots.size() &&
+            slots[handle.index].generation == handle.generation &&
+            slots[handle.index].denseIndex < values.size() &&
+            denseToSlot[slots[handle.index].denseIndex] == handle.index;
+    }
+
+    // Lookup by handle, nullptr if stale
+    T* get(SlotHandle handle) {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+    const T* get(SlotHandle handle) const {
+        return contains(handle) ? &values[slots[handle.index].denseIndex] : nullptr;
+    }
+
+    // Dense index of a handle, -1 if stale
+    int indexOf(SlotHandle handle) const {
+        return contains(handle) ? static_cast<int>(slots[handle.index].denseIndex) : -1;
+    }
+
+    // Dense access
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    T& valueAt(size_t denseIndex) { return values[denseIndex]; }
+    const T& valueAt(size_t denseIndex) const { return values[denseIndex]; }
+    SlotHandle handleAt(size_t denseIndex) const {
+        uint32_t slotIndex = denseToSlot[denseIndex];
+        return SlotHandle(slotIndex, slots[slotIndex].generation);
+    }
+
+    // Iteration over the dense values
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+    // Remove everything; all outstanding handles become stale
+    void clear() {
+        for (size_t i = 0; i < denseToSlot.size(); i++) {
+            uint32_t slotIndex = denseToSlot[i];
+            slots[slotIndex].generation++;
+            freeSlots.push_back(slotIndex);
+        }
+        values.clear();
+        denseToSlot.clear();
+    }
+};
@@ -0,0 +1,149 @@
+// Benchmark for Logger: cost of a logging call on the caller's thread, against the old
+// synchronous logger (format, write and flush on every call), and of the deferred-format
+// LOG_INFO macro, which builds no string at the call site.
+// Build: g++ -O2 -std=c++17 -DARTSPACE_TRACING=0 -I.. bench_logger.cpp ../logger.cpp -o bench_logger -lpthread
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../logger.h"
+
+typedef std::chrono::high_resolution_clock Clock;
+
+static const char* LOG_PATH = "bench_logger.log";
+static const char* SYNC_PATH = "bench_logger_sync.log";
+
+// The previous Logger::log, kept here as the baseline
+static void logSynchronous(std::ofstream& file, const std::string& message) {
+    std::time_t now = std::time(nullptr);
+    struct tm timeInfo;
+#ifdef _WIN32
+    localtime_s(&timeInfo, &now);
+#else
+    localtime_r(&now, &timeInfo);
+#endif
+    std::stringstream logStream;
+    logStream << "["
+        << std::setfill('0') << std::setw(2) << timeInfo.tm_hour << ":"
+        << std::setfill('0') << std::setw(2) << timeInfo.tm_min << ":"
+        << std::setfill('0') << std::setw(2) << timeInfo.tm_sec << "] ";
+    logStream << "[INFO] " << message;
+    file << logStream.str() << std::endl;
+    file.flush();
+}
+
+struct CallStats {
+    double seconds;
+    std::vector<double> callNs;
+};
+
+static void printStats(const char* name, int threads, const CallStats& stats) {
+    std::vector<double> sorted = stats.callNs;
+    std::sort(sorted.begin(), sorted.end());
+    double p50 = sorted[sorted.size() / 2];
+    double p99 = sorted[sorted.size() * 99 / 100];
+    double worst = sorted.back();
+    printf("%-22s %7d %12.0f %10.0f %10.0f %12.0f\n", name, threads,
+        sorted.size() / stats.seconds, p50, p99, worst);
+}
+
+// Each thread logs `count` messages, timing every call
+template <typename LogCall>
+static CallStats run(int threads, int count, LogCall logCall) {
+    std::vector<std::vector<double>> perThread(threads);
+    Clock::time_point start = Clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::string message = "Loaded image: assets/paintings/starry_night_" + std::to_string(t) + ".jpg - 1024x768";
+            perThread[t].reserve(count);
+            for (int i = 0; i < count; i++) {
+                Clock::time_point callStart = Clock::now();
+                logCall(message);
+                perThread[t].push_back(std::chrono::duration<double, std::nano>(Clock::now() - callStart).count());
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    CallStats stats;
+    stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (const std::vector<double>& calls : perThread) {
+        stats.callNs.insert(stats.callNs.end(), calls.begin(), calls.end());
+    }
+    return stats;
+}
+
+int main() {
+    const int SYNC_MESSAGES = 20000;
+    const int BURST_MESSAGES = 1000;     // A busy frame's worth
+    const int BURSTS = 200;
+
+    printf("%-22s %7s %12s %10s %10s %12s\n", "logger", "threads", "msgs/s", "p50 ns", "p99 ns", "max ns");
+
+    // Baseline: formatted and flushed on the calling thread
+    {
+        std::ofstream file(SYNC_PATH, std::ios::out | std::ios::trunc);
+        CallStats stats = run(1, SYNC_MESSAGES, [&](const std::string& message) { logSynchronous(file, message); });
+        printStats("synchronous", 1, stats);
+    }
+
+    // Queued: bursts with a frame's gap between them, as from the render loop
+    Logger& logger = Logger::getInstance();
+    logger.enableFileLogging(true, LOG_PATH);
+    for (int threads : { 1, 4 }) {
+        uint64_t droppedBefore = logger.getDroppedCount();
+        CallStats total;
+        total.seconds = 0.0;
+        for (int burst = 0; burst < BURSTS; burst++) {
+            CallStats stats = run(threads, BURST_MESSAGES / threads, [&](const std::string& message) { logger.logInfo(message); });
+            total.seconds += stats.seconds;
+            total.callNs.insert(total.callNs.end(), stats.callNs.begin(), stats.callNs.end());
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        }
+        printStats(threads == 1 ? "queued (bursts)" : "queued (bursts, MPSC)", threads, total);
+        printf("  dropped: %llu\n", static_cast<unsigned long long>(logger.getDroppedCount() - droppedBefore));
+    }
+
+    // Deferred formatting: the path, width and height are packed as raw values
+    {
+        uint64_t droppedBefore = logger.getDroppedCount();
+        CallStats total;
+        total.seconds = 0.0;
+        for (int burst = 0; burst < BURSTS; burst++) {
+            CallStats stats = run(1, BURST_MESSAGES, [&](const std::string& message) {
+                LOG_INFO("Loaded image: {} - {}x{}", message, 1024, 768);
+            });
+            total.seconds += stats.seconds;
+            total.callNs.insert(total.callNs.end(), stats.callNs.begin(), stats.callNs.end());
+            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        }
+        printStats("LOG_INFO (bursts)", 1, total);
+        printf("  dropped: %llu\n", static_cast<unsigned long long>(logger.getDroppedCount() - droppedBefore));
+    }
+
+    // Flat out: shows the drop policy once the writer falls behind
+    {
+        uint64_t droppedBefore = logger.getDroppedCount();
+        CallStats stats = run(4, 250000, [&](const std::string& message) { logger.logInfo(message); });
+        printStats("queued (saturated)", 4, stats);
+        printf("  dropped: %llu of %zu\n", static_cast<unsigned long long>(logger.getDroppedCount() - droppedBefore),
+            stats.callNs.size());
+    }
+
+    Clock::time_point flushStart = Clock::now();
+    logger.shutdown();
+    printf("\nShutdown drain: %.2f ms\n", std::chrono::duration<double, std::milli>(Clock::now() - flushStart).count());
+
+    std::remove(LOG_PATH);
+    std::remove(SYNC_PATH);
+    return 0;
+}
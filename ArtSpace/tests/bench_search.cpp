@@ -0,0 +1,89 @@
+// Benchmark for ArtworkSearchIndex: build time and query latency over 100k synthetic artworks.
+// Build: g++ -O2 -std=c++17 -I.. bench_search.cpp ../artwork_search.cpp -o bench_search
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "../artwork_search.h"
+
+static const char* WORDS[] = {
+    "starry", "night", "water", "lilies", "harbor", "portrait", "self", "garden", "bridge", "storm",
+    "sunflowers", "cathedral", "mountain", "river", "winter", "summer", "morning", "evening", "dancer", "still",
+    "life", "vase", "fruit", "seascape", "village", "market", "horse", "rider", "mother", "child",
+    "transformers", "megatron", "starscream", "optimus", "decepticon", "autobot", "seeker", "nebula", "orbit", "machine"
+};
+static const char* FIRST_NAMES[] = { "Claude", "Vincent", "Frida", "Pablo", "Rembrandt", "Mary", "Georgia", "Katsushika", "Edvard", "Berthe" };
+static const char* LAST_NAMES[] = { "Monet", "Gogh", "Kahlo", "Picasso", "Rijn", "Cassatt", "Keeffe", "Hokusai", "Munch", "Morisot" };
+static const char* TAGS[] = { "oil", "watercolor", "impressionism", "cubism", "modern", "baroque", "landscape", "abstract", "sculpture", "print" };
+
+template <size_t N>
+static const char* pick(const char* (&list)[N], std::mt19937& rng) {
+    return list[rng() % N];
+}
+
+int main() {
+    typedef std::chrono::high_resolution_clock Clock;
+    const int DOCUMENTS = 100000;
+    const int QUERY_REPEATS = 2000;
+
+    std::mt19937 rng(42);
+    ArtworkSearchIndex index;
+    ArtworkSearchIndex::Metadata meta;
+    float position[3] = { 0.0f, 1.5f, 0.0f };
+    float facing[2] = { 0.0f, 1.0f };
+
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < DOCUMENTS; i++) {
+        meta.title = std::string(pick(WORDS, rng)) + " " + pick(WORDS, rng);
+        meta.artist = std::string(pick(FIRST_NAMES, rng)) + " " + pick(LAST_NAMES, rng);
+        meta.year = 1400 + static_cast<int>(rng() % 620);
+        meta.tags = { pick(TAGS, rng), pick(TAGS, rng) };
+        position[0] = static_cast<float>(i % 300);
+        position[2] = static_cast<float>(i / 300);
+        index.addDocument(meta, position, facing, i);
+    }
+    double addMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    index.build();
+    double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    printf("Documents: %zu\n", index.size());
+    printf("Add:   %8.2f ms\n", addMs);
+    printf("Build: %8.2f ms\n", buildMs);
+    printf("Index memory: %zu KB\n\n", index.memoryUsage() / 1024);
+
+    const char* queries[] = {
+        "s",               // one letter: exact terms only
+        "st",              // shortest prefix, worst case
+        "sta",             // prefix
+        "star",            // prefix
+        "starscream",      // exact
+        "starscrem",       // typo (trigram fallback)
+        "monet water",     // two fields
+        "gogh 1889",       // artist and year
+        "impressionism",   // tag
+        "zzzz"             // no match
+    };
+
+    std::vector<ArtworkSearchIndex::Result> results;
+    printf("%-16s %10s %10s %8s\n", "query", "avg us", "max us", "hits");
+    for (const char* query : queries) {
+        double total = 0.0;
+        double worst = 0.0;
+        for (int i = 0; i < QUERY_REPEATS; i++) {
+            Clock::time_point queryStart = Clock::now();
+            index.search(query, 10, results);
+            double us = std::chrono::duration<double, std::micro>(Clock::now() - queryStart).count();
+            total += us;
+            if (us > worst) worst = us;
+        }
+        printf("%-16s %10.2f %10.2f %8zu", query, total / QUERY_REPEATS, worst, results.size());
+        if (!results.empty()) {
+            printf("   top: %s", index.getTitle(results[0].doc));
+        }
+        printf("\n");
+    }
+    return 0;
+}
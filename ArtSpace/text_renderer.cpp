@@ -0,0 +1,324 @@
+#include "text_renderer.h"
+#include "utility.h"
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <algorithm>
+#include <cmath>
+
+TextRenderer TextRenderer::instance;
+
+// Tried in order when no font path is configured
+static const char* SYSTEM_FONTS[] = {
+    "assets/fonts/ui.ttf",
+    "C:/Windows/Fonts/segoeui.ttf",
+    "C:/Windows/Fonts/arial.ttf",
+    "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+    "/System/Library/Fonts/Helvetica.ttc",
+};
+
+// Rasterized up front for every size: printable ASCII and Latin-1
+static const unsigned char FIRST_PRELOADED = 32;
+
+// SFML rasterizes glyphs into textures of its own context, and can leave that
+// context current afterwards. Put the caller's (GLUT's) context back.
+class CurrentContextGuard {
+#ifdef _WIN32
+    HDC dc;
+    HGLRC context;
+
+public:
+    CurrentContextGuard() : dc(wglGetCurrentDC()), context(wglGetCurrentContext()) {}
+    ~CurrentContextGuard() {
+        if (context && wglGetCurrentContext() != context) {
+            wglMakeCurrent(dc, context);
+        }
+    }
+#endif
+};
+
+TextRenderer::TextRenderer()
+    : useCounter(0)
+    , drawCalls(0) {
+}
+
+TextRenderer::~TextRenderer() {
+    // Textures go with the GL context; release() deletes them while it still exists
+}
+
+TextRenderer& TextRenderer::getInstance() {
+    return instance;
+}
+
+bool TextRenderer::loadFont(const std::string& path) {
+    std::vector<std::string> candidates;
+    if (!path.empty()) {
+        candidates.push_back(path);
+    }
+    else {
+        candidates.assign(std::begin(SYSTEM_FONTS), std::end(SYSTEM_FONTS));
+    }
+
+    release();
+    CurrentContextGuard guard;
+    for (const std::string& candidate : candidates) {
+        std::unique_ptr<sf::Font> loaded(new sf::Font());
+        if (!loaded->openFromFile(candidate)) continue;
+
+        loaded->setSmooth(true);
+        font = std::move(loaded);
+        fontPath = candidate;
+        getPage(DEFAULT_SIZE);
+        LOG_INFO("Text font: {}", fontPath);
+        return true;
+    }
+
+    LOG_WARN("TextRenderer - no font found{}{}, using the GLUT bitmap font", path.empty() ? "" : " at ", path);
+    return false;
+}
+
+TextRenderer::FontPage& TextRenderer::getPage(unsigned int size) {
+    auto found = pages.find(size);
+    if (found != pages.end()) {
+        return found->second;
+    }
+
+    FontPage& page = pages[size];
+    page.size = size;
+    for (Glyph& glyph : page.glyphs) {
+        glyph.loaded = false;
+    }
+    page.texture = 0;
+    page.textureWidth = 0;
+    page.textureHeight = 0;
+    page.atlasChanged = true;
+
+    // One pass over the common characters, so the atlas rarely grows later
+    CurrentContextGuard guard;
+    for (int character = FIRST_PRELOADED; character < 256; character++) {
+        if (character == 127) character = 160;  // Skip DEL and the C1 controls
+        getGlyph(page, static_cast<unsigned char>(character));
+    }
+    page.capHeight = page.glyphs['H'].visible ? page.glyphs['H'].quad.top : size * 0.7f;
+    return page;
+}
+
+const TextRenderer::Glyph& TextRenderer::getGlyph(FontPage& page, unsigned char character) {
+    Glyph& glyph = page.glyphs[character];
+    if (glyph.loaded) {
+        return glyph;
+    }
+
+    CurrentContextGuard guard;
+    const sf::Glyph& source = font->getGlyph(character, page.size, false);
+    glyph.loaded = true;
+    glyph.advance = source.advance;
+    glyph.visible = source.textureRect.size.x > 0 && source.textureRect.size.y > 0;
+
+    // SFML's bounds are y down from the baseline; the screen space is y up
+    glyph.quad.left = source.bounds.position.x;
+    glyph.quad.right = source.bounds.position.x + source.bounds.size.x;
+    glyph.quad.top = -source.bounds.position.y;
+    glyph.quad.bottom = -(source.bounds.position.y + source.bounds.size.y);
+    glyph.quad.u0 = static_cast<float>(source.textureRect.position.x);
+    glyph.quad.v0 = static_cast<float>(source.textureRect.position.y + source.textureRect.size.y);
+    glyph.quad.u1 = static_cast<float>(source.textureRect.position.x + source.textureRect.size.x);
+    glyph.quad.v1 = static_cast<float>(source.textureRect.position.y);
+    page.atlasChanged = true;
+    return glyph;
+}
+
+const TextRenderer::TextLayout& TextRenderer::getLayout(FontPage& page, const std::string& text) {
+    useCounter++;
+    auto found = page.layouts.find(text);
+    if (found != page.layouts.end()) {
+        found->second.lastUse = useCounter;
+        return found->second;
+    }
+
+    if (page.layouts.size() >= MAX_CACHED_LAYOUTS) {
+        evictLayouts(page);
+    }
+
+    TextLayout& layout = page.layouts[text];
+    layout.lastUse = useCounter;
+    layout.caretOffsets.reserve(text.size() + 1);
+    float pen = 0.0f;
+    unsigned char previous = 0;
+    for (char c : text) {
+        unsigned char character = static_cast<unsigned char>(c);
+        if (previous) {
+            pen += font->getKerning(previous, character, page.size);
+        }
+        layout.caretOffsets.push_back(pen);
+
+        const Glyph& glyph = getGlyph(page, character);
+        if (glyph.visible) {
+            GlyphQuad quad = glyph.quad;
+            quad.left += pen;
+            quad.right += pen;
+            layout.quads.push_back(quad);
+        }
+        pen += glyph.advance;
+        previous = character;
+    }
+    layout.caretOffsets.push_back(pen);
+    layout.width = pen;
+    return layout;
+}
+
+// Drop the older half of the cache; labels drawn every frame stay
+void TextRenderer::evictLayouts(FontPage& page) {
+    uint64_t keepFrom = useCounter > MAX_CACHED_LAYOUTS / 2 ? useCounter - MAX_CACHED_LAYOUTS / 2 : 0;
+    for (auto it = page.layouts.begin(); it != page.layouts.end();) {
+        if (it->second.lastUse < keepFrom) {
+            it = page.layouts.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
+
+void TextRenderer::uploadAtlas(FontPage& page) {
+    sf::Image atlas;
+    {
+        CurrentContextGuard guard;
+        atlas = font->getTexture(page.size).copyToImage();
+    }
+    page.textureWidth = atlas.getSize().x;
+    page.textureHeight = atlas.getSize().y;
+
+    if (!page.texture) {
+        glGenTextures(1, &page.texture);
+    }
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, page.textureWidth, page.textureHeight, 0,
+        GL_RGBA, GL_UNSIGNED_BYTE, atlas.getPixelsPtr());
+    page.atlasChanged = false;
+}
+
+float TextRenderer::measure(const std::string& text, unsigned int size) {
+    if (!font) {
+        int width = 0;
+        for (char c : text) {
+            width += glutBitmapWidth(GLUT_BITMAP_HELVETICA_12, c);
+        }
+        return static_cast<float>(width);
+    }
+    return getLayout(getPage(size), text).width;
+}
+
+float TextRenderer::getCapHeight(unsigned int size) {
+    // The bitmap font was always centered as if 12 pixels tall
+    return font ? getPage(size).capHeight : 12.0f;
+}
+
+float TextRenderer::getCaretOffset(const std::string& text, size_t index, unsigned int size) {
+    index = std::min(index, text.size());
+    if (!font) {
+        int offset = 0;
+        for (size_t i = 0; i < index; i++) {
+            offset += glutBitmapWidth(GLUT_BITMAP_HELVETICA_12, text[i]);
+        }
+        return static_cast<float>(offset);
+    }
+    return getLayout(getPage(size), text).caretOffsets[index];
+}
+
+size_t TextRenderer::getCaretIndex(const std::string& text, float offset, unsigned int size) {
+    if (offset <= 0.0f) return 0;
+    // The caret goes before the character under the offset
+    for (size_t index = 0; index < text.size(); index++) {
+        if (getCaretOffset(text, index + 1, size) >= offset) {
+            return index;
+        }
+    }
+    return text.size();
+}
+
+void TextRenderer::draw(float x, float y, const std::string& text, const float* color, unsigned int size) {
+    append(queued, x, y, text, color, 1.0f, size);
+}
+
+void TextRenderer::append(UIBatch& batch, float x, float y, const std::string& text, const float* color,
+                          float alpha, unsigned int size) {
+    if (text.empty()) return;
+
+    float rgba[4] = { 1.0f, 1.0f, 1.0f, alpha };
+    if (color) {
+        rgba[0] = color[0];
+        rgba[1] = color[1];
+        rgba[2] = color[2];
+        rgba[3] = color[3] * alpha;
+    }
+
+    if (!font) {
+        batch.addCustom([x, y, text, rgba]() {
+            glPushAttrib(GL_CURRENT_BIT);
+            glColor4fv(rgba);
+            glRasterPos2f(x, y);
+            for (char c : text) {
+                glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, c);
+            }
+            glPopAttrib();
+        });
+        return;
+    }
+
+    FontPage& page = getPage(size);
+    const TextLayout& layout = getLayout(page, text);
+
+    GLubyte bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = static_cast<GLubyte>(std::min(std::max(rgba[i], 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+
+    // Whole pixels keep the glyphs sharp
+    x = std::floor(x + 0.5f);
+    y = std::floor(y + 0.5f);
+    std::vector<UIBatch::Vertex>& vertices = batch.getTextVertices(size);
+    for (const GlyphQuad& quad : layout.quads) {
+        vertices.push_back({ x + quad.left, y + quad.bottom, quad.u0, quad.v0, { bytes[0], bytes[1], bytes[2], bytes[3] } });
+        vertices.push_back({ x + quad.right, y + quad.bottom, quad.u1, quad.v0, { bytes[0], bytes[1], bytes[2], bytes[3] } });
+        vertices.push_back({ x + quad.right, y + quad.top, quad.u1, quad.v1, { bytes[0], bytes[1], bytes[2], bytes[3] } });
+        vertices.push_back({ x + quad.left, y + quad.top, quad.u0, quad.v1, { bytes[0], bytes[1], bytes[2], bytes[3] } });
+    }
+}
+
+bool TextRenderer::bindAtlas(unsigned int size, float& uScale, float& vScale) {
+    auto found = pages.find(size);
+    if (!font || found == pages.end()) return false;
+
+    // SFML grows an atlas without moving the glyphs already in it, so
+    // quads built before an upload stay valid with the new scale
+    FontPage& page = found->second;
+    if (page.atlasChanged || !page.texture) {
+        uploadAtlas(page);
+    }
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    uScale = 1.0f / page.textureWidth;
+    vScale = 1.0f / page.textureHeight;
+    return true;
+}
+
+void TextRenderer::flush() {
+    queued.draw();
+    drawCalls += queued.getDrawCalls();
+    queued.clear();
+}
+
+void TextRenderer::release() {
+    for (auto& entry : pages) {
+        if (entry.second.texture) {
+            glDeleteTextures(1, &entry.second.texture);
+        }
+    }
+    pages.clear();
+    queued.clear();
+    font.reset();
+    fontPath.clear();
+}
@@ -0,0 +1,137 @@
+/**
+ * @file text_renderer.h
+ * @brief TrueType text drawn from a glyph atlas in batched textured quads
+ *
+ * The font is rasterized once per pixel size into a glyph atlas (SFML does
+ * the rasterizing; the atlas is copied into a texture owned by this GL
+ * context). A string is laid out once into glyph quads, with its width and
+ * the x offset of every caret position; layouts are cached per size and
+ * string, so the labels that stay the same from frame to frame cost only a
+ * hash lookup.
+ *
+ * draw() only appends the quads to a queue (a UIBatch). flush() sends
+ * everything queued with one glDrawArrays per size, so it has to run in the
+ * same projection the text was queued in: endScreenSpace() and
+ * ScreenManager::renderScreen() flush. Text therefore lands on top of the
+ * shapes drawn in that pass. append() adds text to another batch instead,
+ * which may be kept and redrawn.
+ *
+ * Strings are drawn byte by byte as Latin-1. Without a font (none found, or
+ * loadFont() not called) everything falls back to GLUT's Helvetica 12 bitmap
+ * font, drawn immediately.
+ *
+ * Usage:
+ *    TextRenderer& text = TextRenderer::getInstance();
+ *    text.loadFont("");                    // Needs the GL context; "" tries the system fonts
+ *
+ *    beginScreenSpace(width, height);
+ *    text.draw(10.0f, 20.0f, "Loaded", white);
+ *    float width = text.measure("Loaded");
+ *    endScreenSpace();                     // Flushes the queued text
+ */
+
+#pragma once
+#include <GL/glut.h>
+#include <SFML/Graphics/Font.hpp>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ui_batch.h"
+
+class TextRenderer {
+public:
+    static constexpr unsigned int DEFAULT_SIZE = 12;
+    // Layouts kept per size before unused ones are evicted
+    static constexpr size_t MAX_CACHED_LAYOUTS = 512;
+
+private:
+    struct GlyphQuad {
+        float left, bottom, right, top;     // Pixels from the pen position, y up
+        float u0, v0, u1, v1;               // Atlas pixels
+    };
+
+    struct Glyph {
+        bool loaded;
+        float advance;
+        bool visible;
+        GlyphQuad quad;
+    };
+
+    struct TextLayout {
+        float width;
+        std::vector<GlyphQuad> quads;       // Positioned from the string's origin
+        std::vector<float> caretOffsets;    // x of each caret position, size() + 1 entries
+        uint64_t lastUse;
+    };
+
+    // Atlas and layouts of one pixel size
+    struct FontPage {
+        unsigned int size;
+        Glyph glyphs[256];
+        float capHeight;
+        GLuint texture;
+        unsigned int textureWidth;
+        unsigned int textureHeight;
+        bool atlasChanged;                  // New glyphs not in the texture yet
+        std::unordered_map<std::string, TextLayout> layouts;
+    };
+
+    static TextRenderer instance;
+
+    std::unique_ptr<sf::Font> font;
+    std::string fontPath;
+    std::map<unsigned int, FontPage> pages;
+    UIBatch queued;                         // draw() calls since the last flush()
+    uint64_t useCounter;
+    size_t drawCalls;
+
+    TextRenderer();
+
+    FontPage& getPage(unsigned int size);
+    const Glyph& getGlyph(FontPage& page, unsigned char character);
+    const TextLayout& getLayout(FontPage& page, const std::string& text);
+    void evictLayouts(FontPage& page);
+    void uploadAtlas(FontPage& page);
+
+public:
+    TextRenderer(const TextRenderer&) = delete;
+    TextRenderer& operator=(const TextRenderer&) = delete;
+    ~TextRenderer();
+
+    static TextRenderer& getInstance();
+
+    // Load a TrueType/OpenType font; "" tries a few system fonts. False keeps the bitmap font.
+    bool loadFont(const std::string& path);
+    bool hasFont() const { return font != nullptr; }
+    const std::string& getFontPath() const { return fontPath; }
+
+    // Width of the string in pixels
+    float measure(const std::string& text, unsigned int size = DEFAULT_SIZE);
+    // Height of a capital letter, for centering text vertically
+    float getCapHeight(unsigned int size = DEFAULT_SIZE);
+    // x offset of the caret before character index, and the caret index nearest an x offset
+    float getCaretOffset(const std::string& text, size_t index, unsigned int size = DEFAULT_SIZE);
+    size_t getCaretIndex(const std::string& text, float offset, unsigned int size = DEFAULT_SIZE);
+
+    // Queue a string with its baseline starting at (x, y); color is RGBA (null: white)
+    void draw(float x, float y, const std::string& text, const float* color = nullptr,
+              unsigned int size = DEFAULT_SIZE);
+    // Draw everything queued, one call per size
+    void flush();
+
+    // Add a string to a batch; alpha multiplies the color's alpha
+    void append(UIBatch& batch, float x, float y, const std::string& text, const float* color, float alpha,
+                unsigned int size = DEFAULT_SIZE);
+    // Bind the atlas of a size, uploading new glyphs; the scales turn atlas pixels into texture coordinates
+    bool bindAtlas(unsigned int size, float& uScale, float& vScale);
+
+    // Draw calls issued by flush() since the last reset
+    size_t getDrawCalls() const { return drawCalls; }
+    void resetDrawCalls() { drawCalls = 0; }
+
+    // Unload the font, its atlas textures and cached layouts (needs the GL context)
+    void release();
+};
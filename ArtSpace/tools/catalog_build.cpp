@@ -0,0 +1,129 @@
+// Writes a synthetic exhibition catalog (CatalogWriter) for exercising the pager with --catalog.
+// Pieces hang in rows along the walls of the default gallery (main hall and both wings), cycling
+// through the bundled pictures and frames, so every cell the visitor walks through has artworks.
+// Usage: catalog_build [out.cat] [piece count] [cell size]
+//   defaults: exhibition.cat, 600 pieces, 10 unit cells (about 8x3 cells over the gallery)
+// Run from the ArtSpace directory so the asset paths resolve, then: ArtSpace --catalog exhibition.cat
+// Build: g++ -O2 -std=c++17 -I.. catalog_build.cpp ../catalog.cpp ../artwork.cpp ../artwork_manager.cpp
+//        ../utility.cpp ../text_renderer.cpp ../ui_batch.cpp ../gl_extensions.cpp ../logger.cpp ../profiler.cpp
+//        ../trace.cpp ../hitch_monitor.cpp -o catalog_build -lsfml-graphics -lsfml-system -lglut -lGL -lpthread
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "../catalog.h"
+
+// A wall of one of the default gallery's rooms (see GameManager::initRoom)
+struct Wall {
+    float x0, z0, x1, z1;           // World-space ends, just off the wall surface
+    ArtworkPlacement placement;     // Faces into the room
+    float doorCenter;               // Along the wall, in world units; no pieces hang in the doorway
+};
+
+static const float WALL_INSET = 0.1f;
+static const float DOOR_CLEARANCE = 2.5f;
+static const float NO_DOOR = 1.0e9f;
+
+static const char* PICTURES[] = { "Megatron One (1).jpg", "Megatron Prime.jpg", "StarScream.jpg", "Mona_Lisa.bmp", "Stary_Night.bmp" };
+static const char* FRAMES[] = { "Luxury.png", "Legacy.png", "Precious.png" };
+static const char* ARTISTS[] = { "Claude Monet", "Frida Kahlo", "Katsushika Hokusai", "Georgia O'Keeffe", "Edvard Munch" };
+static const char* WORDS[] = { "harbor", "storm", "garden", "bridge", "river", "winter", "morning", "dancer", "orbit", "machine" };
+static const char* TAGS[] = { "oil", "watercolor", "modern", "landscape", "abstract", "print" };
+
+template <size_t N>
+static const char* pick(const char* (&items)[N], size_t index) {
+    return items[index % N];
+}
+
+// Inverse of Artwork::placementToWorld: the configured position that lands at (x, z)
+static void worldToPlacement(ArtworkPlacement placement, float x, float z, float& posX, float& posZ) {
+    float degrees = placement == EAST_WALL ? 90.0f : placement == SOUTH_WALL ? 180.0f :
+        placement == WEST_WALL ? 270.0f : 0.0f;
+    float radians = degrees * 3.14159265f / 180.0f;
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    posX = x * c - z * s;
+    posZ = x * s + z * c;
+}
+
+static void addRoomWalls(std::vector<Wall>& walls, float centerX, float centerZ, float width, float depth,
+                         float westDoor, float eastDoor) {
+    float minX = centerX - width / 2 + WALL_INSET, maxX = centerX + width / 2 - WALL_INSET;
+    float minZ = centerZ - depth / 2 + WALL_INSET, maxZ = centerZ + depth / 2 - WALL_INSET;
+    walls.push_back({ minX, minZ, maxX, minZ, NORTH_WALL, NO_DOOR });     // Back wall, facing +Z
+    walls.push_back({ minX, maxZ, maxX, maxZ, SOUTH_WALL, NO_DOOR });     // Front wall, facing -Z
+    walls.push_back({ minX, minZ, minX, maxZ, EAST_WALL, westDoor });     // Left wall, facing +X
+    walls.push_back({ maxX, minZ, maxX, maxZ, WEST_WALL, eastDoor });     // Right wall, facing -X
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "exhibition.cat";
+    int count = argc > 2 ? atoi(argv[2]) : 600;
+    float cellSize = argc > 3 ? static_cast<float>(atof(argv[3])) : 10.0f;
+    if (count <= 0 || cellSize <= 0.0f) {
+        fprintf(stderr, "Usage: %s [out.cat] [piece count] [cell size]\n", argv[0]);
+        return 1;
+    }
+
+    // Main hall 30x30 at the origin, wings 20x20 at x = +-25, z = -5; the doors sit at z = -5
+    std::vector<Wall> walls;
+    addRoomWalls(walls, 0.0f, 0.0f, 30.0f, 30.0f, -5.0f, -5.0f);
+    addRoomWalls(walls, 25.0f, -5.0f, 20.0f, 20.0f, -5.0f, NO_DOOR);
+    addRoomWalls(walls, -25.0f, -5.0f, 20.0f, 20.0f, NO_DOOR, -5.0f);
+
+    // Candidate hooks every 2 units along each wall, in two rows
+    struct Hook { float x, y, z; ArtworkPlacement placement; };
+    std::vector<Hook> hooks;
+    const float rows[] = { 1.0f, 4.0f };
+    for (const Wall& wall : walls) {
+        float dx = wall.x1 - wall.x0, dz = wall.z1 - wall.z0;
+        float length = std::sqrt(dx * dx + dz * dz);
+        for (float t = 1.5f; t < length - 1.0f; t += 2.0f) {
+            float x = wall.x0 + dx * t / length;
+            float z = wall.z0 + dz * t / length;
+            float along = (dx != 0.0f) ? x : z;
+            if (std::fabs(along - wall.doorCenter) < DOOR_CLEARANCE) continue;
+            for (float y : rows) {
+                hooks.push_back({ x, y, z, wall.placement });
+            }
+        }
+    }
+
+    // More pieces than hooks hang in two further rows above the first two
+    CatalogWriter writer;
+    for (int i = 0; i < count; i++) {
+        const Hook& hook = hooks[i % hooks.size()];
+        size_t layer = i / hooks.size();
+
+        CatalogEntry entry;
+        entry.id = static_cast<uint32_t>(i + 1);
+        entry.imagePath = std::string("assets\\pictures\\") + pick(PICTURES, i);
+        entry.framePath = std::string("assets\\textures\\frames\\") + pick(FRAMES, i / 3);
+
+        ArtworkConfig& config = entry.config;
+        config.name = std::string(pick(WORDS, i)) + " " + pick(WORDS, i / 10 + 3) + " #" + std::to_string(i + 1);
+        config.artist = pick(ARTISTS, i / 7);
+        config.year = 1850 + (i * 37) % 170;
+        config.tags.push_back(pick(TAGS, i));
+        config.tags.push_back(pick(TAGS, i / 6 + 1));
+        config.placement = hook.placement;
+        worldToPlacement(hook.placement, hook.x, hook.z, config.posX, config.posZ);
+        config.posY = hook.y + 6.0f * (layer % 2);
+        config.width = 0.003f;
+        config.height = 0.003f;
+        if (i % 5 == 0) {
+            config.hasImageStretch = true;
+            config.imageStretchX = 1.2f;
+            config.imageStretchY = 0.9f;
+        }
+        writer.addEntry(entry);
+    }
+
+    if (!writer.write(path, cellSize)) {
+        fprintf(stderr, "%s: could not write the catalog\n", path.c_str());
+        return 1;
+    }
+    printf("Wrote %d pieces on %zu hooks to %s (%.1f unit cells)\n", count, hooks.size(), path.c_str(), cellSize);
+    return 0;
+}
@@ -0,0 +1,114 @@
+// Turns a binary log (Logger::enableBinaryLogging) back into text lines.
+// Usage: log_decode artspace.binlog [--sites]
+//   --sites  also list every LOG_* call site found in the file
+// Build: g++ -O2 -std=c++17 -DARTSPACE_TRACING=0 -I.. log_decode.cpp ../logger.cpp -o log_decode -lpthread
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "../logger.h"
+
+struct CallSite {
+    std::string format;
+    std::string file;
+    int line;
+    int level;
+};
+
+static const char* LEVEL_NAMES[] = { "DEBUG", "INFO", "WARN", "ERROR" };
+
+template <typename T>
+static bool readRaw(std::ifstream& in, T& value) {
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+static bool readString(std::ifstream& in, std::string& text) {
+    uint16_t length;
+    if (!readRaw(in, length)) return false;
+    text.resize(length);
+    return length == 0 || static_cast<bool>(in.read(&text[0], length));
+}
+
+static const char* levelName(int level) {
+    return level >= 0 && level <= 3 ? LEVEL_NAMES[level] : "?";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <file.binlog> [--sites]\n", argv[0]);
+        return 1;
+    }
+    bool listSites = argc > 2 && strcmp(argv[2], "--sites") == 0;
+
+    std::ifstream in(argv[1], std::ios::in | std::ios::binary);
+    char header[6];
+    if (!in.read(header, sizeof(header)) || memcmp(header, "ASLOG\x02", sizeof(header)) != 0) {
+        fprintf(stderr, "%s: not an ArtSpace binary log\n", argv[1]);
+        return 1;
+    }
+
+    std::map<uint16_t, CallSite> sites;
+    std::string payload;
+    std::string line;
+    char tag;
+    while (in.get(tag)) {
+        if (tag == 'F') {
+            uint16_t id;
+            uint8_t level;
+            int32_t sourceLine;
+            CallSite site;
+            if (!readRaw(in, id) || !readRaw(in, level) || !readRaw(in, sourceLine) ||
+                !readString(in, site.file) || !readString(in, site.format)) break;
+            site.line = sourceLine;
+            site.level = level;
+            sites[id] = site;
+        }
+        else if (tag == 'M') {
+            uint16_t formatId;
+            uint8_t level;
+            int64_t wallMicroseconds;
+            if (!readRaw(in, formatId) || !readRaw(in, level) || !readRaw(in, wallMicroseconds) ||
+                !readString(in, payload)) break;
+
+            std::time_t seconds = static_cast<std::time_t>(wallMicroseconds / 1000000);
+            struct tm timeInfo;
+#ifdef _WIN32
+            localtime_s(&timeInfo, &seconds);
+#else
+            localtime_r(&seconds, &timeInfo);
+#endif
+            char stamp[32];
+            snprintf(stamp, sizeof(stamp), "[%02d:%02d:%02d.%06lld] ", timeInfo.tm_hour, timeInfo.tm_min,
+                timeInfo.tm_sec, static_cast<long long>(wallMicroseconds % 1000000));
+
+            line.assign(stamp);
+            line.append("[").append(levelName(level)).append("] ");
+            if (formatId == 0) {
+                line.append(payload);
+            }
+            else if (sites.count(formatId)) {
+                Logger::formatMessage(sites[formatId].format.c_str(), payload.data(), payload.size(), line);
+            }
+            else {
+                line.append("<unknown format " + std::to_string(formatId) + ">");
+            }
+            printf("%s\n", line.c_str());
+        }
+        else {
+            fprintf(stderr, "%s: corrupt entry at offset %lld\n", argv[1], static_cast<long long>(in.tellg()) - 1);
+            return 1;
+        }
+    }
+
+    if (listSites) {
+        printf("\n%zu call sites\n", sites.size());
+        for (const auto& site : sites) {
+            printf("%5u %-5s %s:%d  \"%s\"\n", site.first, levelName(site.second.level), site.second.file.c_str(),
+                site.second.line, site.second.format.c_str());
+        }
+    }
+    return 0;
+}
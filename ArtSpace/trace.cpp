@@ -0,0 +1,201 @@
+#include "trace.h"
+#include "profiler.h"
+#include <cstdio>
+#include <fstream>
+
+Tracer Tracer::instance;
+
+Tracer::Tracer()
+    : enabled(false) {
+}
+
+Tracer& Tracer::getInstance() {
+    return instance;
+}
+
+Tracer::ThreadTrace* Tracer::getThreadTrace() {
+    static thread_local ThreadTrace* threadTrace = nullptr;
+    if (!threadTrace) {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threads.push_back(std::unique_ptr<ThreadTrace>(new ThreadTrace()));
+        threadTrace = threads.back().get();
+        threadTrace->tid = static_cast<int>(threads.size());
+        threadTrace->name = "Thread " + std::to_string(threadTrace->tid);
+        threadTrace->dropped = 0;
+    }
+    return threadTrace;
+}
+
+void Tracer::start() {
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (std::unique_ptr<ThreadTrace>& thread : threads) {
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+            thread->events.clear();
+            thread->dropped = 0;
+        }
+    }
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::stop() {
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::setThreadName(const std::string& name) {
+    ThreadTrace* thread = getThreadTrace();
+    std::lock_guard<std::mutex> lock(thread->mutex);
+    thread->name = name;
+}
+
+void Tracer::append(const char* name, char phase, uint64_t timestamp, uint64_t duration, double value, const char* detail) {
+    ThreadTrace* thread = getThreadTrace();
+    std::lock_guard<std::mutex> lock(thread->mutex);
+    if (thread->events.size() >= MAX_EVENTS_PER_THREAD) {
+        thread->dropped++;
+        return;
+    }
+
+    thread->events.emplace_back();
+    TraceEvent& event = thread->events.back();
+    event.name = name;
+    event.phase = phase;
+    event.timestamp = timestamp;
+    event.duration = duration;
+    event.value = value;
+    if (detail) {
+        event.detail = detail;
+    }
+}
+
+void Tracer::begin(const char* name, const char* detail) {
+    append(name, 'B', Profiler::now(), 0, 0.0, detail);
+}
+
+void Tracer::end(const char* name) {
+    append(name, 'E', Profiler::now(), 0, 0.0, nullptr);
+}
+
+void Tracer::complete(const char* name, uint64_t start, uint64_t end, const std::string& detail) {
+    append(name, 'X', start, end - start, 0.0, detail.empty() ? nullptr : detail.c_str());
+}
+
+void Tracer::instant(const char* name, const char* detail) {
+    append(name, 'i', Profiler::now(), 0, 0.0, detail);
+}
+
+void Tracer::counter(const char* name, double value) {
+    append(name, 'C', Profiler::now(), 0, value, nullptr);
+}
+
+size_t Tracer::getEventCount() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    size_t count = 0;
+    for (std::unique_ptr<ThreadTrace>& thread : threads) {
+        std::lock_guard<std::mutex> threadLock(thread->mutex);
+        count += thread->events.size();
+    }
+    return count;
+}
+
+// Escape a string for a JSON string literal
+static void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        switch (*c) {
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n"; break;
+        case '\r': out << "\\r"; break;
+        case '\t': out << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(*c) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                out << escaped;
+            }
+            else {
+                out << *c;
+            }
+        }
+    }
+    out << '"';
+}
+
+bool Tracer::writeJson(const std::string& path) {
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        Logger::getInstance().logError("Tracer::writeJson - cannot open " + path);
+        return false;
+    }
+
+    size_t written = 0;
+    uint64_t dropped = 0;
+    char number[64];
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        bool first = true;
+        for (std::unique_ptr<ThreadTrace>& thread : threads) {
+            std::lock_guard<std::mutex> threadLock(thread->mutex);
+
+            // Track name
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread->tid
+                 << ",\"args\":{\"name\":";
+            writeJsonString(file, thread->name.c_str());
+            file << "}}";
+            first = false;
+
+            for (const TraceEvent& event : thread->events) {
+                file << ",\n{\"name\":";
+                writeJsonString(file, event.name);
+                snprintf(number, sizeof(number), "%.3f", event.timestamp / 1000.0);
+                file << ",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << thread->tid << ",\"ts\":" << number;
+
+                if (event.phase == 'X') {
+                    snprintf(number, sizeof(number), "%.3f", event.duration / 1000.0);
+                    file << ",\"dur\":" << number;
+                }
+                else if (event.phase == 'i') {
+                    file << ",\"s\":\"t\"";
+                }
+
+                if (event.phase == 'C') {
+                    snprintf(number, sizeof(number), "%.17g", event.value);
+                    file << ",\"args\":{\"value\":" << number << "}";
+                }
+                else if (!event.detail.empty()) {
+                    file << ",\"args\":{\"detail\":";
+                    writeJsonString(file, event.detail.c_str());
+                    file << "}";
+                }
+                file << "}";
+            }
+            written += thread->events.size();
+            dropped += thread->dropped;
+        }
+        file << "\n]}\n";
+    }
+
+    // Logged outside the locks: a traced log flush would take them again
+    Logger::getInstance().logInfo("Tracer: wrote " + std::to_string(written) + " events to " + path +
+        (dropped ? " (" + std::to_string(dropped) + " dropped)" : ""));
+    return true;
+}
+
+// TraceScope implementation
+TraceScope::TraceScope(const char* eventName)
+    : name(eventName)
+    , start(0)
+    , active(Tracer::isActive()) {
+    if (active) {
+        start = Profiler::now();
+    }
+}
+
+TraceScope::~TraceScope() {
+    // Also records scopes that were open when tracing stopped
+    if (active) {
+        Tracer::getInstance().complete(name, start, Profiler::now(), detail);
+    }
+}
@@ -0,0 +1,148 @@
+/**
+ * @file trace.h
+ * @brief Timeline instrumentation exported as Chrome trace-event JSON
+ *
+ * Where the profiler (profiler.h) aggregates per-frame totals, the tracer
+ * keeps every event so overlapping work can be inspected on one timeline:
+ * frames, image decodes, GL uploads, screen transitions, log flushes and the
+ * catalog loader thread. writeJson() produces a file that opens in Perfetto
+ * (ui.perfetto.dev) or chrome://tracing.
+ *
+ * Cost when disabled:
+ * - compile time: build with ARTSPACE_TRACING=0 and every TRACE_* macro
+ *   expands to nothing;
+ * - run time: each macro is a single relaxed atomic load until start().
+ *
+ * Events are appended to a per-thread buffer; only the exporter ever
+ * contends for a buffer's lock.
+ *
+ * Usage:
+ *    Tracer::getInstance().start();
+ *
+ *    void loadThing(const std::string& path) {
+ *        TRACE_SCOPE_DETAIL("Load", path);   // Complete event with an argument
+ *        ...
+ *    }
+ *    TRACE_INSTANT("Screen change");
+ *    TRACE_COUNTER("Resident artworks", count);
+ *
+ *    Tracer::getInstance().stop();
+ *    Tracer::getInstance().writeJson("trace.json");
+ */
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef ARTSPACE_TRACING
+#define ARTSPACE_TRACING 1
+#endif
+
+class Tracer {
+private:
+    struct TraceEvent {
+        const char* name;       // Must be a string literal (or otherwise outlive the trace)
+        char phase;             // Chrome phase: 'X' complete, 'B'/'E' begin/end, 'i' instant, 'C' counter
+        uint64_t timestamp;     // Nanoseconds, same clock as the profiler
+        uint64_t duration;      // 'X' only
+        double value;           // 'C' only
+        std::string detail;     // Optional "detail" argument
+    };
+
+    struct ThreadTrace {
+        std::mutex mutex;
+        std::vector<TraceEvent> events;
+        int tid;
+        std::string name;
+        uint64_t dropped;
+    };
+
+    static Tracer instance;
+    static constexpr size_t MAX_EVENTS_PER_THREAD = 1 << 20;
+
+    std::atomic<bool> enabled;
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadTrace>> threads;
+
+    Tracer();
+
+    ThreadTrace* getThreadTrace();
+    void append(const char* name, char phase, uint64_t timestamp, uint64_t duration, double value, const char* detail);
+
+public:
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    static Tracer& getInstance();
+
+    // Cheap check used by the macros
+    static bool isActive() { return instance.enabled.load(std::memory_order_relaxed); }
+
+    // Start a new capture (drops previous events) / stop recording
+    void start();
+    void stop();
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Name the calling thread's track
+    void setThreadName(const std::string& name);
+
+    // Event recording
+    void begin(const char* name, const char* detail = nullptr);
+    void end(const char* name);
+    void complete(const char* name, uint64_t start, uint64_t end, const std::string& detail);
+    void instant(const char* name, const char* detail = nullptr);
+    void counter(const char* name, double value);
+
+    // Write everything captured so far as Chrome trace-event JSON
+    bool writeJson(const std::string& path);
+    size_t getEventCount();
+};
+
+// Records a complete ('X') event covering its lifetime
+class TraceScope {
+private:
+    const char* name;
+    uint64_t start;
+    bool active;
+    std::string detail;
+
+public:
+    explicit TraceScope(const char* eventName);
+    ~TraceScope();
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    bool isActive() const { return active; }
+    void setDetail(const std::string& text) { detail = text; }
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if ARTSPACE_TRACING
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+// The detail expression is only evaluated while tracing
+#define TRACE_SCOPE_DETAIL(name, detail) \
+    TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name); \
+    if (TRACE_CONCAT(traceScope_, __LINE__).isActive()) TRACE_CONCAT(traceScope_, __LINE__).setDetail(detail)
+#define TRACE_BEGIN(name) do { if (Tracer::isActive()) Tracer::getInstance().begin(name); } while (0)
+#define TRACE_END(name) do { if (Tracer::isActive()) Tracer::getInstance().end(name); } while (0)
+#define TRACE_INSTANT(name) do { if (Tracer::isActive()) Tracer::getInstance().instant(name); } while (0)
+#define TRACE_INSTANT_DETAIL(name, detail) \
+    do { if (Tracer::isActive()) Tracer::getInstance().instant(name, std::string(detail).c_str()); } while (0)
+#define TRACE_COUNTER(name, value) \
+    do { if (Tracer::isActive()) Tracer::getInstance().counter(name, static_cast<double>(value)); } while (0)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_DETAIL(name, detail) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#define TRACE_INSTANT_DETAIL(name, detail) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#endif
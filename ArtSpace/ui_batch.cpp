@@ -0,0 +1,158 @@
+#include "ui_batch.h"
+#include "text_renderer.h"
+#include "utility.h"
+#include <algorithm>
+
+UIBatch::UIBatch()
+    : drawCalls(0) {
+}
+
+void UIBatch::clear() {
+    solidVertices.clear();
+    imageVertices.clear();
+    imageRuns.clear();
+    for (TextRun& run : textRuns) {
+        run.vertices.clear();
+    }
+    customDraws.clear();
+}
+
+bool UIBatch::isEmpty() const {
+    if (!solidVertices.empty() || !imageVertices.empty() || !customDraws.empty()) return false;
+    for (const TextRun& run : textRuns) {
+        if (!run.vertices.empty()) return false;
+    }
+    return true;
+}
+
+void UIBatch::toBytes(const float* color, float alpha, GLubyte* out) {
+    static const float WHITE[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    if (!color) color = WHITE;
+    for (int i = 0; i < 4; i++) {
+        float value = i == 3 ? color[i] * alpha : color[i];
+        out[i] = static_cast<GLubyte>(std::min(std::max(value, 0.0f), 1.0f) * 255.0f + 0.5f);
+    }
+}
+
+void UIBatch::appendQuad(std::vector<Vertex>& vertices, float x0, float y0, float x1, float y1,
+                         float u0, float v0, float u1, float v1, const GLubyte* color) {
+    vertices.push_back({ x0, y0, u0, v0, { color[0], color[1], color[2], color[3] } });
+    vertices.push_back({ x1, y0, u1, v0, { color[0], color[1], color[2], color[3] } });
+    vertices.push_back({ x1, y1, u1, v1, { color[0], color[1], color[2], color[3] } });
+    vertices.push_back({ x0, y1, u0, v1, { color[0], color[1], color[2], color[3] } });
+}
+
+void UIBatch::addRect(float x, float y, float width, float height, const float* color, float alpha) {
+    GLubyte rgba[4];
+    toBytes(color, alpha, rgba);
+    appendQuad(solidVertices, x, y, x + width, y + height, 0.0f, 0.0f, 0.0f, 0.0f, rgba);
+}
+
+void UIBatch::addOutline(float x, float y, float width, float height, float thickness, const float* color,
+                         float alpha) {
+    thickness = std::min(thickness, std::min(width, height) / 2);
+    if (thickness <= 0.0f) return;
+    GLubyte rgba[4];
+    toBytes(color, alpha, rgba);
+    float right = x + width;
+    float top = y + height;
+    appendQuad(solidVertices, x, y, right, y + thickness, 0.0f, 0.0f, 0.0f, 0.0f, rgba);
+    appendQuad(solidVertices, x, top - thickness, right, top, 0.0f, 0.0f, 0.0f, 0.0f, rgba);
+    appendQuad(solidVertices, x, y + thickness, x + thickness, top - thickness, 0.0f, 0.0f, 0.0f, 0.0f, rgba);
+    appendQuad(solidVertices, right - thickness, y + thickness, right, top - thickness, 0.0f, 0.0f, 0.0f, 0.0f, rgba);
+}
+
+void UIBatch::addImage(Image* image, float x, float y, float width, float height, const float* tint, float alpha) {
+    GLubyte rgba[4];
+    toBytes(tint, alpha, rgba);
+    if (imageRuns.empty() || imageRuns.back().image != image) {
+        imageRuns.push_back({ image, imageVertices.size(), 0 });
+    }
+    appendQuad(imageVertices, x, y, x + width, y + height, 0.0f, 0.0f, 1.0f, 1.0f, rgba);
+    imageRuns.back().count += 4;
+}
+
+void UIBatch::addText(float x, float y, const std::string& text, const float* color, float alpha,
+                      unsigned int fontSize) {
+    TextRenderer::getInstance().append(*this, x, y, text, color, alpha, fontSize);
+}
+
+void UIBatch::addCustom(const std::function<void()>& draw) {
+    customDraws.push_back(draw);
+}
+
+std::vector<UIBatch::Vertex>& UIBatch::getTextVertices(unsigned int fontSize) {
+    for (TextRun& run : textRuns) {
+        if (run.fontSize == fontSize) return run.vertices;
+    }
+    textRuns.push_back(TextRun());
+    textRuns.back().fontSize = fontSize;
+    return textRuns.back().vertices;
+}
+
+void UIBatch::draw() {
+    drawCalls = 0;
+    if (isEmpty()) return;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_COLOR_BUFFER_BIT | GL_CURRENT_BIT);
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_BLEND);
+    setUIBlendFunc();
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glMatrixMode(GL_TEXTURE);
+    glPushMatrix();
+    glLoadIdentity();
+
+    // Solid shapes
+    if (!solidVertices.empty()) {
+        glDisable(GL_TEXTURE_2D);
+        glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &solidVertices[0].x);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), solidVertices[0].color);
+        glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(solidVertices.size()));
+        drawCalls++;
+    }
+
+    glEnable(GL_TEXTURE_2D);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+    // Images
+    if (!imageVertices.empty()) {
+        glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &imageVertices[0].x);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &imageVertices[0].u);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), imageVertices[0].color);
+        for (const ImageRun& run : imageRuns) {
+            run.image->bindTexture();
+            glDrawArrays(GL_QUADS, static_cast<GLint>(run.first), static_cast<GLsizei>(run.count));
+            drawCalls++;
+        }
+    }
+
+    // Text; the texture matrix turns atlas pixels into texture coordinates
+    for (const TextRun& run : textRuns) {
+        float uScale, vScale;
+        if (run.vertices.empty() || !TextRenderer::getInstance().bindAtlas(run.fontSize, uScale, vScale)) continue;
+        glLoadIdentity();
+        glScalef(uScale, vScale, 1.0f);
+        glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &run.vertices[0].x);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &run.vertices[0].u);
+        glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), run.vertices[0].color);
+        glDrawArrays(GL_QUADS, 0, static_cast<GLsizei>(run.vertices.size()));
+        drawCalls++;
+    }
+
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopClientAttrib();
+    glPopAttrib();
+
+    // Components that draw themselves, with the caller's state
+    for (const std::function<void()>& draw : customDraws) {
+        draw();
+        drawCalls++;
+    }
+}
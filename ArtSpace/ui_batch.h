@@ -0,0 +1,95 @@
+/**
+ * @file ui_batch.h
+ * @brief Vertex stream for UI widgets, drawn in a handful of calls
+ *
+ * Widgets append their shapes instead of drawing them. The batch keeps
+ * three layers and draws them in order:
+ * - Solid: every untextured rectangle and outline (outlines are thin
+ *   rectangles, so border widths need no glLineWidth change). One call.
+ * - Images: textured rectangles, one call per distinct image in a row.
+ * - Text: glyph quads from TextRenderer's atlas, one call per font size.
+ * Components that still draw themselves are called back afterwards, in
+ * the order they were added.
+ *
+ * Within a layer shapes keep their order, so a child's background still
+ * covers its parent's. Across layers text is on top of images, which are
+ * on top of solid shapes.
+ *
+ * A batch can be kept and redrawn as long as its widgets do not change:
+ * ScreenManager rebuilds its batch only when a component is dirty.
+ *
+ * Usage:
+ *    UIBatch batch;
+ *    batch.addRect(x, y, width, height, color);
+ *    batch.addOutline(x, y, width, height, 2.0f, borderColor);
+ *    batch.addText(x + 5, baseline, "Start", white);
+ *    batch.draw();                            // In screen space
+ */
+
+#pragma once
+#include <GL/glut.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+class Image;
+
+class UIBatch {
+public:
+    struct Vertex {
+        float x, y;
+        float u, v;
+        GLubyte color[4];
+    };
+
+private:
+    // Consecutive image quads with the same image
+    struct ImageRun {
+        Image* image;
+        size_t first;
+        size_t count;
+    };
+
+    struct TextRun {
+        unsigned int fontSize;
+        std::vector<Vertex> vertices;       // Atlas pixel coordinates
+    };
+
+    std::vector<Vertex> solidVertices;
+    std::vector<Vertex> imageVertices;
+    std::vector<ImageRun> imageRuns;
+    std::vector<TextRun> textRuns;
+    std::vector<std::function<void()>> customDraws;
+    size_t drawCalls;
+
+    static void toBytes(const float* color, float alpha, GLubyte* out);
+    static void appendQuad(std::vector<Vertex>& vertices, float x0, float y0, float x1, float y1,
+                           float u0, float v0, float u1, float v1, const GLubyte* color);
+
+public:
+    UIBatch();
+
+    void clear();
+    bool isEmpty() const;
+
+    // color is RGBA; alpha multiplies its alpha (the component's fade)
+    void addRect(float x, float y, float width, float height, const float* color, float alpha = 1.0f);
+    // Border of the given thickness inside the rectangle
+    void addOutline(float x, float y, float width, float height, float thickness, const float* color,
+                    float alpha = 1.0f);
+    // Image stretched over the rectangle, tinted
+    void addImage(Image* image, float x, float y, float width, float height, const float* tint, float alpha = 1.0f);
+    // Text with its baseline starting at (x, y)
+    void addText(float x, float y, const std::string& text, const float* color, float alpha = 1.0f,
+                 unsigned int fontSize = 12);
+    // Drawn by a callback after the layers (for components that draw themselves)
+    void addCustom(const std::function<void()>& draw);
+
+    // Glyph quads from TextRenderer (atlas pixel coordinates)
+    std::vector<Vertex>& getTextVertices(unsigned int fontSize);
+
+    void draw();
+
+    // Calls issued by the last draw()
+    size_t getDrawCalls() const { return drawCalls; }
+};
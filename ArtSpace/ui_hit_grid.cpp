@@ -0,0 +1,105 @@
+#include "ui_hit_grid.h"
+#include "utility.h"
+#include <algorithm>
+#include <cmath>
+
+UIHitGrid::UIHitGrid()
+    : originX(0.0f)
+    , originY(0.0f)
+    , cellSize(CELL_SIZE)
+    , columns(0)
+    , rows(0) {
+}
+
+void UIHitGrid::clear() {
+    widgets.clear();
+    cellStarts.clear();
+    cellWidgets.clear();
+    columns = 0;
+    rows = 0;
+}
+
+void UIHitGrid::rebuild(const std::vector<UIComponent*>& components) {
+    clear();
+    for (UIComponent* component : components) {
+        if (component && component->getVisible() && widgets.size() < UINT16_MAX) {
+            widgets.push_back(component);
+        }
+    }
+    if (widgets.empty()) return;
+
+    float minX = widgets[0]->getPosition()[0];
+    float minY = widgets[0]->getPosition()[1];
+    float maxX = minX;
+    float maxY = minY;
+    for (UIComponent* widget : widgets) {
+        const float* position = widget->getPosition();
+        const float* size = widget->getSize();
+        minX = std::min(minX, position[0]);
+        minY = std::min(minY, position[1]);
+        maxX = std::max(maxX, position[0] + size[0]);
+        maxY = std::max(maxY, position[1] + size[1]);
+    }
+
+    originX = minX;
+    originY = minY;
+    cellSize = std::max(CELL_SIZE, std::max(maxX - minX, maxY - minY) / MAX_CELLS_PER_AXIS);
+    columns = std::max(1, static_cast<int>(std::ceil((maxX - minX) / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) / cellSize)));
+
+    // Two passes: count per cell, then fill, so the lists are one flat array
+    auto cellRange = [this](UIComponent* widget, int& firstColumn, int& lastColumn, int& firstRow, int& lastRow) {
+        const float* position = widget->getPosition();
+        const float* size = widget->getSize();
+        firstColumn = std::min(columns - 1, static_cast<int>((position[0] - originX) / cellSize));
+        lastColumn = std::min(columns - 1, static_cast<int>((position[0] + size[0] - originX) / cellSize));
+        firstRow = std::min(rows - 1, static_cast<int>((position[1] - originY) / cellSize));
+        lastRow = std::min(rows - 1, static_cast<int>((position[1] + size[1] - originY) / cellSize));
+    };
+
+    cellStarts.assign(getCellCount() + 1, 0);
+    for (UIComponent* widget : widgets) {
+        int firstColumn, lastColumn, firstRow, lastRow;
+        cellRange(widget, firstColumn, lastColumn, firstRow, lastRow);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                cellStarts[row * columns + column + 1]++;
+            }
+        }
+    }
+    for (size_t cell = 1; cell < cellStarts.size(); cell++) {
+        cellStarts[cell] += cellStarts[cell - 1];
+    }
+
+    cellWidgets.resize(cellStarts.back());
+    std::vector<uint32_t> fill(cellStarts.begin(), cellStarts.end() - 1);
+    for (size_t index = 0; index < widgets.size(); index++) {
+        int firstColumn, lastColumn, firstRow, lastRow;
+        cellRange(widgets[index], firstColumn, lastColumn, firstRow, lastRow);
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                cellWidgets[fill[row * columns + column]++] = static_cast<uint16_t>(index);
+            }
+        }
+    }
+}
+
+void UIHitGrid::query(float x, float y, std::vector<UIComponent*>& hits) const {
+    hits.clear();
+    if (columns == 0 || x < originX || y < originY) return;
+
+    int column = static_cast<int>((x - originX) / cellSize);
+    int row = static_cast<int>((y - originY) / cellSize);
+    // The far edges belong to the last cell, like isPointInside() includes them
+    if (column > columns || row > rows) return;
+    column = std::min(column, columns - 1);
+    row = std::min(row, rows - 1);
+
+    size_t cell = static_cast<size_t>(row) * columns + column;
+    for (uint32_t i = cellStarts[cell + 1]; i > cellStarts[cell]; i--) {
+        UIComponent* widget = widgets[cellWidgets[i - 1]];
+        if (widget->isPointInside(x, y)) {
+            hits.push_back(widget);
+        }
+    }
+}
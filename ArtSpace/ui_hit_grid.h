@@ -0,0 +1,53 @@
+/**
+ * @file ui_hit_grid.h
+ * @brief Uniform grid over widget rectangles for finding the widgets under a point
+ *
+ * The area covered by the widgets is split into square cells; each cell
+ * lists the widgets overlapping it, in the order they were given (back to
+ * front). A point query looks at one cell only, so hit-testing costs the
+ * same with five widgets or five hundred, as long as they do not all pile
+ * onto the same spot.
+ *
+ * The grid is a snapshot: rebuild it when widgets move, resize, appear or
+ * disappear (UIComponent::getLayoutVersion() changes).
+ *
+ * Usage:
+ *    UIHitGrid grid;
+ *    grid.rebuild(components);
+ *    std::vector<UIComponent*> hits;
+ *    grid.query(x, y, hits);               // Front to back, y up
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class UIComponent;
+
+class UIHitGrid {
+public:
+    static constexpr float CELL_SIZE = 64.0f;
+    // Larger areas get larger cells rather than more of them
+    static constexpr int MAX_CELLS_PER_AXIS = 64;
+
+private:
+    std::vector<UIComponent*> widgets;
+    std::vector<uint32_t> cellStarts;       // Per cell, its range in cellWidgets (columns * rows + 1)
+    std::vector<uint16_t> cellWidgets;      // Indices into widgets
+    float originX, originY;
+    float cellSize;
+    int columns, rows;
+
+public:
+    UIHitGrid();
+
+    // Index the visible components; earlier ones are behind later ones
+    void rebuild(const std::vector<UIComponent*>& components);
+    void clear();
+
+    // Visible components containing the point, front to back
+    void query(float x, float y, std::vector<UIComponent*>& hits) const;
+
+    size_t getCellCount() const { return static_cast<size_t>(columns) * rows; }
+};
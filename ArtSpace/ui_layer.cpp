@@ -0,0 +1,91 @@
+#include "ui_layer.h"
+#include "gl_extensions.h"
+#include "utility.h"
+
+UILayer::UILayer()
+    : valid(false)
+    , disabled(false)
+    , redraws(0) {
+}
+
+bool UILayer::isSupported() {
+    return glext.framebufferObjects && glext.separateBlend;
+}
+
+void UILayer::render(int width, int height, bool changed, const std::function<void()>& draw) {
+    if (disabled || !isSupported()) {
+        draw();
+        redraws++;
+        return;
+    }
+
+    bool resized = target.getWidth() != width || target.getHeight() != height;
+    if (!valid || changed || resized) {
+        if (!target.ensureSize(width, height)) {
+            LOG_WARN("UI layer disabled: cannot create a {}x{} framebuffer", width, height);
+            disabled = true;
+            target.destroy();
+            draw();
+            redraws++;
+            return;
+        }
+
+        target.bind();
+        glPushAttrib(GL_COLOR_BUFFER_BIT);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        glPopAttrib();
+        draw();
+        RenderTarget::unbind();
+        glViewport(0, 0, width, height);
+        valid = true;
+        redraws++;
+    }
+
+    composite(width, height);
+}
+
+// One window-sized quad; the layer's colour is already multiplied by its alpha
+void UILayer::composite(int width, int height) {
+    glViewport(0, 0, width, height);
+
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, target.getColorTexture());
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
+    glColor4f(1.0f, 1.0f, 1.0f, 1.0f);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    // Same size as the window, so every pixel samples exactly one texel
+    glBegin(GL_QUADS);
+    glTexCoord2f(0.0f, 0.0f); glVertex2f(-1.0f, -1.0f);
+    glTexCoord2f(1.0f, 0.0f); glVertex2f(1.0f, -1.0f);
+    glTexCoord2f(1.0f, 1.0f); glVertex2f(1.0f, 1.0f);
+    glTexCoord2f(0.0f, 1.0f); glVertex2f(-1.0f, 1.0f);
+    glEnd();
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPopAttrib();
+}
+
+void UILayer::release() {
+    target.destroy();
+    valid = false;
+    disabled = false;
+}
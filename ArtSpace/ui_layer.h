@@ -0,0 +1,58 @@
+/**
+ * @file ui_layer.h
+ * @brief Screen-space UI kept in an offscreen texture and redrawn only when it changes
+ *
+ * The overlays (search box, profiler HUD) are drawn into a window-sized
+ * RenderTarget cleared to transparent. Frames where no widget changed skip
+ * the UI drawing entirely: the texture is blended over the 3D scene as one
+ * quad.
+ *
+ * UI drawn with setUIBlendFunc() leaves coverage in the layer's alpha, so the
+ * colour is premultiplied and the layer composites with (1, 1 - alpha) like
+ * the UI drawn straight to the window would have. That needs separate alpha
+ * blending as well as framebuffer objects; without either the layer draws
+ * straight to the window every frame.
+ *
+ * Usage:
+ *    UILayer layer;
+ *    bool changed = hud->isDirty() || searchBox->isDirty();
+ *    layer.render(width, height, changed, [&]() {
+ *        beginScreenSpace(width, height);
+ *        hud->render();
+ *        endScreenSpace();
+ *    });
+ */
+
+#pragma once
+#include <GL/glut.h>
+#include <functional>
+#include "render_target.h"
+
+class UILayer {
+private:
+    RenderTarget target;
+    bool valid;             // The texture holds the current UI
+    bool disabled;          // Creating the target failed; draw directly
+    size_t redraws;
+
+    void composite(int width, int height);
+
+public:
+    UILayer();
+
+    UILayer(const UILayer&) = delete;
+    UILayer& operator=(const UILayer&) = delete;
+
+    // Framebuffer objects and separate alpha blending are available
+    static bool isSupported();
+
+    // Redraw the layer with draw() if changed, invalidated or resized, then blend it over the window
+    void render(int width, int height, bool changed, const std::function<void()>& draw);
+    // The next render() redraws whatever changed says
+    void invalidate() { valid = false; }
+    // Delete the texture (needs the GL context)
+    void release();
+
+    // Times the UI was actually drawn
+    size_t getRedraws() const { return redraws; }
+};
@@ -0,0 +1,265 @@
+#include "ui_layout.h"
+#include "utility.h"
+#include <algorithm>
+#include <cfloat>
+
+UILayout::UILayout()
+    : bounds{ 0.0f, 0.0f }
+    , valid(false)
+    , passes(0) {
+    addNode(-1, nullptr, Direction::Stack);
+    nodes[ROOT].align[0] = Align::Stretch;
+    nodes[ROOT].align[1] = Align::Stretch;
+}
+
+UILayout::NodeId UILayout::addNode(NodeId parent, UIComponent* widget, Direction direction) {
+    Node node;
+    node.widget = widget;
+    node.direction = direction;
+    node.preferred[0] = widget ? widget->getSize()[0] : 0.0f;
+    node.preferred[1] = widget ? widget->getSize()[1] : 0.0f;
+    node.minSize[0] = node.minSize[1] = 0.0f;
+    node.maxSize[0] = node.maxSize[1] = FLT_MAX;
+    node.grow = 0.0f;
+    node.padding = 0.0f;
+    node.spacing = 0.0f;
+    node.justify = Align::Start;
+    node.align[0] = node.align[1] = Align::Center;
+    node.measured[0] = node.measured[1] = 0.0f;
+    node.rect = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    NodeId id = static_cast<NodeId>(nodes.size());
+    nodes.push_back(node);
+    if (parent >= 0) {
+        nodes[parent].children.push_back(id);
+    }
+    valid = false;
+    return id;
+}
+
+UILayout::NodeId UILayout::addContainer(NodeId parent, Direction direction) {
+    return addNode(parent, nullptr, direction);
+}
+
+UILayout::NodeId UILayout::addWidget(NodeId parent, UIComponent* widget) {
+    return addNode(parent, widget, Direction::Stack);
+}
+
+void UILayout::clear() {
+    nodes.resize(1);
+    nodes[ROOT].children.clear();
+    valid = false;
+}
+
+void UILayout::setPreferredSize(NodeId id, float width, float height) {
+    nodes[id].preferred[0] = width;
+    nodes[id].preferred[1] = height;
+    valid = false;
+}
+
+void UILayout::setMinSize(NodeId id, float width, float height) {
+    nodes[id].minSize[0] = width;
+    nodes[id].minSize[1] = height;
+    valid = false;
+}
+
+void UILayout::setMaxSize(NodeId id, float width, float height) {
+    nodes[id].maxSize[0] = width;
+    nodes[id].maxSize[1] = height;
+    valid = false;
+}
+
+void UILayout::setGrow(NodeId id, float grow) {
+    nodes[id].grow = std::max(grow, 0.0f);
+    valid = false;
+}
+
+void UILayout::setPadding(NodeId id, float padding) {
+    nodes[id].padding = padding;
+    valid = false;
+}
+
+void UILayout::setSpacing(NodeId id, float spacing) {
+    nodes[id].spacing = spacing;
+    valid = false;
+}
+
+void UILayout::setJustify(NodeId id, Align justify) {
+    nodes[id].justify = justify;
+    valid = false;
+}
+
+void UILayout::setAlign(NodeId id, Align alignX, Align alignY) {
+    nodes[id].align[0] = alignX;
+    nodes[id].align[1] = alignY;
+    valid = false;
+}
+
+void UILayout::setBounds(float width, float height) {
+    if (bounds[0] == width && bounds[1] == height) return;
+    bounds[0] = width;
+    bounds[1] = height;
+    valid = false;
+}
+
+float UILayout::clampSize(const Node& node, int axis, float value) const {
+    return std::max(node.minSize[axis], std::min(node.maxSize[axis], value));
+}
+
+bool UILayout::update() {
+    if (valid) return false;
+
+    measure(ROOT);
+    place(ROOT, { 0.0f, 0.0f, bounds[0], bounds[1] });
+    valid = true;
+    passes++;
+    return true;
+}
+
+// Bottom-up: a container needs room for its children and its padding
+void UILayout::measure(NodeId id) {
+    Node& node = nodes[id];
+    float content[2] = { 0.0f, 0.0f };
+    if (!node.widget) {
+        int main = node.direction == Direction::Row ? 0 : 1;
+        for (NodeId childId : node.children) {
+            measure(childId);
+            const Node& child = nodes[childId];
+            if (node.direction == Direction::Stack) {
+                content[0] = std::max(content[0], child.measured[0]);
+                content[1] = std::max(content[1], child.measured[1]);
+            }
+            else {
+                content[main] += child.measured[main];
+                content[1 - main] = std::max(content[1 - main], child.measured[1 - main]);
+            }
+        }
+        if (node.direction != Direction::Stack && node.children.size() > 1) {
+            content[main] += node.spacing * (node.children.size() - 1);
+        }
+        content[0] += node.padding * 2;
+        content[1] += node.padding * 2;
+    }
+
+    for (int axis = 0; axis < 2; axis++) {
+        node.measured[axis] = clampSize(node, axis, std::max(content[axis], node.preferred[axis]));
+    }
+}
+
+// Top-down: the parent has decided this node's rectangle
+void UILayout::place(NodeId id, const Rect& rect) {
+    Node& node = nodes[id];
+    node.rect = rect;
+    if (node.widget) {
+        node.widget->setPosition(rect.x, rect.y);
+        node.widget->setSize(rect.width, rect.height);
+    }
+    else {
+        placeChildren(node);
+    }
+}
+
+// Offset of a child of the given size inside the available room
+static float alignOffset(UILayout::Align align, float available, float size) {
+    switch (align) {
+    case UILayout::Align::Start:
+        return 0.0f;
+    case UILayout::Align::End:
+        return available - size;
+    default:
+        return (available - size) / 2;     // Center, or Stretch held back by its max size
+    }
+}
+
+void UILayout::placeChildren(const Node& node) {
+    if (node.children.empty()) return;
+
+    float innerStart[2] = { node.rect.x + node.padding, node.rect.y + node.padding };
+    float inner[2] = {
+        std::max(0.0f, node.rect.width - node.padding * 2),
+        std::max(0.0f, node.rect.height - node.padding * 2)
+    };
+
+    // Size of a child across an axis it does not share with its siblings
+    auto crossSize = [this, &inner](const Node& child, int axis) {
+        return child.align[axis] == Align::Stretch ? clampSize(child, axis, inner[axis]) : child.measured[axis];
+    };
+
+    if (node.direction == Direction::Stack) {
+        for (NodeId childId : node.children) {
+            const Node& child = nodes[childId];
+            Rect rect;
+            rect.width = crossSize(child, 0);
+            rect.height = crossSize(child, 1);
+            rect.x = innerStart[0] + alignOffset(child.align[0], inner[0], rect.width);
+            rect.y = innerStart[1] + alignOffset(child.align[1], inner[1], rect.height);
+            place(childId, rect);
+        }
+        return;
+    }
+
+    int main = node.direction == Direction::Row ? 0 : 1;
+    int cross = 1 - main;
+    size_t count = node.children.size();
+
+    // Spare room goes to the growing children by weight; one that reaches its
+    // max size drops out and the rest share what it could not take
+    std::vector<float> sizes(count);
+    std::vector<bool> growing(count);
+    float used = node.spacing * (count - 1);
+    float growTotal = 0.0f;
+    for (size_t i = 0; i < count; i++) {
+        const Node& child = nodes[node.children[i]];
+        sizes[i] = child.measured[main];
+        used += sizes[i];
+        growing[i] = child.grow > 0.0f;
+        if (growing[i]) growTotal += child.grow;
+    }
+
+    float spare = inner[main] - used;
+    while (spare > 0.5f && growTotal > 0.0f) {
+        float perWeight = spare / growTotal;
+        bool clamped = false;
+        for (size_t i = 0; i < count; i++) {
+            if (!growing[i]) continue;
+            const Node& child = nodes[node.children[i]];
+            float target = sizes[i] + perWeight * child.grow;
+            if (target >= child.maxSize[main]) {
+                spare -= child.maxSize[main] - sizes[i];
+                sizes[i] = child.maxSize[main];
+                growing[i] = false;
+                growTotal -= child.grow;
+                clamped = true;
+            }
+        }
+        if (clamped) continue;
+
+        for (size_t i = 0; i < count; i++) {
+            if (growing[i]) sizes[i] += perWeight * nodes[node.children[i]].grow;
+        }
+        spare = 0.0f;
+    }
+
+    // Rows run left to right and columns top to bottom
+    float groupSize = inner[main] - spare;
+    float groupStart = innerStart[main] + alignOffset(node.justify, inner[main], groupSize);
+    float cursor = main == 0 ? groupStart : groupStart + groupSize;
+    for (size_t i = 0; i < count; i++) {
+        const Node& child = nodes[node.children[i]];
+        float extent[2];
+        float origin[2];
+        extent[main] = sizes[i];
+        extent[cross] = crossSize(child, cross);
+        origin[cross] = innerStart[cross] + alignOffset(child.align[cross], inner[cross], extent[cross]);
+        if (main == 0) {
+            origin[0] = cursor;
+            cursor += sizes[i] + node.spacing;
+        }
+        else {
+            cursor -= sizes[i];
+            origin[1] = cursor;
+            cursor -= node.spacing;
+        }
+        place(node.children[i], { origin[0], origin[1], extent[0], extent[1] });
+    }
+}
@@ -0,0 +1,116 @@
+/**
+ * @file ui_layout.h
+ * @brief Row/column/stack layout that places widgets in one pass and keeps the result
+ *
+ * A layout is a tree of nodes under a root that covers the window. A node is
+ * either a container, which arranges its children, or a widget leaf:
+ * - Row: children left to right.
+ * - Column: children top to bottom.
+ * - Stack: children on top of each other, each placed by its own alignment.
+ *
+ * Every node has a preferred size (a widget's is its size when added), min
+ * and max sizes, and a grow factor that shares out the spare room along a
+ * row or column. Containers add padding around and spacing between their
+ * children; justify places the children along the main axis when none of
+ * them grows. A child's alignX/alignY place it across the axis (or both ways
+ * in a stack); Stretch fills the available room, up to the max size.
+ *
+ * update() measures the tree bottom-up, then places it top-down, and sets
+ * the widgets' positions and sizes. The rectangles are kept until the
+ * bounds or a node's settings change, so frames where nothing changed cost
+ * one flag check, and a window resize costs one pass.
+ *
+ * Coordinates are window pixels with the origin at the bottom left (y up).
+ *
+ * Usage:
+ *    UILayout layout;
+ *    UILayout::NodeId menu = layout.addContainer(UILayout::ROOT, UILayout::Direction::Column);
+ *    layout.setSpacing(menu, 25.0f);
+ *    layout.setAlign(menu, UILayout::Align::Center, UILayout::Align::Center);
+ *    layout.addWidget(menu, title);
+ *    layout.addWidget(menu, startButton);
+ *
+ *    layout.setBounds(width, height);      // From resizeScreen()
+ *    layout.update();                      // Lays out only if something changed
+ */
+
+#pragma once
+#include <cstddef>
+#include <vector>
+
+class UIComponent;
+
+class UILayout {
+public:
+    typedef int NodeId;
+    static constexpr NodeId ROOT = 0;
+
+    enum class Direction { Row, Column, Stack };
+    // Start is left or bottom, End is right or top
+    enum class Align { Start, Center, End, Stretch };
+
+    struct Rect {
+        float x, y;
+        float width, height;
+    };
+
+private:
+    struct Node {
+        UIComponent* widget;            // Null for containers
+        Direction direction;
+        std::vector<NodeId> children;
+
+        float preferred[2];
+        float minSize[2];
+        float maxSize[2];
+        float grow;
+        float padding;
+        float spacing;
+        Align justify;                  // Children along the main axis
+        Align align[2];                 // This node across its parent's axis (x, y)
+
+        float measured[2];              // Preferred size clamped to min/max, containers from children
+        Rect rect;
+    };
+
+    std::vector<Node> nodes;
+    float bounds[2];
+    bool valid;
+    size_t passes;
+
+    NodeId addNode(NodeId parent, UIComponent* widget, Direction direction);
+    void measure(NodeId id);
+    void place(NodeId id, const Rect& rect);
+    void placeChildren(const Node& node);
+    float clampSize(const Node& node, int axis, float value) const;
+
+public:
+    UILayout();
+
+    // The root is a stack covering the bounds
+    NodeId addContainer(NodeId parent, Direction direction);
+    // The widget's current size is its preferred size
+    NodeId addWidget(NodeId parent, UIComponent* widget);
+    // Drop every node but the root
+    void clear();
+
+    void setPreferredSize(NodeId id, float width, float height);
+    void setMinSize(NodeId id, float width, float height);
+    void setMaxSize(NodeId id, float width, float height);
+    void setGrow(NodeId id, float grow);
+    void setPadding(NodeId id, float padding);
+    void setSpacing(NodeId id, float spacing);
+    void setJustify(NodeId id, Align justify);
+    void setAlign(NodeId id, Align alignX, Align alignY);
+
+    // Area the root fills; invalidates only if it changed
+    void setBounds(float width, float height);
+    // Force the next update() to lay out again (a widget's content changed its needs)
+    void invalidate() { valid = false; }
+
+    // Lay out if anything changed since the last pass; true if it did
+    bool update();
+
+    const Rect& getRect(NodeId id) const { return nodes[id].rect; }
+    size_t getPassCount() const { return passes; }
+};
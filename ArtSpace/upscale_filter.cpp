@@ -0,0 +1,102 @@
+#include "upscale_filter.h"
+#include "render_target.h"
+#include "gl_extensions.h"
+#include "utility.h"
+#include <algorithm>
+
+// Fragment program only: the fixed-function stage still transforms the quad
+static const char* SHARPEN_SOURCE =
+    "uniform sampler2D source;\n"
+    "uniform vec2 texelSize;\n"
+    "uniform float sharpness;\n"
+    "void main() {\n"
+    "    vec2 uv = gl_TexCoord[0].xy;\n"
+    "    vec3 c = texture2D(source, uv).rgb;\n"
+    "    vec3 n = texture2D(source, uv + vec2(0.0, texelSize.y)).rgb;\n"
+    "    vec3 s = texture2D(source, uv - vec2(0.0, texelSize.y)).rgb;\n"
+    "    vec3 e = texture2D(source, uv + vec2(texelSize.x, 0.0)).rgb;\n"
+    "    vec3 w = texture2D(source, uv - vec2(texelSize.x, 0.0)).rgb;\n"
+    "    vec3 lo = min(c, min(min(n, s), min(e, w)));\n"
+    "    vec3 hi = max(c, max(max(n, s), max(e, w)));\n"
+    "    vec3 sharpened = c + (c - (n + s + e + w) * 0.25) * (sharpness * 2.0);\n"
+    "    gl_FragColor = vec4(clamp(sharpened, lo, hi), 1.0);\n"
+    "}\n";
+
+UpscaleFilter::UpscaleFilter()
+    : program(0)
+    , sourceLocation(-1)
+    , texelSizeLocation(-1)
+    , sharpnessLocation(-1)
+    , sharpness(0.0f) {
+}
+
+UpscaleFilter::~UpscaleFilter() {
+    shutdown();
+}
+
+bool UpscaleFilter::init() {
+    shutdown();
+    if (!glext.shaders) {
+        return false;
+    }
+
+    GLuint shader = glext.createShader(GL_FRAGMENT_SHADER);
+    glext.shaderSource(shader, 1, &SHARPEN_SOURCE, nullptr);
+    glext.compileShader(shader);
+
+    GLint status = 0;
+    char log[512] = "";
+    glext.getShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (!status) {
+        glext.getShaderInfoLog(shader, sizeof(log), nullptr, log);
+        Logger::getInstance().logWarning(std::string("UpscaleFilter - sharpening shader failed to compile: ") + log);
+        glext.deleteShader(shader);
+        return false;
+    }
+
+    program = glext.createProgram();
+    glext.attachShader(program, shader);
+    glext.linkProgram(program);
+    glext.deleteShader(shader);  // Freed with the program
+
+    glext.getProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status) {
+        glext.getProgramInfoLog(program, sizeof(log), nullptr, log);
+        Logger::getInstance().logWarning(std::string("UpscaleFilter - sharpening program failed to link: ") + log);
+        shutdown();
+        return false;
+    }
+
+    sourceLocation = glext.getUniformLocation(program, "source");
+    texelSizeLocation = glext.getUniformLocation(program, "texelSize");
+    sharpnessLocation = glext.getUniformLocation(program, "sharpness");
+    return true;
+}
+
+void UpscaleFilter::shutdown() {
+    if (program) {
+        glext.deleteProgram(program);
+        program = 0;
+    }
+}
+
+void UpscaleFilter::setSharpness(float amount) {
+    sharpness = std::max(0.0f, std::min(amount, 1.0f));
+}
+
+void UpscaleFilter::present(RenderTarget& target, int sourceWidth, int sourceHeight, int viewportWidth, int viewportHeight) {
+    // Nothing to recover at native resolution
+    bool sharpen = program && sharpness > 0.0f &&
+        (sourceWidth < viewportWidth || sourceHeight < viewportHeight);
+    if (!sharpen) {
+        target.present(viewportWidth, viewportHeight, sourceWidth, sourceHeight);
+        return;
+    }
+
+    glext.useProgram(program);
+    glext.uniform1i(sourceLocation, 0);
+    glext.uniform2f(texelSizeLocation, 1.0f / target.getWidth(), 1.0f / target.getHeight());
+    glext.uniform1f(sharpnessLocation, sharpness);
+    target.present(viewportWidth, viewportHeight, sourceWidth, sourceHeight);
+    glext.useProgram(0);
+}
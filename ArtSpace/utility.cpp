@@ -1,152 +1,88 @@
 #include <SFML/Graphics.hpp>
 #include "utility.h"
+#include "trace.h"
+#include "hitch_monitor.h"
+#include "profiler.h"
+#include "gl_extensions.h"
+#include "text_renderer.h"
+#include "ui_batch.h"
 #include <GL/glut.h>
 #include <cstdio>
 #include <iostream>
 #include <ctime>
-#include <iomanip>
-#include <sstream>  // For std::stringstream
+#include <algorithm>
 
-// Initialize static instance for Logger
-Logger Logger::instance;
+uint32_t UIComponent::layoutVersion = 0;
 
-// Logger implementation
-Logger::Logger()
-    : consoleLogging(false)
-    , fileLogging(false)
-    , logFilePath("artspace.log")
-    , minLevel(INFO) {
-}
-
-Logger::~Logger() {
-    if (logFile.is_open()) {
-        logFile.close();
-    }
-}
-
-Logger& Logger::getInstance() {
-    return instance;
-}
-
-void Logger::enableConsoleLogging(bool enable) {
-    consoleLogging = enable;
-}
-
-void Logger::enableFileLogging(bool enable, const std::string& filePath) {
-    fileLogging = enable;
-    logFilePath = filePath;
-
-    if (fileLogging && !logFile.is_open()) {
-        logFile.open(logFilePath, std::ios::out | std::ios::app);
-        if (!logFile.is_open()) {
-            // Failed to open log file
-            consoleLogging = true; // Fallback to console logging
-            logError("Failed to open log file: " + logFilePath);
-        }
-    }
-    else if (!fileLogging && logFile.is_open()) {
-        logFile.close();
-    }
-}
-
-void Logger::setMinimumLogLevel(LogLevel level) {
-    minLevel = level;
-}
-
-void Logger::logInfo(const std::string& message) {
-    log(INFO, message);
-}
-
-void Logger::logWarning(const std::string& message) {
-    log(WARNING, message);
-}
-
-void Logger::logError(const std::string& message) {
-    log(ERROR_, message);
-}
-
-void Logger::logDebug(const std::string& message) {
-    log(DEBUG, message);
-}
-
-void Logger::log(LogLevel level, const std::string& message) {
-    if (level < minLevel) {
-        return; // Skip messages below minimum level
-    }
-
-    // Get current time
-    std::time_t now = std::time(nullptr);
-    struct tm timeInfo;
-    localtime_s(&timeInfo, &now);
-
-    std::stringstream logStream;
-    logStream << "["
-        << std::setfill('0') << std::setw(2) << timeInfo.tm_hour << ":"
-        << std::setfill('0') << std::setw(2) << timeInfo.tm_min << ":"
-        << std::setfill('0') << std::setw(2) << timeInfo.tm_sec << "] ";
-
-    // Add level prefix
-    switch (level) {
-    case INFO:    logStream << "[INFO] "; break;
-    case WARNING: logStream << "[WARN] "; break;
-    case DEBUG:   logStream << "[DEBUG] "; break;
-    case ERROR_:  logStream << "[ERROR] "; break;
-    }
-
-    logStream << message;
-
-    if (consoleLogging) {
-        std::cout << logStream.str() << std::endl;
-    }
-
-    if (fileLogging && logFile.is_open()) {
-        logFile << logStream.str() << std::endl;
-        logFile.flush();
-    }
-}
+int Image::maxTextureSize = 0;
+float Image::mipBias = 0.0f;
+unsigned int Image::qualityVersion = 1;
 
 // UIComponent implementation
 UIComponent::UIComponent()
     : position{ 0, 0 }
     , size{ 100, 50 }
     , isVisible(true)
-    , alpha(1.0f) {
+    , alpha(1.0f)
+    , dirty(true) {
+}
+
+void UIComponent::render() {
+    if (!isVisible) return;
+
+    // Shared by every component drawn on its own; only used on the render thread
+    static UIBatch batch;
+    batch.clear();
+    appendGeometry(batch);
+    batch.draw();
+}
+
+void UIComponent::appendGeometry(UIBatch& batch) {
+    batch.addCustom([this]() { render(); });
 }
 
 void UIComponent::setPosition(float x, float y) {
+    if (position[0] == x && position[1] == y) return;
     position[0] = x;
     position[1] = y;
+    dirty = true;
+    layoutVersion++;
 }
 
 void UIComponent::setSize(float width, float height) {
+    if (size[0] == width && size[1] == height) return;
     size[0] = width;
     size[1] = height;
+    dirty = true;
+    layoutVersion++;
 }
 
 void UIComponent::setVisible(bool visible) {
+    if (isVisible == visible) return;
     isVisible = visible;
+    dirty = true;
+    layoutVersion++;
 }
 
 void UIComponent::setAlpha(float a) {
+    a = std::min(std::max(a, 0.0f), 1.0f);
+    if (alpha == a) return;
     alpha = a;
-    if (alpha < 0.0f) alpha = 0.0f;
-    if (alpha > 1.0f) alpha = 1.0f;
+    dirty = true;
 }
 
 bool UIComponent::isPointInside(float x, float y) const {
     return (x >= position[0] && x <= position[0] + size[0] &&
-        y >= position[1] && y <= position[1] + size[0]);
+        y >= position[1] && y <= position[1] + size[1]);
 }
 
 // Text rendering implementations
 void calculateTextPosition(float boxX, float boxY, float boxWidth, float boxHeight,
     const std::string& text, TextAlignment alignment,
     float& outX, float& outY) {
-    // Calculate text width using GLUT
-    int textWidth = 0;
-    for (char c : text) {
-        textWidth += glutBitmapWidth(GLUT_BITMAP_HELVETICA_12, c);
-    }
+    // Cached per string by the text renderer
+    TextRenderer& textRenderer = TextRenderer::getInstance();
+    float textWidth = textRenderer.measure(text);
 
     // Calculate x position based on alignment
     switch (alignment) {
@@ -161,26 +97,13 @@ void calculateTextPosition(float boxX, float boxY, float boxWidth, float boxHeig
         break;
     }
 
-    // Calculate y position (vertically centered)
-    outY = boxY + (boxHeight - 12) / 2; // Assuming font height of 12 pixels
+    // Calculate y position (capital letters vertically centered on the baseline)
+    outY = boxY + (boxHeight - textRenderer.getCapHeight()) / 2;
 }
 
 void renderText(float x, float y, const std::string& text, float* color) {
-    glPushAttrib(GL_CURRENT_BIT); // Save current color
-
-    if (color) {
-        glColor4f(color[0], color[1], color[2], color[3]);
-    }
-    else {
-        glColor4f(1.0f, 1.0f, 1.0f, 1.0f); // Default: white
-    }
-
-    glRasterPos2f(x, y);
-    for (char c : text) {
-        glutBitmapCharacter(GLUT_BITMAP_HELVETICA_12, c);
-    }
-
-    glPopAttrib(); // Restore previous color
+    // Queued; drawn with the rest of the text when the UI pass flushes
+    TextRenderer::getInstance().draw(x, y, text, color);
 }
 
 void renderText(float boxX, float boxY, float boxWidth, float boxHeight,
@@ -190,6 +113,42 @@ void renderText(float boxX, float boxY, float boxWidth, float boxHeight,
     renderText(x, y, text, color);
 }
 
+void beginScreenSpace(int width, int height) {
+    glPushAttrib(GL_ENABLE_BIT | GL_CURRENT_BIT | GL_COLOR_BUFFER_BIT);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_LIGHTING);
+    glDisable(GL_TEXTURE_2D);
+    glEnable(GL_BLEND);
+    setUIBlendFunc();
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, width, 0, height, -1, 1);
+
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+}
+
+void setUIBlendFunc() {
+    if (glext.separateBlend) {
+        glext.blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    }
+    else {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    }
+}
+
+void endScreenSpace() {
+    TextRenderer::getInstance().flush();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+    glPopAttrib();
+}
+
 // Button implementation
 Button::Button(const std::string& buttonText)
     : text(buttonText)
@@ -212,26 +171,16 @@ Button::Button(const std::string& buttonText)
     hoverColor[3] = 0.8f;
 }
 
-void Button::render() {
+void Button::appendGeometry(UIBatch& batch) {
     if (!isVisible) return;
 
-    // Draw button background
-    glBegin(GL_QUADS);
-    if (isHovered) {
-        glColor4f(hoverColor[0], hoverColor[1], hoverColor[2], hoverColor[3] * alpha);
-    }
-    else {
-        glColor4f(backgroundColor[0], backgroundColor[1], backgroundColor[2], backgroundColor[3] * alpha);
-    }
-
-    glVertex2f(position[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1] + size[1]);
-    glVertex2f(position[0], position[1] + size[1]);
-    glEnd();
+    // Button background
+    batch.addRect(position[0], position[1], size[0], size[1], isHovered ? hoverColor : backgroundColor, alpha);
 
-    // Draw button text
-    renderText(position[0], position[1], size[0], size[1], text, TextAlignment::MidMid, textColor);
+    // Button text
+    float textX, textY;
+    calculateTextPosition(position[0], position[1], size[0], size[1], text, TextAlignment::MidMid, textX, textY);
+    batch.addText(textX, textY, text, textColor, alpha);
 }
 
 void Button::update(float deltaTime) {
@@ -239,7 +188,9 @@ void Button::update(float deltaTime) {
 }
 
 void Button::setText(const std::string& buttonText) {
+    if (text == buttonText) return;
     text = buttonText;
+    markDirty();
 }
 
 void Button::setOnClick(const std::function<void()>& callback) {
@@ -251,6 +202,7 @@ void Button::setTextColor(float r, float g, float b, float a) {
     textColor[1] = g;
     textColor[2] = b;
     textColor[3] = a;
+    markDirty();
 }
 
 void Button::setBackgroundColor(float r, float g, float b, float a) {
@@ -258,6 +210,7 @@ void Button::setBackgroundColor(float r, float g, float b, float a) {
     backgroundColor[1] = g;
     backgroundColor[2] = b;
     backgroundColor[3] = a;
+    markDirty();
 }
 
 void Button::setHoverColor(float r, float g, float b, float a) {
@@ -265,17 +218,13 @@ void Button::setHoverColor(float r, float g, float b, float a) {
     hoverColor[1] = g;
     hoverColor[2] = b;
     hoverColor[3] = a;
+    markDirty();
 }
 
-bool Button::handleMouseEvent(int button, int state, int x, int y) {
-    // Flip y-coordinate (GLUT has origin at top-left, we use bottom-left)
-    y = glutGet(GLUT_WINDOW_HEIGHT) - y;
-
+bool Button::handleMouseEvent(int button, int state, float x, float y) {
     if (!isVisible) return false;
 
-    // Check if mouse is inside the button
-    bool inside = x >= position[0] && x <= position[0] + size[0] &&
-        y >= position[1] && y <= position[1] + size[1];
+    bool inside = isPointInside(x, y);
 
     if (inside) {
         if (button == GLUT_LEFT_BUTTON) {
@@ -298,21 +247,25 @@ bool Button::handleMouseEvent(int button, int state, int x, int y) {
     return inside;
 }
 
-bool Button::handleMouseMove(int x, int y) {
-    // Flip y-coordinate
-    y = glutGet(GLUT_WINDOW_HEIGHT) - y;
-
+bool Button::handleMouseMove(float x, float y) {
     if (!isVisible) return false;
 
-    // Check if mouse is inside the button
-    bool inside = x >= position[0] && x <= position[0] + size[0] &&
-        y >= position[1] && y <= position[1] + size[1];
-
-    isHovered = inside;
+    bool inside = isPointInside(x, y);
+    if (isHovered != inside) {
+        isHovered = inside;
+        markDirty();
+    }
 
     return inside;
 }
 
+void Button::handleMouseLeave() {
+    if (isHovered) {
+        isHovered = false;
+        markDirty();
+    }
+}
+
 // TextBox implementation
 TextBox::TextBox(const std::string& initialText, const std::string& placeholderText)
     : text(initialText)
@@ -343,30 +296,18 @@ TextBox::TextBox(const std::string& initialText, const std::string& placeholderT
     }
 }
 
-void TextBox::render() {
+void TextBox::appendGeometry(UIBatch& batch) {
     if (!isVisible) return;
 
-    // Draw background
-    glBegin(GL_QUADS);
-    glColor4f(backgroundColor[0], backgroundColor[1], backgroundColor[2], backgroundColor[3] * alpha);
-    glVertex2f(position[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1] + size[1]);
-    glVertex2f(position[0], position[1] + size[1]);
-    glEnd();
-
-    // Draw border
-    glBegin(GL_LINE_LOOP);
-    glColor4f(borderColor[0], borderColor[1], borderColor[2], borderColor[3] * alpha);
-    glVertex2f(position[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1] + size[1]);
-    glVertex2f(position[0], position[1] + size[1]);
-    glEnd();
-
-    // Draw text or placeholder
+    // Background and border
+    batch.addRect(position[0], position[1], size[0], size[1], backgroundColor, alpha);
+    batch.addOutline(position[0], position[1], size[0], size[1], 1.0f, borderColor, alpha);
+
+    // Text or placeholder
+    float textX, textY;
     if (!text.empty()) {
-        renderText(position[0] + 5, position[1], size[0] - 10, size[1], text, TextAlignment::MidLeft, textColor);
+        calculateTextPosition(position[0] + 5, position[1], size[0] - 10, size[1], text, TextAlignment::MidLeft, textX, textY);
+        batch.addText(textX, textY, text, textColor, alpha);
     }
     else if (!placeholder.empty() && !hasFocus) {
         float placeholderColor[4] = {
@@ -375,23 +316,14 @@ void TextBox::render() {
             textColor[2] * 0.7f,
             textColor[3] * 0.7f
         };
-        renderText(position[0] + 5, position[1], size[0] - 10, size[1], placeholder, TextAlignment::MidLeft, placeholderColor);
+        calculateTextPosition(position[0] + 5, position[1], size[0] - 10, size[1], placeholder, TextAlignment::MidLeft, textX, textY);
+        batch.addText(textX, textY, placeholder, placeholderColor, alpha);
     }
 
-    // Draw cursor if focused
+    // Cursor if focused
     if (hasFocus && isEditable && showCursor) {
-        // Calculate cursor position
-        int cursorX = position[0] + 5; // Start padding
-        for (int i = 0; i < cursorPosition; i++) {
-            cursorX += glutBitmapWidth(GLUT_BITMAP_HELVETICA_12, text[i]);
-        }
-
-        // Draw cursor
-        glBegin(GL_LINES);
-        glColor4f(textColor[0], textColor[1], textColor[2], textColor[3] * alpha);
-        glVertex2f(cursorX, position[1] + 5);
-        glVertex2f(cursorX, position[1] + size[1] - 5);
-        glEnd();
+        float cursorX = position[0] + 5 + TextRenderer::getInstance().getCaretOffset(text, cursorPosition);
+        batch.addRect(cursorX, position[1] + 5, 1.0f, size[1] - 10, textColor, alpha);
     }
 }
 
@@ -401,18 +333,40 @@ void TextBox::update(float deltaTime) {
         if (cursorBlinkTime > 0.5f) {
             cursorBlinkTime = 0;
             showCursor = !showCursor;
+            markDirty();
         }
     }
-    else {
+    else if (showCursor) {
         showCursor = false;
+        markDirty();
     }
 }
 
 void TextBox::setText(const std::string& newText) {
+    if (text == newText) return;
     text = newText;
     if (cursorPosition > text.length()) {
         cursorPosition = text.length();
     }
+    markDirty();
+}
+
+void TextBox::setOnSubmit(const std::function<void(const std::string&)>& callback) {
+    onSubmit = callback;
+}
+
+void TextBox::setOnChange(const std::function<void(const std::string&)>& callback) {
+    onChange = callback;
+}
+
+void TextBox::setFocus(bool focus) {
+    hasFocus = focus;
+    markDirty();
+    if (focus) {
+        cursorPosition = text.length();
+        cursorBlinkTime = 0;
+        showCursor = true;
+    }
 }
 
 const std::string& TextBox::getText() const {
@@ -421,10 +375,12 @@ const std::string& TextBox::getText() const {
 
 void TextBox::setPlaceholder(const std::string& newPlaceholder) {
     placeholder = newPlaceholder;
+    markDirty();
 }
 
 void TextBox::setEditable(bool editable) {
     isEditable = editable;
+    markDirty();
 }
 
 void TextBox::setTextColor(float r, float g, float b, float a) {
@@ -432,6 +388,7 @@ void TextBox::setTextColor(float r, float g, float b, float a) {
     textColor[1] = g;
     textColor[2] = b;
     textColor[3] = a;
+    markDirty();
 }
 
 void TextBox::setBackgroundColor(float r, float g, float b, float a) {
@@ -439,6 +396,7 @@ void TextBox::setBackgroundColor(float r, float g, float b, float a) {
     backgroundColor[1] = g;
     backgroundColor[2] = b;
     backgroundColor[3] = a;
+    markDirty();
 }
 
 void TextBox::setBorderColor(float r, float g, float b, float a) {
@@ -446,6 +404,7 @@ void TextBox::setBorderColor(float r, float g, float b, float a) {
     borderColor[1] = g;
     borderColor[2] = b;
     borderColor[3] = a;
+    markDirty();
 }
 
 bool TextBox::handleKeyEvent(unsigned char key) {
@@ -457,12 +416,13 @@ bool TextBox::handleKeyEvent(unsigned char key) {
         if (cursorPosition > 0) {
             text.erase(cursorPosition - 1, 1);
             cursorPosition--;
+            if (onChange) onChange(text);
         }
         break;
 
     case 13: // Enter
-        // Just lose focus for now
         hasFocus = false;
+        if (onSubmit) onSubmit(text);
         break;
 
     case 27: // Escape
@@ -474,6 +434,7 @@ bool TextBox::handleKeyEvent(unsigned char key) {
         if (key >= 32 && key <= 126) {
             text.insert(cursorPosition, 1, key);
             cursorPosition++;
+            if (onChange) onChange(text);
         }
         break;
     }
@@ -481,37 +442,24 @@ bool TextBox::handleKeyEvent(unsigned char key) {
     // Reset cursor blink
     cursorBlinkTime = 0;
     showCursor = true;
+    markDirty();
 
     return true;
 }
 
-bool TextBox::handleMouseEvent(int button, int state, int x, int y) {
-    // Flip y-coordinate
-    y = glutGet(GLUT_WINDOW_HEIGHT) - y;
-
+bool TextBox::handleMouseEvent(int button, int state, float x, float y) {
     if (!isVisible) return false;
 
-    // Check if mouse is inside the text box
-    bool inside = x >= position[0] && x <= position[0] + size[0] &&
-        y >= position[1] && y <= position[1] + size[1];
+    bool inside = isPointInside(x, y);
 
     if (inside && button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
         hasFocus = true;
+        markDirty();
 
         // Set cursor position based on click position
         if (isEditable) {
-            int clickX = x - (position[0] + 5); // Adjust for padding
-            if (clickX <= 0) {
-                cursorPosition = 0;
-            }
-            else {
-                // Find the closest character to the click position
-                int textWidth = 0;
-                for (cursorPosition = 0; cursorPosition < text.length(); cursorPosition++) {
-                    textWidth += glutBitmapWidth(GLUT_BITMAP_HELVETICA_12, text[cursorPosition]);
-                    if (textWidth >= clickX) break;
-                }
-            }
+            float clickX = x - (position[0] + 5); // Adjust for padding
+            cursorPosition = static_cast<int>(TextRenderer::getInstance().getCaretIndex(text, clickX));
 
             // Reset cursor blink
             cursorBlinkTime = 0;
@@ -522,7 +470,10 @@ bool TextBox::handleMouseEvent(int button, int state, int x, int y) {
     }
     else if (button == GLUT_LEFT_BUTTON && state == GLUT_DOWN) {
         // Click outside the text box
-        hasFocus = false;
+        if (hasFocus) {
+            hasFocus = false;
+            markDirty();
+        }
         return false;
     }
 
@@ -532,7 +483,8 @@ bool TextBox::handleMouseEvent(int button, int state, int x, int y) {
 // Timer implementation
 Timer::Timer()
     : currentTime(0)
-    , isRunning(false) {
+    , isRunning(false)
+    , displayedHundredths(-1) {
     // Default text color: white
     textColor[0] = 1.0f;
     textColor[1] = 1.0f;
@@ -562,12 +514,13 @@ void Timer::update(float deltaTime) {
     }
 }
 
-void Timer::render() {
+void Timer::appendGeometry(UIBatch& batch) {
     if (!isVisible) return;
 
-    // Just render the time text
-    renderText(position[0], position[1], size[0], size[1],
-        timeText, TextAlignment::MidMid, textColor);
+    // Just the time text
+    float textX, textY;
+    calculateTextPosition(position[0], position[1], size[0], size[1], timeText, TextAlignment::MidMid, textX, textY);
+    batch.addText(textX, textY, timeText, textColor, alpha);
 }
 
 float Timer::getTime() const {
@@ -579,19 +532,19 @@ void Timer::setTextColor(float r, float g, float b, float a) {
     textColor[1] = g;
     textColor[2] = b;
     textColor[3] = a;
+    markDirty();
 }
 
 void Timer::updateTimeText() {
-    int minutes = static_cast<int>(currentTime) / 60;
-    int seconds = static_cast<int>(currentTime) % 60;
-    int millisecs = static_cast<int>((currentTime - static_cast<int>(currentTime)) * 100);
-
-    std::stringstream ss;
-    ss << std::setfill('0') << std::setw(2) << minutes << ":"
-        << std::setfill('0') << std::setw(2) << seconds << "."
-        << std::setfill('0') << std::setw(2) << millisecs;
+    // The text only changes when the hundredths shown do
+    int hundredths = static_cast<int>(currentTime * 100);
+    if (hundredths == displayedHundredths) return;
+    displayedHundredths = hundredths;
 
-    timeText = ss.str();
+    char formatted[16];
+    snprintf(formatted, sizeof(formatted), "%02d:%02d.%02d", hundredths / 6000, (hundredths / 100) % 60, hundredths % 100);
+    timeText.assign(formatted);
+    markDirty();
 }
 
 // Image implementation
@@ -599,7 +552,9 @@ Image::Image(const std::string& imagePath, const std::string& fallbackColorHex)
     : textureId(0)
     , preserveAspectRatio(true)
     , imageLoaded(false)
-    , useFallback(false) {
+    , useFallback(false)
+    , mipmapped(false)
+    , appliedQualityVersion(0) {
     // Set default tint (white, no tint)
     tint[0] = 1.0f;
     tint[1] = 1.0f;
@@ -609,16 +564,19 @@ Image::Image(const std::string& imagePath, const std::string& fallbackColorHex)
     // Set default fallback color (white)
     setFallbackColor(fallbackColorHex);
 
-    // Try to load the image
-    if (!loadImage(imagePath)) {
+    // Try to load the image (an empty path means start out with the fallback color)
+    if (imagePath.empty()) {
+        useFallback = !fallbackColorHex.empty();
+    }
+    else if (!loadImage(imagePath)) {
         if (fallbackColorHex.empty()) {
             // No fallback color specified and image load failed
-            Logger::getInstance().logError("Failed to load image: " + imagePath + " and no fallback color specified");
+            LOG_ERROR("Failed to load image: {} and no fallback color specified", imagePath);
         }
         else {
             // Use fallback color
             useFallback = true;
-            Logger::getInstance().logWarning("Using fallback color for failed image: " + imagePath);
+            LOG_WARN("Using fallback color for failed image: {}", imagePath);
         }
     }
 }
@@ -633,13 +591,39 @@ bool Image::loadImage(const std::string& imagePath) {
     // Reset status
     imageLoaded = false;
     useFallback = false;
+    markDirty();
 
     // Load the image using SFML
-    if (!sfImage.loadFromFile(imagePath)) {
-        Logger::getInstance().logWarning("Failed to load image: " + imagePath);
+    sf::Image decoded;
+    bool decodedOk;
+    uint64_t decodeStart = Profiler::now();
+    {
+        TRACE_SCOPE_DETAIL("Image decode", imagePath);
+        decodedOk = decoded.loadFromFile(imagePath);
+    }
+    HitchMonitor::getInstance().noteEvent("asset", "Decoded " + imagePath + " in " +
+        std::to_string((Profiler::now() - decodeStart) / 1000) + " us");
+    if (!decodedOk) {
+        LOG_WARN("Failed to load image: {}", imagePath);
         return false;
     }
 
+    if (!setImageData(decoded)) {
+        return false;
+    }
+
+    LOG_INFO("Loaded image: {} - {}x{}", imagePath, sfImage.getSize().x, sfImage.getSize().y);
+
+    return true;
+}
+
+bool Image::setImageData(const sf::Image& image) {
+    TRACE_SCOPE("GL upload");
+    imageLoaded = false;
+    useFallback = false;
+    markDirty();
+    sfImage = image;
+
     // Flip image for OpenGL
     sfImage.flipVertically();
 
@@ -655,8 +639,17 @@ bool Image::loadImage(const std::string& imagePath) {
     glGenTextures(1, &textureId);
     glBindTexture(GL_TEXTURE_2D, textureId);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    // Let the driver build the mip chain so quality tiers can pick a smaller level
+    mipmapped = glext.textureLevels;
+    if (mipmapped) {
+        glTexParameteri(GL_TEXTURE_2D, GL_GENERATE_MIPMAP, GL_TRUE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    }
+    else {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    appliedQualityVersion = 0;
 
     // Upload texture data directly from SFML image
     glTexImage2D(
@@ -674,86 +667,61 @@ bool Image::loadImage(const std::string& imagePath) {
     // Check for OpenGL errors
     GLenum err = glGetError();
     if (err != GL_NO_ERROR) {
-        Logger::getInstance().logError("OpenGL error loading texture: " + std::to_string(err));
+        LOG_ERROR("OpenGL error loading texture: {:#x}", err);
         return false;
     }
 
     imageLoaded = true;
-    useFallback = false;
+    return true;
+}
 
-    Logger::getInstance().logInfo("Loaded image: " + imagePath + " - " +
-        std::to_string(sfImage.getSize().x) + "x" +
-        std::to_string(sfImage.getSize().y));
+void Image::getDrawRect(float& x, float& y, float& width, float& height) const {
+    x = position[0];
+    y = position[1];
+    width = size[0];
+    height = size[1];
+    if (!preserveAspectRatio || sfImage.getSize().x == 0 || sfImage.getSize().y == 0) return;
 
-    return true;
+    float imageAspect = static_cast<float>(sfImage.getSize().x) / sfImage.getSize().y;
+    float boxAspect = width / height;
+    if (imageAspect > boxAspect) {
+        // Image is wider than box
+        float newHeight = width / imageAspect;
+        y += (height - newHeight) / 2;
+        height = newHeight;
+    }
+    else {
+        // Image is taller than box
+        float newWidth = height * imageAspect;
+        x += (width - newWidth) / 2;
+        width = newWidth;
+    }
 }
 
 void Image::render() {
     if (!isVisible) return;
 
-    float w = size[0];
-    float h = size[1];
-
     if (imageLoaded && !useFallback) {
-        // Adjust dimensions if preserving aspect ratio
-        if (preserveAspectRatio && sfImage.getSize().x > 0 && sfImage.getSize().y > 0) {
-            float imageAspect = static_cast<float>(sfImage.getSize().x) / sfImage.getSize().y;
-            float boxAspect = w / h;
-            float tempX = position[0];
-            float tempY = position[1];
-
-            if (imageAspect > boxAspect) {
-                // Image is wider than box
-                float newHeight = w / imageAspect;
-                float offsetY = (h - newHeight) / 2;
-                h = newHeight;
-                tempY += offsetY;
-            }
-            else {
-                // Image is taller than box
-                float newWidth = h * imageAspect;
-                float offsetX = (w - newWidth) / 2;
-                w = newWidth;
-                tempX += offsetX;
-            }
+        float x, y, w, h;
+        getDrawRect(x, y, w, h);
 
-            // Enable texturing
-            glEnable(GL_TEXTURE_2D);
-            glBindTexture(GL_TEXTURE_2D, textureId);
+        // Enable texturing
+        glEnable(GL_TEXTURE_2D);
+        bindTexture();
 
-            // Apply tint color
-            glColor4f(tint[0], tint[1], tint[2], tint[3] * alpha);
+        // Apply tint color
+        glColor4f(tint[0], tint[1], tint[2], tint[3] * alpha);
 
-            // Draw textured quad
-            glBegin(GL_QUADS);
-            glTexCoord2f(0, 0); glVertex2f(tempX, tempY);
-            glTexCoord2f(1, 0); glVertex2f(tempX + w, tempY);
-            glTexCoord2f(1, 1); glVertex2f(tempX + w, tempY + h);
-            glTexCoord2f(0, 1); glVertex2f(tempX, tempY + h);
-            glEnd();
+        // Draw textured quad
+        glBegin(GL_QUADS);
+        glTexCoord2f(0, 0); glVertex2f(x, y);
+        glTexCoord2f(1, 0); glVertex2f(x + w, y);
+        glTexCoord2f(1, 1); glVertex2f(x + w, y + h);
+        glTexCoord2f(0, 1); glVertex2f(x, y + h);
+        glEnd();
 
-            // Restore state
-            glDisable(GL_TEXTURE_2D);
-        }
-        else {
-            // No aspect ratio preservation
-            glEnable(GL_TEXTURE_2D);
-            glBindTexture(GL_TEXTURE_2D, textureId);
-
-            // Apply tint color
-            glColor4f(tint[0], tint[1], tint[2], tint[3] * alpha);
-
-            // Draw textured quad
-            glBegin(GL_QUADS);
-            glTexCoord2f(0, 0); glVertex2f(position[0], position[1]);
-            glTexCoord2f(1, 0); glVertex2f(position[0] + w, position[1]);
-            glTexCoord2f(1, 1); glVertex2f(position[0] + w, position[1] + h);
-            glTexCoord2f(0, 1); glVertex2f(position[0], position[1] + h);
-            glEnd();
-
-            // Restore state
-            glDisable(GL_TEXTURE_2D);
-        }
+        // Restore state
+        glDisable(GL_TEXTURE_2D);
     }
     else if (useFallback) {
         // Render a solid rectangle with the fallback color
@@ -761,22 +729,61 @@ void Image::render() {
 
         glBegin(GL_QUADS);
         glVertex2f(position[0], position[1]);
-        glVertex2f(position[0] + w, position[1]);
-        glVertex2f(position[0] + w, position[1] + h);
-        glVertex2f(position[0], position[1] + h);
+        glVertex2f(position[0] + size[0], position[1]);
+        glVertex2f(position[0] + size[0], position[1] + size[1]);
+        glVertex2f(position[0], position[1] + size[1]);
         glEnd();
     }
 }
 
+void Image::appendGeometry(UIBatch& batch) {
+    if (!isVisible) return;
+
+    if (imageLoaded && !useFallback) {
+        float x, y, w, h;
+        getDrawRect(x, y, w, h);
+        batch.addImage(this, x, y, w, h, tint, alpha);
+    }
+    else if (useFallback) {
+        batch.addRect(position[0], position[1], size[0], size[1], fallbackColor, alpha);
+    }
+}
+
+void Image::bindTexture() {
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    if (!mipmapped || appliedQualityVersion == qualityVersion) return;
+    appliedQualityVersion = qualityVersion;
+
+    // Skip the levels larger than the size limit
+    int level = 0;
+    if (maxTextureSize > 0) {
+        unsigned int largest = std::max(sfImage.getSize().x, sfImage.getSize().y);
+        while ((largest >> level) > static_cast<unsigned int>(maxTextureSize) && (largest >> (level + 1)) > 0) {
+            level++;
+        }
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level);
+    glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_LOD_BIAS, mipBias);
+}
+
+void Image::setTextureQuality(int maxSize, float lodBias) {
+    if (maxSize == maxTextureSize && lodBias == mipBias) return;
+    maxTextureSize = maxSize;
+    mipBias = lodBias;
+    qualityVersion++;
+}
+
 void Image::setTint(float r, float g, float b, float a) {
     tint[0] = r;
     tint[1] = g;
     tint[2] = b;
     tint[3] = a;
+    markDirty();
 }
 
 void Image::setPreserveAspectRatio(bool preserve) {
     preserveAspectRatio = preserve;
+    markDirty();
 }
 
 void Image::setFallbackColor(float r, float g, float b, float a) {
@@ -784,12 +791,14 @@ void Image::setFallbackColor(float r, float g, float b, float a) {
     fallbackColor[1] = g;
     fallbackColor[2] = b;
     fallbackColor[3] = a;
+    markDirty();
 }
 
 void Image::setFallbackColor(const std::string& hexColor) {
     if (hexColor.empty()) {
         // No fallback color
         useFallback = false;
+        markDirty();
         return;
     }
 
@@ -861,32 +870,16 @@ BorderBox::~BorderBox() {
     // BorderBox doesn't own the content, so don't delete it
 }
 
-void BorderBox::render() {
+void BorderBox::appendGeometry(UIBatch& batch) {
     if (!isVisible) return;
 
-    // Draw background
-    glBegin(GL_QUADS);
-    glColor4f(backgroundColor[0], backgroundColor[1], backgroundColor[2], backgroundColor[3] * alpha);
-    glVertex2f(position[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1] + size[1]);
-    glVertex2f(position[0], position[1] + size[1]);
-    glEnd();
-
-    // Draw border
-    glLineWidth(borderWidth);
-    glBegin(GL_LINE_LOOP);
-    glColor4f(borderColor[0], borderColor[1], borderColor[2], borderColor[3] * alpha);
-    glVertex2f(position[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1]);
-    glVertex2f(position[0] + size[0], position[1] + size[1]);
-    glVertex2f(position[0], position[1] + size[1]);
-    glEnd();
-    glLineWidth(1.0f); // Reset line width
-
-    // Render content
+    // Background and border (a solid frame, so no line width change)
+    batch.addRect(position[0], position[1], size[0], size[1], backgroundColor, alpha);
+    batch.addOutline(position[0], position[1], size[0], size[1], borderWidth, borderColor, alpha);
+
+    // Content
     if (content && content->getVisible()) {
-        content->render();
+        content->appendGeometry(batch);
     }
 }
 
@@ -896,9 +889,21 @@ void BorderBox::update(float deltaTime) {
     }
 }
 
+bool BorderBox::isDirty() const {
+    return dirty || (content && content->isDirty());
+}
+
+void BorderBox::clearDirty() {
+    dirty = false;
+    if (content) {
+        content->clearDirty();
+    }
+}
+
 void BorderBox::setContent(UIComponent* component) {
     content = component;
     updateContentPosition();
+    markDirty();
 }
 
 void BorderBox::updateContentPosition() {
@@ -912,8 +917,9 @@ void BorderBox::updateContentPosition() {
 }
 
 void BorderBox::setBorderWidth(float width) {
+    // The content stays centered, so only the border itself changes
     borderWidth = width;
-    updateContentPosition();
+    markDirty();
 }
 
 void BorderBox::setBorderColor(float r, float g, float b, float a) {
@@ -921,6 +927,7 @@ void BorderBox::setBorderColor(float r, float g, float b, float a) {
     borderColor[1] = g;
     borderColor[2] = b;
     borderColor[3] = a;
+    markDirty();
 }
 
 void BorderBox::setBackgroundColor(float r, float g, float b, float a) {
@@ -928,97 +935,48 @@ void BorderBox::setBackgroundColor(float r, float g, float b, float a) {
     backgroundColor[1] = g;
     backgroundColor[2] = b;
     backgroundColor[3] = a;
+    markDirty();
 }
 
 void BorderBox::setPosition(float x, float y) {
-    position[0] = x;
-    position[1] = y;
+    if (position[0] == x && position[1] == y) return;
+    UIComponent::setPosition(x, y);
     updateContentPosition();
 }
 
 void BorderBox::setSize(float width, float height) {
-    size[0] = width;
-    size[1] = height;
+    if (size[0] == width && size[1] == height) return;
+    UIComponent::setSize(width, height);
     updateContentPosition();
 }
 
-bool BorderBox::handleMouseEvent(int button, int state, int x, int y) {
-    // Flip y-coordinate
-    y = glutGet(GLUT_WINDOW_HEIGHT) - y;
-
+bool BorderBox::handleMouseEvent(int button, int state, float x, float y) {
     if (!isVisible) return false;
 
-    // Check if mouse is inside
-    bool inside = x >= position[0] && x <= position[0] + size[0] &&
-        y >= position[1] && y <= position[1] + size[1];
-
-    // If inside and we have content, forward the event
-    if (inside && content) {
-        // Check if content can handle mouse events
-        Button* buttonContent = dynamic_cast<Button*>(content);
-        if (buttonContent) {
-            return buttonContent->handleMouseEvent(button, state, x, y);
-        }
-
-        TextBox* textboxContent = dynamic_cast<TextBox*>(content);
-        if (textboxContent) {
-            return textboxContent->handleMouseEvent(button, state, x, y);
-        }
-
-        // Try another BorderBox
-        BorderBox* borderboxContent = dynamic_cast<BorderBox*>(content);
-        if (borderboxContent) {
-            return borderboxContent->handleMouseEvent(button, state, x, y);
-        }
+    // Clicks outside are forwarded too, so focused content can let go
+    if (content && content->handleMouseEvent(button, state, x, y)) {
+        return true;
     }
-
-    return inside;
+    return isPointInside(x, y);
 }
 
 bool BorderBox::handleKeyEvent(unsigned char key) {
-    if (!isVisible) return false;
-
-    // Forward to content if possible
-    if (content) {
-        TextBox* textboxContent = dynamic_cast<TextBox*>(content);
-        if (textboxContent) {
-            return textboxContent->handleKeyEvent(key);
-        }
-
-        // Try another BorderBox
-        BorderBox* borderboxContent = dynamic_cast<BorderBox*>(content);
-        if (borderboxContent) {
-            return borderboxContent->handleKeyEvent(key);
-        }
-    }
-
-    return false;
+    if (!isVisible || !content) return false;
+    return content->handleKeyEvent(key);
 }
 
-bool BorderBox::handleMouseMove(int x, int y) {
-    // Flip y-coordinate
-    y = glutGet(GLUT_WINDOW_HEIGHT) - y;
-
+bool BorderBox::handleMouseMove(float x, float y) {
     if (!isVisible) return false;
 
-    // Check if mouse is inside
-    bool inside = x >= position[0] && x <= position[0] + size[0] &&
-        y >= position[1] && y <= position[1] + size[1];
-
-    // If inside and we have content, forward the event
+    bool inside = isPointInside(x, y);
     if (inside && content) {
-        // Check if content can handle mouse move
-        Button* buttonContent = dynamic_cast<Button*>(content);
-        if (buttonContent) {
-            return buttonContent->handleMouseMove(x, y);
-        }
-
-        // Try another BorderBox
-        BorderBox* borderboxContent = dynamic_cast<BorderBox*>(content);
-        if (borderboxContent) {
-            return borderboxContent->handleMouseMove(x, y);
-        }
+        return content->handleMouseMove(x, y);
     }
-
     return inside;
 }
+
+void BorderBox::handleMouseLeave() {
+    if (content) {
+        content->handleMouseLeave();
+    }
+}
@@ -7,7 +7,8 @@
  * and a complete UI component hierarchy.
  *
  * Main classes:
- * - Logger: Singleton class for centralized application logging
+ * - Logger: Singleton class for centralized application logging (logger.h)
+ * - renderText/calculateTextPosition: label drawing through TextRenderer (text_renderer.h)
  * - UIComponent: Base class for all UI elements with common functionality
  * - Image: Displays images with optional tinting and aspect ratio preservation
  * - BorderBox: Container component that adds borders and background to other components
@@ -38,6 +39,11 @@
  *    Timer* gameTimer = new Timer();
  *    gameTimer->setPosition(10, 10);
  *    gameTimer->start();
+ *
+ * Components describe their shapes with appendGeometry() into a UIBatch
+ * (ui_batch.h); render() draws just that component. Any change that alters
+ * the look marks the component dirty, so a screen can keep its batch until
+ * one of its components changes.
  */
 
 #pragma once
@@ -48,6 +54,8 @@
 #include <functional>
 #include <fstream>
 #include <map>
+#include <cstdint>
+#include "logger.h"
 
  // Forward declarations - don't include the full headers
 class Config;
@@ -55,6 +63,7 @@ class Button;
 class TextBox;
 class Timer;
 class UIComponent;
+class UIBatch;
 class ScreenManager;
 class Navigator;
 class MainScreenManager;
@@ -68,53 +77,6 @@ enum class TextAlignment {
     MidRight  // Align text to the right while vertically centered
 };
 
-// Logger class for centralized logging
-class Logger {
-public:
-    enum LogLevel {
-        INFO,
-        WARNING,
-        DEBUG,
-        ERROR_
-    };
-
-private:
-    static Logger instance;
-    bool consoleLogging;
-    bool fileLogging;
-    std::string logFilePath;
-    std::ofstream logFile;
-    LogLevel minLevel;
-
-    // Private constructor (singleton)
-    Logger();
-
-public:
-    // Delete copy constructor and assignment operator
-    Logger(const Logger&) = delete;
-    Logger& operator=(const Logger&) = delete;
-
-    // Destructor
-    ~Logger();
-
-    // Get singleton instance
-    static Logger& getInstance();
-
-    // Configuration
-    void enableConsoleLogging(bool enable);
-    void enableFileLogging(bool enable, const std::string& filePath = "artspace.log");
-    void setMinimumLogLevel(LogLevel level);
-
-    // Logging methods
-    void logInfo(const std::string& message);
-    void logWarning(const std::string& message);
-    void logError(const std::string& message);
-    void logDebug(const std::string& message);
-
-    // Log with custom level
-    void log(LogLevel level, const std::string& message);
-};
-
 // Forward text-related function declarations
 void calculateTextPosition(float boxX, float boxY, float boxWidth, float boxHeight,
     const std::string& text, TextAlignment alignment,
@@ -123,6 +85,15 @@ void renderText(float x, float y, const std::string& text, float* color = nullpt
 void renderText(float boxX, float boxY, float boxWidth, float boxHeight,
     const std::string& text, TextAlignment alignment, float* color = nullptr);
 
+// Switch to a pixel-space orthographic projection (origin bottom-left, y up) for
+// drawing UI over the 3D scene; endScreenSpace restores the previous state
+void beginScreenSpace(int width, int height);
+void endScreenSpace();
+
+// Alpha blending for UI drawing. Where the driver allows it, the target's alpha
+// accumulates coverage, so UI drawn into a cleared layer comes out premultiplied.
+void setUIBlendFunc();
+
 // Base UI component class
 class UIComponent {
 protected:
@@ -130,16 +101,29 @@ protected:
     float size[2];      // width, height
     bool isVisible;
     float alpha;
+    bool dirty;         // Looks different since the last clearDirty()
+
+    // Bumped whenever any component moves, resizes, appears or disappears
+    static uint32_t layoutVersion;
 
 public:
     UIComponent();
     virtual ~UIComponent() = default;
 
-    virtual void render() = 0;
+    // Draw this component on its own (through appendGeometry by default)
+    virtual void render();
+    // Add this component's shapes to a batch. The default draws through render()
+    // as a callback, for components that draw themselves: override one of the two.
+    virtual void appendGeometry(UIBatch& batch);
     virtual void update(float deltaTime) {}
 
-    void setPosition(float x, float y);
-    void setSize(float width, float height);
+    void markDirty() { dirty = true; }
+    virtual bool isDirty() const { return dirty; }
+    virtual void clearDirty() { dirty = false; }
+
+    // Virtual so containers (BorderBox) can move their content when a layout places them
+    virtual void setPosition(float x, float y);
+    virtual void setSize(float width, float height);
     void setVisible(bool visible);
     void setAlpha(float a);
 
@@ -148,9 +132,15 @@ public:
     const float* getSize() const { return size; }
     bool getVisible() const { return isVisible; }
 
-    // Virtual event handlers
+    static uint32_t getLayoutVersion() { return layoutVersion; }
+
+    // Virtual event handlers. Mouse coordinates are window pixels with the origin
+    // at the bottom left (y up), converted from GLUT's once per event by ScreenManager.
     virtual bool handleKeyEvent(unsigned char key) { return false; }
-    virtual bool handleMouseMove(int x, int y) { return false; }
+    virtual bool handleMouseEvent(int button, int state, float x, float y) { return false; }
+    virtual bool handleMouseMove(float x, float y) { return false; }
+    // The pointer moved off this component
+    virtual void handleMouseLeave() {}
 };
 
 // Image component
@@ -163,14 +153,32 @@ private:
     bool imageLoaded;
     float fallbackColor[4];  // RGBA fallback color
     bool useFallback;
+    bool mipmapped;
+    unsigned int appliedQualityVersion;
+
+    // Texture quality shared by every image; applied lazily when a texture is next drawn
+    static int maxTextureSize;
+    static float mipBias;
+    static unsigned int qualityVersion;
+
+    // Bind the texture, bringing its level and bias parameters up to date first
+    void bindTexture();
+    // Rectangle the texture covers, letterboxed when preserving the aspect ratio
+    void getDrawRect(float& x, float& y, float& width, float& height) const;
+
+    friend class UIBatch;
 
 public:
     Image(const std::string& imagePath, const std::string& fallbackColorHex = "#ffffff");
     ~Image() override;
 
+    // Immediate draw in the current transform (also used for artworks in 3D)
     void render() override;
+    void appendGeometry(UIBatch& batch) override;
 
     bool loadImage(const std::string& imagePath);
+    // Upload an already decoded image (e.g. decoded on a loader thread); needs the GL context
+    bool setImageData(const sf::Image& image);
     void setTint(float r, float g, float b, float a = 1.0f);
     void setPreserveAspectRatio(bool preserve);
     void setFallbackColor(float r, float g, float b, float a = 1.0f);
@@ -180,6 +188,10 @@ public:
     int getWidth() const { return sfImage.getSize().x; }
     int getHeight() const { return sfImage.getSize().y; }
 
+    // Largest mip level sampled (0 = full resolution) and LOD bias for all images.
+    // Needs driver mipmaps (glext.textureLevels); otherwise textures keep full detail.
+    static void setTextureQuality(int maxSize, float lodBias);
+
     // Utility functions
     static void hexToRGB(const std::string& hexColor, float& r, float& g, float& b);
 };
@@ -199,8 +211,10 @@ public:
     BorderBox(UIComponent* component, float border = 2.0f, float pad = 5.0f);
     ~BorderBox() override;
 
-    void render() override;
+    void appendGeometry(UIBatch& batch) override;
     void update(float deltaTime) override;
+    bool isDirty() const override;
+    void clearDirty() override;
 
     void setContent(UIComponent* component);
     UIComponent* getContent() const { return content; }
@@ -210,13 +224,14 @@ public:
     void setBackgroundColor(float r, float g, float b, float a = 1.0f);
 
     // Override position and size setters to update the content position
-    void setPosition(float x, float y);
-    void setSize(float width, float height);
+    void setPosition(float x, float y) override;
+    void setSize(float width, float height) override;
 
     // Event forwarding methods
-    bool handleMouseEvent(int button, int state, int x, int y);
-    bool handleKeyEvent(unsigned char key);
-    bool handleMouseMove(int x, int y);
+    bool handleMouseEvent(int button, int state, float x, float y) override;
+    bool handleKeyEvent(unsigned char key) override;
+    bool handleMouseMove(float x, float y) override;
+    void handleMouseLeave() override;
 };
 
 // Button component
@@ -234,7 +249,7 @@ public:
     Button(const std::string& buttonText);
     ~Button() override = default;
 
-    void render() override;
+    void appendGeometry(UIBatch& batch) override;
     void update(float deltaTime) override;
 
     void setText(const std::string& buttonText);
@@ -243,8 +258,9 @@ public:
     void setBackgroundColor(float r, float g, float b, float a = 1.0f);
     void setHoverColor(float r, float g, float b, float a = 1.0f);
 
-    bool handleMouseEvent(int button, int state, int x, int y);
-    bool handleMouseMove(int x, int y);
+    bool handleMouseEvent(int button, int state, float x, float y) override;
+    bool handleMouseMove(float x, float y) override;
+    void handleMouseLeave() override;
 };
 
 // TextBox component
@@ -260,12 +276,14 @@ private:
     int cursorPosition;
     float cursorBlinkTime;
     bool showCursor;
+    std::function<void(const std::string&)> onSubmit;
+    std::function<void(const std::string&)> onChange;
 
 public:
     TextBox(const std::string& initialText = "", const std::string& placeholderText = "");
     ~TextBox() override = default;
 
-    void render() override;
+    void appendGeometry(UIBatch& batch) override;
     void update(float deltaTime) override;
 
     void setText(const std::string& newText);
@@ -276,8 +294,15 @@ public:
     void setBackgroundColor(float r, float g, float b, float a = 1.0f);
     void setBorderColor(float r, float g, float b, float a = 1.0f);
 
-    bool handleKeyEvent(unsigned char key);
-    bool handleMouseEvent(int button, int state, int x, int y);
+    // Called with the text when Enter is pressed / whenever the text is edited
+    void setOnSubmit(const std::function<void(const std::string&)>& callback);
+    void setOnChange(const std::function<void(const std::string&)>& callback);
+
+    void setFocus(bool focus);
+    bool isFocused() const { return hasFocus; }
+
+    bool handleKeyEvent(unsigned char key) override;
+    bool handleMouseEvent(int button, int state, float x, float y) override;
 };
 
 // Timer display component
@@ -286,6 +311,7 @@ private:
     std::string timeText;
     float currentTime;
     bool isRunning;
+    int displayedHundredths;  // Value timeText shows
     float textColor[4];  // RGBA
 
     // Add private helper method to update time text
@@ -299,7 +325,7 @@ public:
     void stop();
     void reset();
     void update(float deltaTime) override;
-    void render() override;
+    void appendGeometry(UIBatch& batch) override;
     float getTime() const;
     void setTextColor(float r, float g, float b, float a = 1.0f);
 };
\ No newline at end of file